@@ -0,0 +1,75 @@
+/** @file Arena.cpp
+ * @author Korosh Moosavi
+ * @date 2026-10-16
+ *
+ * Arena class:
+ * Region allocator handing out memory from large blocks.
+ * Objects are never freed one at a time. Everything is released together
+ *   when the arena is destroyed.
+ *
+ * Assumptions:
+ * An arena is only used by one thread at a time.
+ * Objects created in an arena are not deleted, and are not used after the
+ *   arena is destroyed.
+ */
+#include "Arena.h"
+#include <cstdlib>
+
+/** ------------------------------ Constructor ----------------------
+ * Creates an empty arena, no memory is reserved until first used.
+ * @param size Bytes per block, larger allocations get their own block
+ */
+Arena::Arena(size_t size)
+   : blocks(nullptr), cursor(nullptr), limit(nullptr), blockSize(size),
+     cleanups(nullptr), used(0), reserved(0), objects(0)
+{
+}
+
+/** ----------------------------- grow(size_t, size_t) ---------------------
+ * Starts a new block large enough for an allocation that did not fit.
+ * @param bytes Size of the allocation
+ * @param align Alignment of the allocation
+ * @return Memory for the allocation
+ */
+void* Arena::grow(size_t bytes, size_t align)
+{
+   size_t header = (sizeof(Block) + align - 1) & ~(align - 1);
+   size_t size = header + bytes > blockSize ? header + bytes : blockSize;
+   Block* block = static_cast<Block*>(malloc(size));
+
+   if (block == nullptr)
+      throw bad_alloc();
+
+   block->next = blocks;
+   block->size = size;
+   blocks = block;
+   reserved += size;
+
+   char* start = reinterpret_cast<char*>(block) + header;
+   cursor = start + bytes;
+   limit = reinterpret_cast<char*>(block) + size;
+   used += bytes;
+   return start;
+}
+
+/** ----------------------------- release() ---------------------
+ * Destroys every object created in the arena, newest first, then frees
+ *   every block. The arena can be used again afterwards.
+ */
+void Arena::release()
+{
+   for (Cleanup* cleanup = cleanups; cleanup != nullptr; cleanup = cleanup->next)
+      cleanup->destroy(cleanup->object);
+   cleanups = nullptr;
+
+   while (blocks != nullptr) {
+      Block* next = blocks->next;
+      free(blocks);
+      blocks = next;
+   }
+   cursor = nullptr;
+   limit = nullptr;
+   used = 0;
+   reserved = 0;
+   objects = 0;
+}
@@ -0,0 +1,144 @@
+/** @file Arena.h
+ * @author Korosh Moosavi
+ * @date 2026-10-16
+ *
+ * Arena class:
+ * Region allocator handing out memory from large blocks.
+ * Objects allocated one after another sit next to each other in memory, so
+ *   structures built in order (tree nodes, parsed items) are walked with
+ *   fewer cache misses, and each allocation is a pointer bump instead of a
+ *   call to the general purpose allocator.
+ * Objects are never freed one at a time. Everything is released together
+ *   when the arena is destroyed: destructors of objects that need one are
+ *   run, then every block is freed.
+ * Tracks bytes handed out and bytes reserved, to report memory use of the
+ *   structure owning the arena.
+ *
+ * Assumptions:
+ * An arena is only used by one thread at a time.
+ * Objects created in an arena are not deleted, and are not used after the
+ *   arena is destroyed.
+ */
+#pragma once
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+using namespace std;
+
+class Arena {
+private:
+   static const size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+   /** ------------------------ Block struct --------------------------
+    * Header at the start of every block, memory is handed out after it
+    */
+   struct Block {
+      Block* next;
+      size_t size;
+   };
+
+   /** ------------------------ Cleanup struct --------------------------
+    * Destructor to run for an object at release, allocated in the arena
+    *   itself so no bookkeeping is allocated elsewhere
+    */
+   struct Cleanup {
+      void (*destroy)(void* object);
+      void* object;
+      Cleanup* next;
+   };
+
+   Block* blocks;          // Newest block first
+   char* cursor;           // Next free byte of the newest block
+   char* limit;            // End of the newest block
+   size_t blockSize;
+   Cleanup* cleanups;      // Newest object first
+   size_t used;            // Bytes handed out, including alignment padding
+   size_t reserved;        // Bytes of every block
+   size_t objects;         // Objects created with create()
+
+   /** ----------------------------- grow(size_t, size_t) ---------------------
+    * Starts a new block large enough for an allocation that did not fit.
+    * @param bytes Size of the allocation
+    * @param align Alignment of the allocation
+    * @return Memory for the allocation
+    */
+   void* grow(size_t bytes, size_t align);
+
+   /** ----------------------------- destroy(void*) ---------------------
+    * Runs the destructor of an object of type T.
+    */
+   template <class T>
+   static void destroy(void* object) { static_cast<T*>(object)->~T(); };
+
+public:
+   /** ------------------------------ Constructor ----------------------
+    * Creates an empty arena, no memory is reserved until first used.
+    * @param size Bytes per block, larger allocations get their own block
+    */
+   Arena(size_t size = DEFAULT_BLOCK_SIZE);
+
+   /** ------------------------------ Destructor -------------------------------
+    * Releases every object and block, see release().
+    */
+   ~Arena() { release(); };
+
+   Arena(const Arena&) = delete;
+   Arena& operator=(const Arena&) = delete;
+
+   /** ----------------------------- allocate(size_t, size_t) -----------------
+    * Hands out uninitialized memory, freed only on release().
+    * @param bytes Size of the allocation
+    * @param align Alignment of the allocation, a power of 2 no larger than
+    *                alignof(max_align_t)
+    * @return Memory for the allocation
+    */
+   void* allocate(size_t bytes, size_t align = alignof(max_align_t))
+   {
+      char* start = (char*)(((size_t)cursor + align - 1) & ~(align - 1));
+
+      if (cursor == nullptr || bytes > (size_t)(limit - start))
+         return grow(bytes, align);
+
+      used += start + bytes - cursor;
+      cursor = start + bytes;
+      return start;
+   };
+
+   /** ----------------------------- create(Args...) ---------------------
+    * Constructs a T in the arena. Its destructor, if it has one that does
+    *   anything, is run on release().
+    * @param args Constructor arguments
+    * @return The new object, owned by the arena
+    */
+   template <class T, class... Args>
+   T* create(Args&&... args)
+   {
+      T* object = new (allocate(sizeof(T), alignof(T))) T(forward<Args>(args)...);
+
+      if (!is_trivially_destructible<T>::value) {
+         Cleanup* cleanup = static_cast<Cleanup*>(allocate(sizeof(Cleanup), alignof(Cleanup)));
+         cleanup->destroy = &destroy<T>;
+         cleanup->object = object;
+         cleanup->next = cleanups;
+         cleanups = cleanup;
+      }
+      objects++;
+      return object;
+   };
+
+   /** ----------------------------- release() ---------------------
+    * Destroys every object created in the arena, newest first, then frees
+    *   every block. The arena can be used again afterwards.
+    */
+   void release();
+
+   /** ----------------------------- Statistics ---------------------
+    * Bytes handed out (including alignment and destructor bookkeeping),
+    *   bytes reserved in blocks, and objects created.
+    */
+   size_t bytesUsed() const { return used; };
+   size_t bytesReserved() const { return reserved; };
+   size_t objectCount() const { return objects; };
+};
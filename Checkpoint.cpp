@@ -0,0 +1,49 @@
+/** @file Checkpoint.cpp
+ * @author Korosh Moosavi
+ * @date 2026-10-16
+ *
+ * Checkpoint class:
+ * Class encompassing the store function to write a Snapshot of the whole
+ *   store to a file while transactions are processed.
+ *
+ * Assumptions:
+ * Objects used in this method are valid and initialized.
+ */
+#include "Checkpoint.h"
+
+/** ---------------- process(Inventory&, CustomerRegistry&, Command&, ostream&) ---
+ * Saves the inventory and registry to the file named by the command.
+ * @param inventory  Inventory storing data on the store's current items.
+ * @param registry   CustomerRegistry object containing customer data.
+ * @param command    Parsed transaction line, args hold the file name.
+ * @param output     Not used, saving outputs nothing on success.
+ * @pre    No other transaction is being processed.
+ * @return Returns true if the snapshot was written, false if not.
+ */
+bool Checkpoint::process(Inventory& inventory, CustomerRegistry& registry, const Command& command,
+                         ostream& output)
+{
+   if (command.args.empty()) {
+      cerr << "Invalid snapshot file entered.\n\n";
+      return false;
+   }
+   return write(inventory, registry, string(command.args));
+}
+
+/** ----------------- write(Inventory&, CustomerRegistry&, string) ---------
+ * Saves a whole store to a snapshot file.
+ * @param inventory  Inventory to save first.
+ * @param registry   CustomerRegistry to save after it.
+ * @param fileName   File to create or replace.
+ * @pre    No transaction is being processed.
+ * @return Returns true if the snapshot was written, false if not.
+ */
+bool Checkpoint::write(const Inventory& inventory, const CustomerRegistry& registry,
+                       const string& fileName)
+{
+   Snapshot snapshot;
+
+   inventory.save(snapshot);
+   registry.save(snapshot);
+   return snapshot.saveTo(fileName);
+}
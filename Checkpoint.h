@@ -0,0 +1,54 @@
+/** @file Checkpoint.h
+ * @author Korosh Moosavi
+ * @date 2026-10-16
+ *
+ * Checkpoint class:
+ * Class encompassing the store function to write a Snapshot of the whole
+ *   store, inventory and customers, to a file while transactions are
+ *   processed, such as "W, store.snap". The store can later be started from
+ *   the snapshot instead of its text files.
+ *
+ * Assumptions:
+ * Objects used in this method are valid and initialized.
+ */
+#include "Transaction.h"
+
+class Checkpoint : public Transaction {
+public:
+   /** ------------------------------ Default constructor ----------------------
+    * No special operations needed.
+    * @pre  None
+    * @post Checkpoint object created.
+    */
+   Checkpoint() {};
+
+   /** ------------------------------ Destructor -------------------------------
+    * No special operations needed.
+    * @pre  None
+    * @post Data is deallocated after destruction.
+    */
+   virtual ~Checkpoint() {};
+
+   /** ---------------- process(Inventory&, CustomerRegistry&, Command&, ostream&) ---
+    * Saves the inventory and registry to the file named by the command.
+    * @param inventory  Inventory storing data on the store's current items.
+    * @param registry   CustomerRegistry object containing customer data.
+    * @param command    Parsed transaction line, args hold the file name.
+    * @param output     Not used, saving outputs nothing on success.
+    * @pre    No other transaction is being processed.
+    * @return Returns true if the snapshot was written, false if not.
+    */
+   bool process(Inventory& inventory, CustomerRegistry& registry, const Command& command,
+                ostream& output);
+
+   /** ----------------- write(Inventory&, CustomerRegistry&, string) ---------
+    * Saves a whole store to a snapshot file.
+    * @param inventory  Inventory to save first.
+    * @param registry   CustomerRegistry to save after it.
+    * @param fileName   File to create or replace.
+    * @pre    No transaction is being processed.
+    * @return Returns true if the snapshot was written, false if not.
+    */
+   static bool write(const Inventory& inventory, const CustomerRegistry& registry,
+                     const string& fileName);
+};
@@ -1,107 +1,237 @@
-/** @file Collectible.h
- * @author Korosh Moosavi
- * @date 2021-03-12
- *
- * Collectible class:
- * Abstract class
- * Serves as parent to Coin, ComicBook, and SportsCard classes.
- * Ensures there is a base class pointer for all inventory objects.
- * 
- * Assumptions:
- * Subclasses will include 1 char, 2 ints, and 2 strings as data members.
- * Input file is correctly formatted.
- */
-#pragma once
-#include "Hashable.h"
-#include <string>
-
-class Collectible : public Hashable {
-protected:
-   string descriptor = "Collectible";
-   static const char symbol = '@';
-   string name = "NULL_COLLECTIBLE";
-   string type = "NULL_TYPE";
-   string grade = "NULL_GRADE";
-   int stock = -1;
-   int year = 2077;
-
-public:
-   static const int UNIQUES = 29; // Next prime after 26 (letter identifiers)
-
-   /** ------------------------------ Default constructor ----------------------
-    * Data members are pre-initialized.
-    * @pre  None
-    * @post Collectible object created with identifiable default data value.
-    */
-   Collectible() {};
-
-   /** ----------------------------- create() ---------------------------------
-    * Creates a new default-initialized Collectible object.
-    * @pre    None
-    * @post   Collectible object created with identifiable default data value.
-    * @return Pointer to default-initialized Collectible object.
-    */
-   virtual Collectible* create() const = 0;
-
-   /** ----------------------------- create(string) ---------------------------
-    * Data members are pre-initialized, newly created Collectible is returned.
-    * Uses parameter constructor.
-    * @param details  String containing all details needed for a new object.
-    * @pre  Parameter string is pre-formatted and a single line, begins with "@"
-    * @post Collectible object created with parameter data values.
-    * @return  Pointer to newly created Collectible object.
-    */
-   virtual Collectible* create(string details) = 0;
-
-   /** ------------------------------ Destructor -------------------------------
-    * No special operations needed.
-    * @pre  None
-    * @post Data is deallocated after destruction.
-    */
-   virtual ~Collectible() {};
-
-   /** ----------------------------- hash() ---------------------
-    * Uses descriptor to return a hash value.
-    * Hash priority should order subclasses like so:
-    *    Coin -> Comic Book -> Sports Card
-    * @pre    Data members are valid and initialized.
-    * @return A (hopefully) unique int value.
-    */
-   virtual int hash() = 0;
-
-   /** ----------------------------- isLess(Hashable&) ---------------------
-    * Main functionality for less-than operator used in SearchTree
-    * @param  rhs  Other Hashable object being compared to.
-    * @pre    Parameter is a Coin.
-    * @return True if priority of this object is lower than that
-    *           of rhs Hashable, false otherwise.
-    */
-   virtual bool isLess(const Hashable& rhs) const = 0;
-
-   /** ----------------------------- isEqual(Hashable&) ---------------------
-    * Compares two Hashables to see if they are equal.
-    * @param  rhs  Other Hashable object being compared to.
-    * @pre    Parameter is a Collectible.
-    * @return True if this and rhs have equal data members (except for stock).
-    */
-   virtual bool isEqual(const Hashable& rhs) const = 0;;
-
-   /** ----------------------------- updateStock(int) ---------------------
-    * Changes the stock count of this object by the parameter amount.
-    * Note that the current implementation only uses +1 and -1 as parameters.
-    * @param  change Amount to change stock count by.
-    * @pre    Stock is >= 0
-    * @post   Stock is >= 0
-    * @return True stock was changed without going below 0.
-    */
-   virtual bool updateStock(int change) = 0;
-
-   /** ----------------------------- print(ostream&) ---------------------
-    * Main functionality of output operator<<
-    * Outputs data on this object in a single, formatted line
-    * @param  output Ostream object passed from operator<< overload in Hashable
-    * @pre    Data members are valid and initialized.
-    * @post   Information on this object is output.
-    */
-   virtual void print(ostream& output) const = 0;
+/** @file Collectible.h
+ * @author Korosh Moosavi
+ * @date 2021-03-12
+ *
+ * Collectible class:
+ * Abstract class
+ * Serves as parent to Coin, ComicBook, and SportsCard classes.
+ * Ensures there is a base class pointer for all inventory objects.
+ * 
+ * Data members are shared by all subclasses, which only differ in their
+ *   descriptor, symbol, and default values.
+ * Name, type and grade are kept as IDs in the shared InternPool, so equal
+ *   values are compared as ints and stored once for the whole catalog.
+ * The grade is also kept as its code on the grading scale of the category,
+ *   see Grade, which is what items are sorted by.
+ *
+ * Assumptions:
+ * Subclasses will include 1 char, 2 ints, and 2 strings as data members.
+ * Input file is correctly formatted.
+ */
+#pragma once
+#include "Hashable.h"
+#include "CommandParser.h"
+#include "InternPool.h"
+#include "Grade.h"
+#include <atomic>
+#include <string>
+#include <cstdint>
+
+/** ------------------------ StoredItem struct --------------------------
+ * Fields of a Collectible as saved in a Snapshot, with strings as IDs in
+ *   the shared InternPool so every item takes the same number of bytes
+ */
+struct StoredItem {
+   char symbol;
+   uint8_t gradeCode;
+   int32_t stock;
+   int32_t year;
+   uint32_t nameId;
+   uint32_t typeId;
+   uint32_t gradeId;
+};
+
+class Collectible : public Hashable {
+protected:
+   string descriptor = "Collectible";
+   static const char symbol = '@';
+   uint32_t nameId = InternPool::EMPTY_STRING;   // Set by every subclass
+   uint32_t typeId = InternPool::EMPTY_STRING;   //   constructor
+   uint32_t gradeId = InternPool::EMPTY_STRING;
+   uint8_t gradeCode = Grade::UNGRADED;          // Place of grade on its scale
+   atomic<int> stock{-1};  // Changed by transaction workers at the same time
+   atomic<bool> dirty{true};  // Stock changed since the line was last rendered
+   int year = 2077;
+   uint32_t itemId = 0;    // Dense ID assigned when stocked by Inventory
+
+   /** ----------------------------- intern(string_view) ---------------------
+    * @param value Text of a name, type or grade
+    * @return ID of value in the shared InternPool
+    */
+   static uint32_t intern(string_view value) { return InternPool::shared().intern(value); };
+
+   /** ----------------------------- assign(ItemRecord&) ---------------------
+    * Copies the parsed fields of an item into the data members, interning
+    *   the strings.
+    * @param record Parsed item fields, symbol is only used to code the grade.
+    * @pre    record was parsed for this subclass
+    * @post   Data members hold the values of record
+    */
+   void assign(const ItemRecord& record)
+   {
+      stock = record.stock;
+      year = record.year;
+      gradeId = intern(record.grade);
+      gradeCode = Grade::code(record.symbol, record.grade);
+      nameId = intern(record.name);
+      typeId = intern(record.type);
+   };
+
+   /** ----------------------------- assign(StoredItem&) ---------------------
+    * Copies the saved fields of an item into the data members, no string
+    *   is looked up or interned.
+    * @param stored Fields saved by getStored(), with IDs of the shared pool
+    * @pre    stored was saved from this subclass
+    * @post   Data members hold the values of stored
+    */
+   void assign(const StoredItem& stored)
+   {
+      stock = stored.stock;
+      year = stored.year;
+      gradeId = stored.gradeId;
+      gradeCode = stored.gradeCode;
+      nameId = stored.nameId;
+      typeId = stored.typeId;
+   };
+
+public:
+   static const int UNIQUES = 29; // Next prime after 26 (letter identifiers)
+   static const int SORT_TEXT_FIELDS = 2;   // Most text fields before year
+
+   /** ------------------------------ Default constructor ----------------------
+    * Data members are pre-initialized.
+    * @pre  None
+    * @post Collectible object created with identifiable default data value.
+    */
+   Collectible() {};
+
+   /** ----------------------------- create() ---------------------------------
+    * Creates a new default-initialized Collectible object.
+    * @pre    None
+    * @post   Collectible object created with identifiable default data value.
+    * @return Pointer to default-initialized Collectible object.
+    */
+   virtual Collectible* create() const = 0;
+
+   /** ----------------------------- create(string) ---------------------------
+    * Data members are pre-initialized, newly created Collectible is returned.
+    * Uses parameter constructor.
+    * @param details  String containing all details needed for a new object.
+    * @pre  Parameter string is pre-formatted and a single line, begins with "@"
+    * @post Collectible object created with parameter data values.
+    * @return  Pointer to newly created Collectible object.
+    */
+   virtual Collectible* create(string details) = 0;
+
+   /** ------------------------------ Destructor -------------------------------
+    * No special operations needed.
+    * @pre  None
+    * @post Data is deallocated after destruction.
+    */
+   virtual ~Collectible() {};
+
+   /** ----------------------------- hash() ---------------------
+    * Uses descriptor to return a hash value.
+    * Hash priority should order subclasses like so:
+    *    Coin -> Comic Book -> Sports Card
+    * @pre    Data members are valid and initialized.
+    * @return A (hopefully) unique int value.
+    */
+   virtual int hash() = 0;
+
+   /** ----------------------------- getSymbol() ---------------------
+    * @return Char identifying the subclass of this object.
+    */
+   virtual char getSymbol() const = 0;
+
+   /** ----------------------------- getSortText(string_view[]) -------------
+    * Lists the text fields this object is sorted by before its year, in
+    *   sorting priority, such as the type of a Coin.
+    * Items with equal text fields are sorted by year next, so ranges of
+    *   these fields and then of years are contiguous in the SearchTree.
+    * @param  fields Set to the fields, holds SORT_TEXT_FIELDS values
+    * @return Number of fields set, the same for every item of a subclass
+    */
+   virtual int getSortText(string_view fields[]) const = 0;
+
+   /** ------------------------------ Accessors -----------------------------
+    * Read-only access to the identifying data members, used to build lookup
+    *   keys for this object outside of its own class.
+    */
+   const string& getName() const { return InternPool::shared().get(nameId); };
+   const string& getType() const { return InternPool::shared().get(typeId); };
+   const string& getGrade() const { return InternPool::shared().get(gradeId); };
+   uint8_t getGradeCode() const { return gradeCode; };
+   int getYear() const { return year; };
+   int getStock() const { return stock.load(memory_order_relaxed); };
+
+   /** ----------------------------- takeDirty() ---------------------
+    * Clears the flag updateStock() sets, such as when the item's displayed
+    *   line is rendered again.
+    * @return True if the stock changed since the last call, or if this is
+    *           the first call.
+    */
+   bool takeDirty() { return dirty.exchange(false, memory_order_relaxed); };
+
+   /** ----------------------------- getStored() ---------------------
+    * @return Every field of this item, as saved in a Snapshot.
+    */
+   StoredItem getStored() const
+   { return { getSymbol(), gradeCode, getStock(), year, nameId, typeId, gradeId }; };
+
+   /** ----------------------------- Item ID ---------------------
+    * Dense ID of this item within Inventory, 0 to item count - 1.
+    * Lets other structures, such as TransactionLog, refer to a stocked item
+    *   with a small integer.
+    */
+   uint32_t getItemId() const { return itemId; };
+   void setItemId(uint32_t id) { itemId = id; };
+
+   /** ----------------------------- isLess(Hashable&) ---------------------
+    * Main functionality for less-than operator used in SearchTree
+    * @param  rhs  Other Hashable object being compared to.
+    * @pre    Parameter is a Coin.
+    * @return True if priority of this object is lower than that
+    *           of rhs Hashable, false otherwise.
+    */
+   virtual bool isLess(const Hashable& rhs) const = 0;
+
+   /** ----------------------------- isEqual(Hashable&) ---------------------
+    * Compares two Hashables to see if they are equal.
+    * @param  rhs  Other Hashable object being compared to.
+    * @pre    Parameter is a Collectible.
+    * @return True if this and rhs have equal data members (except for stock).
+    */
+   virtual bool isEqual(const Hashable& rhs) const = 0;;
+
+   /** ----------------------------- updateStock(int) ---------------------
+    * Changes the stock count of this object by the parameter amount.
+    * Note that the current implementation only uses +1 and -1 as parameters.
+    * Safe to call from several threads at once.
+    * @param  change Amount to change stock count by.
+    * @pre    Stock is >= 0
+    * @post   Stock is >= 0, the item is marked dirty if it was changed,
+    *           see takeDirty().
+    * @return True stock was changed without going below 0.
+    */
+   virtual bool updateStock(int change) = 0;
+
+   /** ----------------------------- print(ostream&) ---------------------
+    * Main functionality of output operator<<
+    * Outputs data on this object in a single, formatted line
+    * @param  output Ostream object passed from operator<< overload in Hashable
+    * @pre    Data members are valid and initialized.
+    * @post   Information on this object is output.
+    */
+   void print(ostream& output) const { printWithCount(output, stock); };
+
+   /** ----------------------------- printWithCount(ostream&, int) ----------
+    * Outputs data on this object in a single, formatted line, showing count
+    *   in place of the stock count, such as the quantity of a trade.
+    * @param  output Stream to write to
+    * @param  count  Value shown in the stock column
+    * @pre    Data members are valid and initialized.
+    * @post   Information on this object is output.
+    */
+   virtual void printWithCount(ostream& output, int count) const = 0;
 };
\ No newline at end of file
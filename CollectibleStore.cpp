@@ -1,106 +1,751 @@
-/** @file CollectibleStore.cpp
- * @author Korosh Moosavi
- * @date 2021-03-12
- *
- * CollectibleStore class:
- * This class is the main driver of the program.
- * There is an initial constructed state after creation then all operations
- *   carry out automatically once beginProcessing() is called.
- *   This decision was made arbitrarily for ease of use, feel free to change it
- * There is room for future development and implementations.
- *
- * Assumptions:
- * All relevant input files are in the same directory as this.
- * Input file names are given in the order: Inventory, Customer, Transactions
- */
-#include "CollectibleStore.h"
-
-/** ------------------------------ Constructor ----------------------
-* Assigns file names to private members so that this object is ready to
-*   begin processing on command.
-* @param invFileName  File containing data on the store's inventory.
-* @param custFileName File containing data on the store's customers.
-* @param txFileName   File containing data on the store's transactions.
-* @pre  Files are correctly formatted and names are input via calling method.
-* @post On completion of construction, this object will be ready to process
-*         all the data included in the files.
-*/
-CollectibleStore::CollectibleStore(string invFileName, string custFileName, string txFileName)
-{
-   for (int i = 0; i < sizeof(actions) / sizeof(*actions); i++)
-         actions[i] = nullptr;
-
-   inventoryFile = invFileName;
-   customerFile = custFileName;
-   transactionFile = txFileName;
-}
-
-/** ----------------------------- Destructor ---------------------
-* All dummy objects in actions[] are deleted and no more memory is tied
-*   to this object.
-* All other memory deallocation is taken care of by other classes.
-* @pre   None
-* @post  Memory tied to this CollectibleStore object is freed.
-*/
-CollectibleStore::~CollectibleStore()
-{
-   for (int i = 0; i < sizeof(actions) / sizeof(*actions); i++) {
-      if (actions[i] != nullptr) {
-         delete actions[i];
-         actions[i] = nullptr;
-      }
-   }
-}
-
-/** ----------------------------- beginProcessing() ---------------------
-* Manually create dummy Transaction subclass objects for quick access to
-*   their process().
-* Place them at the appropriate indeces within the hash table actions[]
-* Same structure as Factory class, but not used to create new objects.
-* Then call processTransactions()
-*   Optionally, in future implementations this method can be decoupled for
-*     further modification/customization of operations.
-*   These methods were coupled for this implementation for ease of use due
-*     to the fairly simple scope of the implementation.
-* @pre  Inventory and CustomerRegistry are able to properly initialize and
-*         read input files.
-*       All currently supported Transaction subclasses are updated into the
-*         implementation for this method.
-* @post CollectibleStore can safely be destroyed as all operations are
-*         complete at the end of this method in this implementation.
-*/
-void CollectibleStore::beginProcessing()
-{
-   Inventory inv(inventoryFile);          // Build inventory
-   CustomerRegistry cust(customerFile);   // Build customer registry
-
-   actions[hash('B')] = new Buy;          // Build hash table of functions
-   actions[hash('S')] = new Sell;
-   actions[hash('D')] = new Display;
-   actions[hash('C')] = new TCustomer;
-   actions[hash('H')] = new History;
-
-   processTransactions(inv, cust);        // Process transactions
-}
-
-/** ----------------------------- processTransactions() ---------------------
-* Reads transactions input file and processes it line-by-line.
-* Uses actions[] to call correct operations based on input file commands.
-* @pre  Transactions input file is accessible and correctly formatted.
-* @post All operations are carried out and outputs are output to console.
-*/
-void CollectibleStore::processTransactions(Inventory& inv, CustomerRegistry& cust)
-{
-   ifstream input(transactionFile);
-   
-   while (input.peek() != EOF) {
-      string fileInput;
-      getline(input, fileInput);
-      
-      if (actions[hash(fileInput[0])] == nullptr) {   
-         cout << "Unrecognized Transaction entered.\n" << endl;
-         continue;   // nullptr = transaction not found in actions[], skip
-      }
-      actions[hash(fileInput[0])]->process(inv, cust, fileInput);
-   }
-}
\ No newline at end of file
+/** @file CollectibleStore.cpp
+ * @author Korosh Moosavi
+ * @date 2021-03-12
+ *
+ * CollectibleStore class:
+ * This class is the main driver of the program.
+ * There is an initial constructed state after creation then all operations
+ *   carry out automatically once beginProcessing() is called.
+ *   This decision was made arbitrarily for ease of use, feel free to change it
+ * There is room for future development and implementations.
+ *
+ * Assumptions:
+ * All relevant input files are in the same directory as this.
+ * Input file names are given in the order: Inventory, Customer, Transactions
+ */
+#include "CollectibleStore.h"
+#include <deque>
+#include <unordered_set>
+
+/** ------------------------------ Constructor ----------------------
+* Assigns file names to private members so that this object is ready to
+*   begin processing on command.
+* @param invFileName  File containing data on the store's inventory.
+* @param custFileName File containing data on the store's customers.
+* @param txFileName   File containing data on the store's transactions.
+* @pre  Files are correctly formatted and names are input via calling method.
+* @post On completion of construction, this object will be ready to process
+*         all the data included in the files.
+*/
+CollectibleStore::CollectibleStore(string invFileName, string custFileName, string txFileName)
+{
+   for (int i = 0; i < sizeof(actions) / sizeof(*actions); i++)
+         actions[i] = nullptr;
+
+   inventoryFile = invFileName;
+   customerFile = custFileName;
+   transactionFile = txFileName;
+   reportStats = false;
+   loadThreads = 1;
+   pipelined = false;
+   workers = 1;
+   journalDelay = 0;
+   inventory = nullptr;
+   registry = nullptr;
+}
+
+/** ----------------------------- Destructor ---------------------
+* All dummy objects in actions[] and the loaded Inventory and
+*   CustomerRegistry are deleted and no more memory is tied to this object.
+* All other memory deallocation is taken care of by other classes.
+* @pre   None
+* @post  Memory tied to this CollectibleStore object is freed.
+*/
+CollectibleStore::~CollectibleStore()
+{
+   for (int i = 0; i < sizeof(actions) / sizeof(*actions); i++) {
+      if (actions[i] != nullptr) {
+         delete actions[i];
+         actions[i] = nullptr;
+      }
+   }
+   delete registry;           // Customer logs refer to inventory items
+   delete inventory;
+   registry = nullptr;
+   inventory = nullptr;
+}
+
+/** ----------------------------- loadFiles() ---------------------
+* Manually create dummy Transaction subclass objects for quick access to
+*   their process().
+* Place them at the appropriate indeces within the hash table actions[]
+* Same structure as Factory class, but not used to create new objects.
+* Then builds the Inventory and CustomerRegistry from the snapshot file if
+*   one is set, or else from their input files, replacing any loaded before.
+*   Input files are built concurrently on a ThreadPool when more than one
+*   load thread is set, see setLoadThreads(int). The journal file is
+*   replayed on top if one is set.
+* @pre  All currently supported Transaction subclasses are updated into the
+*         implementation for this method.
+* @post Store is ready for runTransactions() and outputReports().
+*       Load statistics are reported to clog if reportStats is set.
+*/
+void CollectibleStore::loadFiles()
+{
+   if (actions[hash('B')] == nullptr) {
+      actions[hash('B')] = new Buy;       // Build hash table of functions
+      actions[hash('S')] = new Sell;
+      actions[hash('D')] = new Display;
+      actions[hash('C')] = new TCustomer;
+      actions[hash('H')] = new History;
+      actions[hash('G')] = new GradeQuery;
+      actions[hash('Q')] = new RangeQuery;
+      actions[hash('L')] = new Lookup;
+      actions[hash('N')] = new NameQuery;
+      actions[hash('R')] = new Register;
+      actions[hash('W')] = new Checkpoint;
+   }
+
+   journal.close();                       // Replace anything loaded before
+   delete registry;
+   delete inventory;
+   registry = nullptr;
+   inventory = nullptr;
+
+   bool restored = !snapshotFile.empty() && loadSnapshot();
+
+   if (restored) {
+      // Loaded from the snapshot, nothing to parse
+   } else if (loadThreads > 1) {          // Build both at the same time
+      ThreadPool pool(loadThreads);
+      thread custLoader([&] { registry = new CustomerRegistry(customerFile, pool); });
+
+      inventory = new Inventory(inventoryFile, pool);
+      custLoader.join();
+
+   } else {
+      inventory = new Inventory(inventoryFile);          // Build inventory
+      registry = new CustomerRegistry(customerFile);     // Build customer registry
+   }
+
+   if (reportStats) {
+      inventory->getLoadStats().print(clog, restored ? snapshotFile + " items" : inventoryFile);
+      registry->getLoadStats().print(clog, restored ? snapshotFile + " customers" : customerFile);
+      inventory->outputIndexStats(clog);
+      inventory->outputMemoryStats(clog);
+      registry->outputIndexStats(clog);
+      registry->outputMemoryStats(clog);
+      InternPool::shared().outputStats(clog);
+   }
+
+   if (!journalFile.empty())
+      replayJournal();
+}
+
+/** ----------------------------- loadSnapshot() ---------------------
+* Builds the Inventory and CustomerRegistry from the snapshot file.
+* @pre  Neither is loaded.
+* @post Both are loaded and true is returned, or neither is and false is
+*         returned if the snapshot could not be read.
+*/
+bool CollectibleStore::loadSnapshot()
+{
+   Snapshot snapshot(snapshotFile);
+
+   inventory = new Inventory(snapshot);
+   registry = new CustomerRegistry(snapshot, *inventory);
+   if (snapshot.isValid())
+      return true;
+
+   cerr << "Unable to load " << snapshotFile << ", loading the input files instead.\n"
+      << endl;
+   delete registry;
+   delete inventory;
+   registry = nullptr;
+   inventory = nullptr;
+   return false;
+}
+
+/** ----------------------------- replayJournal() ---------------------
+* Applies every change in the journal file to the loaded store, then
+*   opens the journal so new changes are appended to it.
+* Log entries are replayed in journal order, while stock is changed once
+*   per item by the net amount, so trades of several streams that were
+*   journaled in a different order than their stock changes still apply.
+* Which trades apply is decided before any is replayed, so history and
+*   stock always agree: a trade needs a known item and customer, and when
+*   a journal cut short by a crash would leave an item below 0 stock, its
+*   last sells are left out.
+* @pre  The Inventory and CustomerRegistry are loaded from the state the
+*         journal was started on.
+* @post The store holds every change of the journal, and the registry
+*         appends new changes to it. Replay statistics are reported to
+*         clog if reportStats is set.
+*/
+void CollectibleStore::replayJournal()
+{
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   uint64_t fingerprint = inventory->fingerprint();
+   vector<JournalRecord> records;
+   deque<string> names;                   // Registered names, viewed by records
+   uint64_t trades = 0, registrations = 0, rejected = 0, validBytes = 0;
+
+   bool readable = Journal::replay(journalFile, fingerprint, [&](const JournalRecord& record) {
+      records.push_back(record);
+      if (record.type == JournalRecord::REGISTER) {
+         names.emplace_back(record.name);  // Only valid during replay()
+         records.back().name = names.back();
+      }
+   }, validBytes);
+
+   vector<bool> applies(records.size(), false);
+   vector<int> stockChanges;              // Net change by item ID
+   unordered_set<int64_t> registered;     // Customers added by the journal
+
+   for (size_t i = 0; i < records.size(); i++) {
+      const JournalRecord& record = records[i];
+      bool known = record.customerId >= 0 && (registry->isRegistered(record.customerId) ||
+                                              registered.count(record.customerId) > 0);
+      if (record.type == JournalRecord::REGISTER) {
+         applies[i] = record.customerId >= 0 && !known && !record.name.empty();
+         if (applies[i])
+            registered.insert(record.customerId);
+      } else if (known && inventory->getItem(record.itemId) != nullptr) {
+         applies[i] = true;
+         if (record.itemId >= stockChanges.size())
+            stockChanges.resize(record.itemId + 1, 0);
+         stockChanges[record.itemId] += record.isBuy ? 1 : -1;
+      }
+   }
+   for (size_t i = records.size(); i-- > 0; ) {  // Drop last sells below 0
+      const JournalRecord& record = records[i];
+      if (applies[i] && record.type == JournalRecord::TRADE && !record.isBuy &&
+          inventory->getItem(record.itemId)->getStock() + stockChanges[record.itemId] < 0) {
+         applies[i] = false;
+         stockChanges[record.itemId]++;
+      }
+   }
+
+   for (size_t i = 0; i < records.size(); i++) {
+      const JournalRecord& record = records[i];
+      if (!applies[i]) {
+         rejected++;
+      } else if (record.type == JournalRecord::REGISTER) {
+         registry->registerCustomer(record.customerId, record.name);
+         registrations++;
+      } else {
+         registry->updateLog(*inventory->getItem(record.itemId), record.customerId,
+                             record.isBuy, record.sequence);
+         trades++;
+      }
+   }
+   for (uint32_t itemId = 0; itemId < stockChanges.size(); itemId++) {
+      if (stockChanges[itemId] != 0)
+         inventory->updateInventory(itemId, stockChanges[itemId]);
+   }
+   if (rejected > 0)
+      cerr << rejected << " changes in " << journalFile << " do not apply to this store.\n"
+         << endl;
+
+   if (reportStats) {
+      clog << "Journal replay: " << trades << " trades, " << registrations
+         << " registrations, " << validBytes << " bytes in "
+         << chrono::duration<double>(chrono::steady_clock::now() - start).count() << " s"
+         << endl;
+   }
+
+   if (readable && journal.open(journalFile, validBytes, chrono::microseconds(journalDelay),
+                                fingerprint))
+      registry->setJournal(&journal);
+}
+
+/** ----------------------------- runTransactions(ostream&) ---------------
+* Processes the transactions input file against the loaded store, then
+*   waits for the journal to be durable and saves a snapshot if
+*   setSaveSnapshotFile(string) was called.
+* @param output Stream reports are written to, flushed once all
+*                 transactions are processed.
+* @pre  loadFiles() was called.
+* @post All operations are carried out and outputs are written to output.
+*/
+void CollectibleStore::runTransactions(ostream& output)
+{
+   if (inventory == nullptr || registry == nullptr) {
+      cerr << "Store files are not loaded.\n\n";
+      return;
+   }
+   processTransactions(*inventory, *registry, output);
+   journal.sync();
+
+   if (!saveSnapshotFile.empty())
+      Checkpoint::write(*inventory, *registry, saveSnapshotFile);
+
+   if (reportStats) {
+      clog << "Transaction log: " << registry->getLog().size() << " entries, "
+         << registry->getLog().memoryUsed() << " bytes" << endl;
+      inventory->outputLookupStats(clog);   // Sums the counts of every worker
+      inventory->outputDisplayStats(clog);
+      if (journal.isOpen())
+         journal.outputStats(clog);
+   }
+}
+
+/** ----------------------------- outputReports(ostream&) ---------------
+* Outputs the full inventory and every customer's history, the same as
+*   a 'D' command followed by an 'H' command.
+* @param output Stream the reports are written to.
+* @pre  loadFiles() was called.
+*/
+void CollectibleStore::outputReports(ostream& output)
+{
+   if (inventory == nullptr || registry == nullptr) {
+      cerr << "Store files are not loaded.\n\n";
+      return;
+   }
+   Command command;
+
+   command.action = 'D';
+   dispatch(*inventory, *registry, command, output);
+   command.action = 'H';
+   dispatch(*inventory, *registry, command, output);
+   output.flush();
+}
+
+/** ----------------------------- beginProcessing() ---------------------
+* Calls loadFiles() then runTransactions() on standard output, or the file
+*   set by setOutputFile(string).
+* Each phase can also be called on its own, such as to time them separately.
+* @pre  Inventory and CustomerRegistry are able to properly initialize and
+*         read input files.
+* @post CollectibleStore can safely be destroyed as all operations are
+*         complete at the end of this method in this implementation.
+*/
+void CollectibleStore::beginProcessing()
+{
+   loadFiles();                           // Build inventory and customers
+
+   OutputSink sink(outputFile.empty() ? OutputSink::TO_STDOUT : OutputSink::TO_FILE,
+                   outputFile);
+   ostream output(&sink);
+   runTransactions(output);               // Process transactions
+}
+
+/** ----------------------------- dispatch(...) ---------------------
+* Uses actions[] to call the correct operation for a parsed command.
+* @param inv     Store inventory.
+* @param cust    Store customer registry.
+* @param command Parsed transaction line.
+* @param output  Stream the operation's report is written to.
+*/
+void CollectibleStore::dispatch(Inventory& inv, CustomerRegistry& cust, const Command& command,
+                                ostream& output)
+{
+   int slot = hash(command.action);
+   if (slot < 0 || slot >= SUPPORTED_TRANSACTIONS || actions[slot] == nullptr) {
+      output << "Unrecognized Transaction entered.\n\n";
+      return;   // nullptr = transaction not found in actions[], skip
+   }
+   actions[slot]->process(inv, cust, command, output);
+}
+
+/** ----------------------------- processTransactions() ---------------------
+* Reads transactions input file and processes it line-by-line.
+* Each line is parsed into a Command without copying it, then actions[] is
+*   used to call correct operations based on input file commands.
+* Hands off to processStreams() when streams were added, otherwise to
+*   processConcurrent() when more than one worker is set, or to
+*   processPipelined() when pipelining is enabled.
+* @param output Stream reports are written to, flushed only before error
+*                 messages and once all transactions are processed.
+* @pre  Transactions input file is accessible and correctly formatted.
+* @post All operations are carried out and outputs are written to output.
+*/
+void CollectibleStore::processTransactions(Inventory& inv, CustomerRegistry& cust, ostream& output)
+{
+   if (!streamFiles.empty()) {
+      processStreams(inv, cust, output);
+      return;
+   }
+   if (workers > 1) {
+      processConcurrent(inv, cust, output);
+      return;
+   }
+   if (pipelined) {
+      processPipelined(inv, cust, output);
+      return;
+   }
+
+   ifstream input(transactionFile);
+   string fileInput;       // Reused for every line, keeps its capacity
+   Command command;        // Views into fileInput, rebuilt for every line
+   ostream* tied = cerr.tie(&output);  // Keep errors in order with reports
+   
+   for (uint64_t sequence = 0; input.peek() != EOF; sequence++) {
+      getline(input, fileInput);
+      
+      if (!CommandParser::parseCommand(fileInput, command))
+         continue;   // Blank line, nothing to process
+      command.sequence = sequence;
+
+      dispatch(inv, cust, command, output);
+   }
+   output.flush();
+   cerr.tie(tied);
+}
+
+/** ----------------------------- processPipelined() ---------------------
+* Processes the transactions file in three stages connected by SpscQueues:
+*   a parse thread reads and parses lines, the calling thread applies
+*   each command to inv and cust, and a write thread outputs the reports.
+* Commands are applied one at a time in file order and their reports are
+*   written in the same order, so output matches processTransactions().
+* Error messages are captured from cerr while commands are applied and are
+*   written in order with the reports, so output and cerr interleave as in
+*   processTransactions().
+* @param output Stream reports are written to by the write thread.
+* @pre  Transactions input file is accessible and correctly formatted.
+* @post All operations are carried out and outputs are written to output.
+*       Queue statistics are reported to clog if reportStats is set.
+*/
+void CollectibleStore::processPipelined(Inventory& inv, CustomerRegistry& cust, ostream& output)
+{
+   SpscQueue<PendingCommand> commands(COMMAND_QUEUE_SLOTS);
+   SpscQueue<PendingOutput> outputs(OUTPUT_QUEUE_SLOTS);
+
+   OutputSink reportSink(OutputSink::TO_MEMORY);   // Command being applied
+   OutputSink errorSink(OutputSink::TO_MEMORY);
+   ostream rendered(&reportSink);
+   streambuf* console = cerr.rdbuf(&errorSink);
+   ostream* tied = cerr.tie(nullptr);  // Only the write thread flushes output
+
+   thread parser([&] {        // Stage 1: read and parse
+      ifstream input(transactionFile);
+
+      for (uint64_t sequence = 0; input.peek() != EOF; sequence++) {
+         PendingCommand* next = commands.beginPush();
+         getline(input, next->line);
+
+         if (!CommandParser::parseCommand(next->line, next->command))
+            continue;   // Blank line, slot is reused
+         next->command.sequence = sequence;
+         next->last = false;
+         commands.endPush();
+      }
+      commands.beginPush()->last = true;
+      commands.endPush();
+   });
+
+   thread writer([&] {        // Stage 3: write reports in order
+      ostream errorOutput(console);
+
+      while (true) {
+         PendingOutput* next = outputs.beginPop();
+         if (next->last) {
+            outputs.endPop();
+            break;
+         }
+         output << next->text;
+         if (!next->errors.empty()) {
+            output.flush();     // Same order as when cerr flushes output
+            errorOutput << next->errors << flush;
+         }
+         if (next->text.capacity() > KEEP_REPORT_BYTES)
+            string().swap(next->text);   // Don't hold full displays per slot
+         outputs.endPop();
+      }
+      output.flush();
+   });
+
+   while (true) {             // Stage 2: apply, on this thread
+      PendingCommand* next = commands.beginPop();
+      if (next->last) {
+         commands.endPop();
+         break;
+      }
+      dispatch(inv, cust, next->command, rendered);
+      commands.endPop();
+
+      const string& text = reportSink.contents();
+      const string& errors = errorSink.contents();
+      if (!text.empty() || !errors.empty()) {
+         PendingOutput* report = outputs.beginPush();
+         report->text.assign(text);       // Slot strings keep their capacity
+         report->errors.assign(errors);
+         report->last = false;
+         outputs.endPush();
+
+         reportSink.clear();
+         errorSink.clear();
+      }
+   }
+   outputs.beginPush()->last = true;
+   outputs.endPush();
+
+   parser.join();
+   writer.join();
+   cerr.rdbuf(console);
+   cerr.tie(tied);
+
+   if (reportStats) {         // Pushes include the end of input markers
+      clog << "Pipeline parse stage: " << commands.getPushes() - 1 << " commands, "
+         << commands.getPushStalls() << " stalls on a full queue" << endl;
+      clog << "Pipeline apply stage: " << outputs.getPushes() - 1 << " reports, "
+         << commands.getPopStalls() << " stalls on an empty queue, "
+         << outputs.getPushStalls() << " stalls on a full queue" << endl;
+      clog << "Pipeline write stage: " << outputs.getPopStalls()
+         << " stalls on an empty queue" << endl;
+      clog << "Command queue: " << commands.capacity() << " slots, mean depth "
+         << commands.getMeanDepth() << ", max depth " << commands.getMaxDepth() << endl;
+      clog << "Output queue: " << outputs.capacity() << " slots, mean depth "
+         << outputs.getMeanDepth() << ", max depth " << outputs.getMaxDepth() << endl;
+   }
+}
+
+/** ----------------------------- processConcurrent() ---------------------
+* Processes the transactions file with buys and sells applied by several
+*   worker threads at once.
+* Consecutive buys and sells are read into a batch and each is routed to
+*   the worker owning its item, so trades of an item are applied in file
+*   order by a single thread. Customer histories are then updated by
+*   workers owning a shard of the customers, also in file order.
+* Every other command is a barrier: the batch before it completes, then it
+*   runs alone on the calling thread, as do batches too small to be worth
+*   waking the workers.
+* Error messages are captured per command and output in file order, so
+*   output matches processTransactions().
+* @param output Stream reports are written to.
+* @pre  Transactions input file is accessible and correctly formatted.
+* @post All operations are carried out and outputs are written to output.
+*       Batch statistics are reported to clog if reportStats is set.
+*/
+void CollectibleStore::processConcurrent(Inventory& inv, CustomerRegistry& cust, ostream& output)
+{
+   ifstream input(transactionFile);
+   vector<BatchedCommand> batch(BATCH_COMMANDS + 1); // Last slot for a barrier
+   ThreadPool pool(workers);
+   size_t shards = pool.size();
+
+   ThreadCapture capture(cerr.rdbuf());   // Errors of each command kept apart
+   streambuf* console = cerr.rdbuf(&capture);
+   ostream* tied = cerr.tie(nullptr);     // Workers must not flush output
+   ostream errorOutput(console);
+
+   uint64_t sequence = 0;                 // Line number of the next line
+   uint64_t batches = 0;
+   uint64_t batchedCommands = 0;
+   uint64_t aloneCommands = 0;
+
+   auto runAlone = [&](BatchedCommand& next, uint64_t lineNumber) {
+      if (!CommandParser::parseCommand(next.line, next.command))
+         return;        // Blank line, nothing to process
+      next.command.sequence = lineNumber;
+      ThreadCapture::capture(&next.errors);
+      dispatch(inv, cust, next.command, output);
+      ThreadCapture::capture(nullptr);
+      outputErrors(next.errors, output, errorOutput);
+      aloneCommands++;
+   };
+
+   while (input.peek() != EOF) {
+      uint64_t first = sequence;
+      size_t count = 0;
+      bool barrier = false;
+
+      // Read buys and sells until the batch is full or another command
+      while (count < BATCH_COMMANDS && input.peek() != EOF) {
+         getline(input, batch[count].line);
+         sequence++;
+
+         // A malformed buy or sell reports an error, so it runs alone too
+         string_view text = CommandParser::trim(batch[count].line);
+         if (!text.empty() && ((text[0] != 'B' && text[0] != 'S')
+                               || (text.size() > 1 && text[1] != ','))) {
+            barrier = true;               // Stays in batch[count]
+            break;
+         }
+         count++;
+      }
+
+      if (count < MIN_BATCH_COMMANDS) {   // Not worth waking the workers
+         for (size_t i = 0; i < count; i++)
+            runAlone(batch[i], first + i);
+
+      } else {
+         cust.beginBatch(first, count);
+
+         pool.parallelFor(shards, [&](size_t part) {   // Parse and route
+            for (size_t i = count * part / shards; i < count * (part + 1) / shards; i++) {
+               BatchedCommand& next = batch[i];
+               const ItemRecord& item = next.command.item;
+
+               next.parsed = CommandParser::parseCommand(next.line, next.command);
+               next.command.sequence = first + i;
+               next.shard = ItemIndex::hashKey(item.symbol, item.year, item.grade,
+                                               item.name, item.type) % shards;
+            }
+         });
+
+         pool.parallelFor(shards, [&](size_t shard) {  // Apply trades by item
+            for (size_t i = 0; i < count; i++) {
+               BatchedCommand& next = batch[i];
+               if (!next.parsed || next.shard != shard)
+                  continue;
+
+               ThreadCapture::capture(&next.errors);
+               dispatch(inv, cust, next.command, output); // Buys and sells
+               ThreadCapture::capture(nullptr);           //   output nothing
+            }
+         });
+
+         pool.parallelFor(shards, [&](size_t shard) {  // Log trades by customer
+            cust.commitBatch((int)shard, (int)shards);
+         });
+         cust.endBatch();
+
+         for (size_t i = 0; i < count; i++)
+            outputErrors(batch[i].errors, output, errorOutput);
+         batches++;
+         batchedCommands += count;
+      }
+
+      if (barrier)                        // Runs alone once the batch is done
+         runAlone(batch[count], first + count);
+   }
+   output.flush();
+   cerr.rdbuf(console);
+   cerr.tie(tied);
+
+   if (reportStats) {
+      clog << "Concurrent engine: " << shards << " workers, " << batchedCommands
+         << " commands in " << batches << " batches, " << aloneCommands
+         << " commands run alone" << endl;
+   }
+}
+
+/** ----------------------------- processStreams() ---------------------
+* Processes the transactions file together with every stream added by
+*   addStream(), all against the same Inventory and CustomerRegistry, on
+*   a WorkStealingPool of the set number of workers.
+* Each stream runs as a chain of tasks applying a chunk of its commands
+*   and then submitting the next chunk, so commands of a stream are
+*   applied in order while idle workers steal chunks of other streams.
+* Buys and sells of different streams run at the same time, every other
+*   command runs while no other command is applied.
+* Reports of the transactions file go to output, those of an added stream
+*   to a file named after it with ".out" appended. Error messages go to
+*   cerr, prefixed with the name of their stream.
+* @param output Stream reports of the transactions file are written to.
+* @pre  Every command file is accessible and correctly formatted.
+* @post All operations are carried out and outputs are written.
+*       Throughput and queueing delay of each stream are reported to clog
+*         if reportStats is set.
+*/
+void CollectibleStore::processStreams(Inventory& inv, CustomerRegistry& cust, ostream& output)
+{
+   vector<CommandStream*> streams;
+   WorkStealingPool pool(workers);
+   shared_mutex storeLock;                // Shared by buys and sells only
+   mutex consoleLock;                     // Errors of one command at a time
+
+   ThreadCapture capture(cerr.rdbuf());   // Errors of each stream kept apart
+   streambuf* console = cerr.rdbuf(&capture);
+   ostream* tied = cerr.tie(nullptr);     // Workers must not flush output
+   ostream errorOutput(console);
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+   streams.push_back(new CommandStream);
+   streams.back()->fileName = transactionFile;
+   streams.back()->output = &output;
+
+   for (const string& fileName : streamFiles) {
+      CommandStream* stream = new CommandStream;
+      stream->fileName = fileName;
+      stream->sink = new OutputSink(OutputSink::TO_FILE, fileName + ".out");
+      stream->output = new ostream(stream->sink);
+      streams.push_back(stream);
+   }
+
+   function<void(CommandStream*)> runChunk = [&](CommandStream* stream) {
+      chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+      double waited = chrono::duration<double>(begin - stream->queuedAt).count();
+      Command command;     // Views into stream->line
+
+      stream->waitSeconds += waited;
+      stream->maxWaitSeconds = max(stream->maxWaitSeconds, waited);
+      stream->chunks++;
+
+      for (int i = 0; i < STREAM_CHUNK_COMMANDS && stream->input.peek() != EOF; i++) {
+         getline(stream->input, stream->line);
+         uint64_t lineNumber = stream->sequence++;
+
+         if (!CommandParser::parseCommand(stream->line, command))
+            continue;   // Blank line, nothing to process
+         command.sequence = lineNumber;
+
+         ThreadCapture::capture(&stream->errors);
+         if (command.action == 'B' || command.action == 'S') {
+            shared_lock<shared_mutex> trading(storeLock);
+            dispatch(inv, cust, command, *stream->output);
+         } else {
+            unique_lock<shared_mutex> alone(storeLock);
+            dispatch(inv, cust, command, *stream->output);
+         }
+         ThreadCapture::capture(nullptr);
+         stream->commands++;
+
+         if (!stream->errors.empty()) {
+            lock_guard<mutex> guard(consoleLock);
+            stream->output->flush();      // Same order as when cerr flushes output
+            errorOutput << stream->fileName << ": " << stream->errors << flush;
+            stream->errors.clear();
+         }
+      }
+
+      chrono::steady_clock::time_point end = chrono::steady_clock::now();
+      stream->busySeconds += chrono::duration<double>(end - begin).count();
+
+      if (stream->input.peek() != EOF) {  // Next chunk, likely on this worker
+         stream->queuedAt = end;
+         pool.submit([&runChunk, stream] { runChunk(stream); });
+      } else {
+         stream->output->flush();
+         stream->doneSeconds = chrono::duration<double>(end - start).count();
+      }
+   };
+
+   for (CommandStream* stream : streams) {
+      stream->input.open(stream->fileName);
+      stream->queuedAt = chrono::steady_clock::now();
+      pool.submit([&runChunk, stream] { runChunk(stream); });
+   }
+   pool.wait();
+   cerr.rdbuf(console);
+   cerr.tie(tied);
+
+   for (CommandStream* stream : streams) {
+      if (reportStats) {
+         clog << "Stream " << stream->fileName << ": " << stream->commands
+            << " commands in " << stream->busySeconds << " s ("
+            << (stream->busySeconds > 0 ? stream->commands / stream->busySeconds : 0)
+            << " commands/s), done after " << stream->doneSeconds
+            << " s, queue delay mean "
+            << (stream->chunks > 0 ? stream->waitSeconds / stream->chunks * 1000 : 0)
+            << " ms, max " << stream->maxWaitSeconds * 1000 << " ms over "
+            << stream->chunks << " chunks" << endl;
+      }
+      if (stream->sink != nullptr) {
+         delete stream->output;
+         delete stream->sink;
+      }
+      delete stream;
+   }
+   if (reportStats) {
+      clog << "Work-stealing pool: " << pool.size() << " workers, "
+         << pool.getSteals() << " chunks stolen" << endl;
+   }
+}
+
+/** ----------------------------- outputErrors(string&, ...) --------------
+* Writes errors captured from a command after any report output before it.
+* @param errors  Captured error messages, cleared once written.
+* @param output  Report stream, flushed first if there are errors.
+* @param console Stream the errors are written to.
+*/
+void CollectibleStore::outputErrors(string& errors, ostream& output, ostream& console)
+{
+   if (errors.empty())
+      return;
+   output.flush();               // Same order as when cerr flushes output
+   console << errors << flush;
+   errors.clear();
+}
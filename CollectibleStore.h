@@ -1,88 +1,386 @@
-/** @file CollectibleStore.h
- * @author Korosh Moosavi
- * @date 2021-03-12
- *
- * CollectibleStore class:
- * This class is the main driver of the program.
- * There is an initial constructed state after creation then all operations
- *   carry out automatically once beginProcessing() is called.
- *   This decision was made arbitrarily for ease of use, feel free to change it
- * There is room for future development and implementations.
- *
- * Assumptions:
- * All relevant input files are in the same directory as this.
- * Input file names are given in the order: Inventory, Customer, Transactions
- */
-#pragma once
-#include "CustomerRegistry.h"
-#include "Inventory.h"
-#include "Buy.h"
-#include "Sell.h"
-#include "TCustomer.h"
-#include "History.h"
-#include "Display.h"
-
-class CollectibleStore {
-private:
-   static const int SUPPORTED_TRANSACTIONS = 26; // 1 per alphabetic letter
-   Transaction* actions[SUPPORTED_TRANSACTIONS];
-   string inventoryFile;
-   string customerFile;
-   string transactionFile;
-
-   /** ----------------------------- hash(char) ---------------------
-    * Transaction types are identified by a single capital letter
-    * @pre    c is between A and Z (65 and 90)
-    * @return A unique int value between 0 and 25 inclusive
-    */
-   int hash(char c) const { return c - 'A'; }
-
-   /** ----------------------------- processTransactions() ---------------------
-   * Reads transactions input file and processes it line-by-line.
-   * Uses actions[] to call correct operations based on input file commands.
-   * @pre  Transactions input file is accessible and correctly formatted.
-   * @post All operations are carried out and outputs are output to console.
-   */
-   void processTransactions(Inventory& inv, CustomerRegistry& cust);
-
-public:
-   /** ------------------------------ Constructor ----------------------
-   * Assigns file names to private members so that this object is ready to
-   *   begin processing on command.
-   * @param invFileName  File containing data on the store's inventory.
-   * @param custFileName File containing data on the store's customers.
-   * @param txFileName   File containing data on the store's transactions.
-   * @pre  Files are correctly formatted and names are input via calling method.
-   * @post On completion of construction, this object will be ready to process
-   *         all the data included in the files.
-   */
-   CollectibleStore(string invFileName, string custFileName, string txFileName);
-
-   /** ----------------------------- Destructor ---------------------
-   * All dummy objects in actions[] are deleted and no more memory is tied
-   *   to this object.
-   * All other memory deallocation is taken care of by other classes.
-   * @pre   None
-   * @post  Memory tied to this CollectibleStore object is freed.
-   */
-   ~CollectibleStore();
-
-   /** ----------------------------- beginProcessing() ---------------------
-   * Manually create dummy Transaction subclass objects for quick access to
-   *   their process().
-   * Place them at the appropriate indeces within the hash table actions[]
-   * Same structure as Factory class, but not used to create new objects.
-   * Then call processTransactions()
-   *   Optionally, in future implementations this method can be decoupled for
-   *     further modification/customization of operations.
-   *   These methods were coupled for this implementation for ease of use due
-   *     to the fairly simple scope of the implementation.
-   * @pre  Inventory and CustomerRegistry are able to properly initialize and
-   *         read input files.
-   *       All currently supported Transaction subclasses are updated into the
-   *         implementation for this method.
-   * @post CollectibleStore can safely be destroyed as all operations are
-   *         complete at the end of this method in this implementation.
-   */
-   void beginProcessing();
+/** @file CollectibleStore.h
+ * @author Korosh Moosavi
+ * @date 2021-03-12
+ *
+ * CollectibleStore class:
+ * This class is the main driver of the program.
+ * There is an initial constructed state after creation then all operations
+ *   carry out automatically once beginProcessing() is called.
+ *   This decision was made arbitrarily for ease of use, feel free to change it
+ * There is room for future development and implementations.
+ *
+ * Assumptions:
+ * All relevant input files are in the same directory as this.
+ * Input file names are given in the order: Inventory, Customer, Transactions
+ */
+#pragma once
+#include "CustomerRegistry.h"
+#include "Inventory.h"
+#include "Buy.h"
+#include "Sell.h"
+#include "TCustomer.h"
+#include "History.h"
+#include "Display.h"
+#include "GradeQuery.h"
+#include "RangeQuery.h"
+#include "Lookup.h"
+#include "NameQuery.h"
+#include "Register.h"
+#include "Checkpoint.h"
+#include "SpscQueue.h"
+#include "OutputSink.h"
+#include "ThreadCapture.h"
+#include "WorkStealingPool.h"
+#include <chrono>
+#include <fstream>
+#include <shared_mutex>
+#include <thread>
+
+class CollectibleStore {
+private:
+   static const int SUPPORTED_TRANSACTIONS = 26; // 1 per alphabetic letter
+   Transaction* actions[SUPPORTED_TRANSACTIONS];
+   string inventoryFile;
+   string customerFile;
+   string transactionFile;
+   string outputFile;
+   string snapshotFile;       // Loaded instead of the input files if set
+   string saveSnapshotFile;   // Written once transactions are done if set
+   string journalFile;        // Replayed and appended to if set
+   int journalDelay;          // Longest wait for a group commit, in us
+   Journal journal;
+   vector<string> streamFiles;   // Extra command streams, see addStream()
+   bool reportStats;
+   int loadThreads;
+   bool pipelined;
+   int workers;               // Threads applying buys and sells
+   Inventory* inventory;      // Loaded by loadFiles()
+   CustomerRegistry* registry;
+
+   static const int COMMAND_QUEUE_SLOTS = 1024; // Parsed lines awaiting apply
+   static const int OUTPUT_QUEUE_SLOTS = 32;    // Reports awaiting write
+   static const size_t KEEP_REPORT_BYTES = 1 << 20; // Larger reports are freed
+   static const int BATCH_COMMANDS = 4096;      // Trades applied concurrently
+   static const int MIN_BATCH_COMMANDS = 64;    // Smaller batches run alone
+   static const int STREAM_CHUNK_COMMANDS = 256; // Stream commands per task
+
+   /** ------------------------ PendingCommand struct --------------------------
+    * Queue slot passed from the parse stage to the apply stage
+    * command views into line, so both travel together and line keeps its
+    *   capacity when the slot is reused
+    * last marks the end of the transaction file, command is not set
+    */
+   struct PendingCommand {
+      string line;
+      Command command;
+      bool last = false;
+   };
+
+   /** ------------------------ BatchedCommand struct --------------------------
+    * Slot of a batch of buys and sells applied by processConcurrent()
+    * command views into line, shard is the worker that applies the command
+    * errors holds what the command wrote to cerr, output once the batch is
+    *   done
+    */
+   struct BatchedCommand {
+      string line;
+      Command command;
+      bool parsed = false;
+      size_t shard = 0;
+      string errors;
+   };
+
+   /** ------------------------ CommandStream struct --------------------------
+    * A command file run by processStreams(), such as one per register
+    * output is the stream's report target and errors collects what the
+    *   command being applied writes to cerr
+    * queuedAt is when the next chunk of the stream was submitted, used to
+    *   measure how long chunks wait for a worker
+    */
+   struct CommandStream {
+      string fileName;
+      ifstream input;
+      OutputSink* sink = nullptr;   // Own report file, nullptr for the main
+      ostream* output = nullptr;    //   transactions file
+      string line;
+      string errors;
+      uint64_t sequence = 0;        // Line number of the next line
+      uint64_t commands = 0;
+      uint64_t chunks = 0;
+      double busySeconds = 0;       // Time spent applying commands
+      double waitSeconds = 0;       // Time chunks spent queued
+      double maxWaitSeconds = 0;
+      double doneSeconds = 0;       // Time from start until the last command
+      chrono::steady_clock::time_point queuedAt;
+   };
+
+   /** ------------------------ PendingOutput struct --------------------------
+    * Queue slot passed from the apply stage to the write stage
+    * Holds everything one command wrote to its report and to cerr
+    * last marks that every command has been applied
+    */
+   struct PendingOutput {
+      string text;
+      string errors;
+      bool last = false;
+   };
+
+   /** ----------------------------- hash(char) ---------------------
+    * Transaction types are identified by a single capital letter
+    * @pre    c is between A and Z (65 and 90)
+    * @return A unique int value between 0 and 25 inclusive
+    */
+   int hash(char c) const { return c - 'A'; }
+
+   /** ----------------------------- loadSnapshot() ---------------------
+   * Builds the Inventory and CustomerRegistry from the snapshot file.
+   * @pre  Neither is loaded.
+   * @post Both are loaded and true is returned, or neither is and false is
+   *         returned if the snapshot could not be read.
+   */
+   bool loadSnapshot();
+
+   /** ----------------------------- replayJournal() ---------------------
+   * Applies every change in the journal file to the loaded store, then
+   *   opens the journal so new changes are appended to it.
+   * Log entries are replayed in journal order, while stock is changed once
+   *   per item by the net amount, so trades of several streams that were
+   *   journaled in a different order than their stock changes still apply.
+   * Trades that would not apply, such as the last sells of an item a torn
+   *   journal would leave below 0 stock, are left out of history and stock.
+   * @pre  The Inventory and CustomerRegistry are loaded from the state the
+   *         journal was started on.
+   * @post The store holds every change of the journal, and the registry
+   *         appends new changes to it. Replay statistics are reported to
+   *         clog if reportStats is set.
+   */
+   void replayJournal();
+
+   /** ----------------------------- dispatch(...) ---------------------
+   * Uses actions[] to call the correct operation for a parsed command.
+   * @param inv     Store inventory.
+   * @param cust    Store customer registry.
+   * @param command Parsed transaction line.
+   * @param output  Stream the operation's report is written to.
+   */
+   void dispatch(Inventory& inv, CustomerRegistry& cust, const Command& command,
+                 ostream& output);
+
+   /** ----------------------------- processTransactions() ---------------------
+   * Reads transactions input file and processes it line-by-line.
+   * Each line is parsed into a Command without copying it, then actions[] is
+   *   used to call correct operations based on input file commands.
+   * Hands off to processStreams() when streams were added, otherwise to
+   *   processConcurrent() when more than one worker is set, or to
+   *   processPipelined() when pipelining is enabled.
+   * @param output Stream reports are written to, flushed only before error
+   *                 messages and once all transactions are processed.
+   * @pre  Transactions input file is accessible and correctly formatted.
+   * @post All operations are carried out and outputs are written to output.
+   */
+   void processTransactions(Inventory& inv, CustomerRegistry& cust, ostream& output);
+
+   /** ----------------------------- processPipelined() ---------------------
+   * Processes the transactions file in three stages connected by SpscQueues:
+   *   a parse thread reads and parses lines, the calling thread applies
+   *   each command to inv and cust, and a write thread outputs the reports.
+   * Commands are applied one at a time in file order and their reports are
+   *   written in the same order, so output matches processTransactions().
+   * @param output Stream reports are written to by the write thread.
+   * @pre  Transactions input file is accessible and correctly formatted.
+   * @post All operations are carried out and outputs are written to output.
+   *       Queue statistics are reported to clog if reportStats is set.
+   */
+   void processPipelined(Inventory& inv, CustomerRegistry& cust, ostream& output);
+
+   /** ----------------------------- processConcurrent() ---------------------
+   * Processes the transactions file with buys and sells applied by several
+   *   worker threads at once.
+   * Consecutive buys and sells are read into a batch and each is routed to
+   *   the worker owning its item, so trades of an item are applied in file
+   *   order by a single thread. Customer histories are then updated by
+   *   workers owning a shard of the customers, also in file order.
+   * Every other command is a barrier: the batch before it completes, then it
+   *   runs alone on the calling thread, as do batches too small to be worth
+   *   waking the workers.
+   * Error messages are captured per command and output in file order, so
+   *   output matches processTransactions().
+   * @param output Stream reports are written to.
+   * @pre  Transactions input file is accessible and correctly formatted.
+   * @post All operations are carried out and outputs are written to output.
+   *       Batch statistics are reported to clog if reportStats is set.
+   */
+   void processConcurrent(Inventory& inv, CustomerRegistry& cust, ostream& output);
+
+   /** ----------------------------- processStreams() ---------------------
+   * Processes the transactions file together with every stream added by
+   *   addStream(), all against the same Inventory and CustomerRegistry, on
+   *   a WorkStealingPool of the set number of workers.
+   * Each stream runs as a chain of tasks applying a chunk of its commands
+   *   and then submitting the next chunk, so commands of a stream are
+   *   applied in order while idle workers steal chunks of other streams.
+   * Buys and sells of different streams run at the same time, every other
+   *   command runs while no other command is applied.
+   * Reports of the transactions file go to output, those of an added stream
+   *   to a file named after it with ".out" appended. Error messages go to
+   *   cerr, prefixed with the name of their stream.
+   * @param output Stream reports of the transactions file are written to.
+   * @pre  Every command file is accessible and correctly formatted.
+   * @post All operations are carried out and outputs are written.
+   *       Throughput and queueing delay of each stream are reported to clog
+   *         if reportStats is set.
+   */
+   void processStreams(Inventory& inv, CustomerRegistry& cust, ostream& output);
+
+   /** ----------------------------- outputErrors(string&, ...) --------------
+   * Writes errors captured from a command after any report output before it.
+   * @param errors  Captured error messages, cleared once written.
+   * @param output  Report stream, flushed first if there are errors.
+   * @param console Stream the errors are written to.
+   */
+   static void outputErrors(string& errors, ostream& output, ostream& console);
+
+public:
+   /** ------------------------------ Constructor ----------------------
+   * Assigns file names to private members so that this object is ready to
+   *   begin processing on command.
+   * @param invFileName  File containing data on the store's inventory.
+   * @param custFileName File containing data on the store's customers.
+   * @param txFileName   File containing data on the store's transactions.
+   * @pre  Files are correctly formatted and names are input via calling method.
+   * @post On completion of construction, this object will be ready to process
+   *         all the data included in the files.
+   */
+   CollectibleStore(string invFileName, string custFileName, string txFileName);
+
+   /** ----------------------------- Destructor ---------------------
+   * All dummy objects in actions[] and the loaded Inventory and
+   *   CustomerRegistry are deleted and no more memory is tied to this object.
+   * All other memory deallocation is taken care of by other classes.
+   * @pre   None
+   * @post  Memory tied to this CollectibleStore object is freed.
+   */
+   ~CollectibleStore();
+
+   /** ----------------------------- setReportStats(bool) ---------------------
+   * Enables or disables reporting of load throughput and lookup index
+   *   statistics to clog once the input files are loaded.
+   * @param report True to report statistics, false to stay silent (default)
+   */
+   void setReportStats(bool report) { reportStats = report; };
+
+   /** ----------------------------- setLoadThreads(int) ---------------------
+   * Sets how many threads parse the input files and build the inventory and
+   *   customer registry. The loaded state is the same for any thread count.
+   * @param threads 1 to load serially (default), 0 for one thread per core
+   */
+   void setLoadThreads(int threads)
+   { loadThreads = threads == 0 ? ThreadPool::hardwareThreads() : threads; };
+
+   /** ----------------------------- setPipelined(bool) ---------------------
+   * Enables or disables processing transactions as a pipeline, so reading
+   *   and writing overlap with applying commands. Output is the same.
+   * @param enable True to use processPipelined(), false for a single thread
+   *                 (default)
+   */
+   void setPipelined(bool enable) { pipelined = enable; };
+
+   /** ----------------------------- setWorkers(int) ---------------------
+   * Sets how many threads apply buys and sells, see processConcurrent().
+   *   Output is the same for any thread count, and takes precedence over
+   *   setPipelined(bool).
+   * @param threads 1 to apply on a single thread (default), 0 for one thread
+   *                  per core
+   */
+   void setWorkers(int threads)
+   { workers = threads == 0 ? ThreadPool::hardwareThreads() : threads; };
+
+   /** ----------------------------- addStream(string) ---------------------
+   * Adds a command file processed at the same time as the transactions
+   *   file, such as the commands of another register, see processStreams().
+   * Stream commands run on the number of threads set by setWorkers(int).
+   * @param fileName Command file in the same format as the transactions file
+   */
+   void addStream(const string& fileName) { streamFiles.push_back(fileName); };
+
+   /** ----------------------------- setOutputFile(string) ---------------------
+   * Sends transaction reports to a file instead of standard output.
+   * Error messages still go to cerr.
+   * @param fileName File to create, empty for standard output (default)
+   */
+   void setOutputFile(const string& fileName) { outputFile = fileName; };
+
+   /** ----------------------------- setSnapshotFile(string) -----------------
+   * Starts the store from a Snapshot written by a 'W' command or by
+   *   setSaveSnapshotFile(string), instead of parsing the input files.
+   * The input files are loaded as usual if the snapshot cannot be read.
+   * @param fileName Snapshot to load, empty to load the input files (default)
+   */
+   void setSnapshotFile(const string& fileName) { snapshotFile = fileName; };
+
+   /** ----------------------------- setSaveSnapshotFile(string) -------------
+   * Saves a Snapshot of the whole store once runTransactions() is done.
+   * @param fileName File to write, empty to save nothing (default)
+   */
+   void setSaveSnapshotFile(const string& fileName) { saveSnapshotFile = fileName; };
+
+   /** ----------------------------- setJournalFile(string, int) -------------
+   * Keeps a Journal of every trade and registration, so a run that crashes
+   *   can be recovered by starting again with the same input files or
+   *   snapshot and the same journal.
+   * An existing journal is replayed by loadFiles() before new changes are
+   *   appended to it.
+   * @param fileName Journal to replay and append to, empty for none (default)
+   * @param delay    Longest a change waits, in microseconds, to be made
+   *                   durable with the changes after it
+   */
+   void setJournalFile(const string& fileName, int delay = 1000)
+   { journalFile = fileName; journalDelay = delay; };
+
+   /** ----------------------------- loadFiles() ---------------------
+   * Manually create dummy Transaction subclass objects for quick access to
+   *   their process().
+   * Place them at the appropriate indeces within the hash table actions[]
+   * Same structure as Factory class, but not used to create new objects.
+   * Then builds the Inventory and CustomerRegistry from the snapshot file if
+   *   one is set, or else from their input files, replacing any loaded before.
+   *   Input files are built concurrently on a ThreadPool when more than one
+   *   load thread is set, see setLoadThreads(int). The journal file is
+   *   replayed on top if one is set.
+   * @pre  All currently supported Transaction subclasses are updated into the
+   *         implementation for this method.
+   * @post Store is ready for runTransactions() and outputReports().
+   *       Load statistics are reported to clog if reportStats is set.
+   */
+   void loadFiles();
+
+   /** ----------------------------- runTransactions(ostream&) ---------------
+   * Processes the transactions input file against the loaded store, then
+   *   waits for the journal to be durable and saves a snapshot if
+   *   setSaveSnapshotFile(string) was called.
+   * @param output Stream reports are written to, flushed once all
+   *                 transactions are processed.
+   * @pre  loadFiles() was called.
+   * @post All operations are carried out and outputs are written to output.
+   */
+   void runTransactions(ostream& output);
+
+   /** ----------------------------- outputReports(ostream&) ---------------
+   * Outputs the full inventory and every customer's history, the same as
+   *   a 'D' command followed by an 'H' command.
+   * @param output Stream the reports are written to.
+   * @pre  loadFiles() was called.
+   */
+   void outputReports(ostream& output);
+
+   /** ----------------------------- beginProcessing() ---------------------
+   * Calls loadFiles() then runTransactions() on standard output, or the file
+   *   set by setOutputFile(string).
+   * Each phase can also be called on its own, such as to time them separately.
+   * @pre  Inventory and CustomerRegistry are able to properly initialize and
+   *         read input files.
+   * @post CollectibleStore can safely be destroyed as all operations are
+   *         complete at the end of this method in this implementation.
+   */
+   void beginProcessing();
 };
\ No newline at end of file
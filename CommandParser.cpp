@@ -0,0 +1,160 @@
+/** @file CommandParser.cpp
+ * @author Korosh Moosavi
+ * @date 2026-10-16
+ *
+ * CommandParser class:
+ * Splits inventory and command lines into typed records without copying.
+ * Every string field of a record is a string_view into the parsed line, so
+ *   parsing a line never allocates memory.
+ *
+ * Assumptions:
+ * Parsed line outlives every record built from it.
+ * Fields are separated by a comma and optional spaces.
+ */
+#include "CommandParser.h"
+#include <charconv>
+
+/** ----------------------------- trim(string_view) ---------------------
+ * @return Parameter without leading and trailing spaces
+ */
+string_view CommandParser::trim(string_view text)
+{
+   while (!text.empty() && text.front() == ' ')
+      text.remove_prefix(1);
+   while (!text.empty() && (text.back() == ' ' || text.back() == '\r'))
+      text.remove_suffix(1);
+   return text;
+}
+
+/** ----------------------------- nextField(string_view&) ---------------
+ * Removes the next comma separated field from the front of rest.
+ * @param rest Unparsed part of the line, advanced past the field
+ * @return The field with surrounding spaces removed
+ */
+string_view CommandParser::nextField(string_view& rest)
+{
+   size_t pos = rest.find(',');
+   string_view field = rest.substr(0, pos);
+
+   if (pos == string_view::npos)
+      rest = string_view();
+   else
+      rest.remove_prefix(pos + 1);
+   return trim(field);
+}
+
+/** ----------------------------- toNumber(string_view, T&) ---------------
+ * Converts a field made up only of decimal digits (and optional sign) to
+ *   any integer type.
+ * @param field Text to convert
+ * @param value Set to the converted value on success
+ * @return True if the whole field was a valid T, false if not
+ */
+template <class T>
+static bool toNumber(string_view field, T& value)
+{
+   const char* end = field.data() + field.size();
+   T parsed = 0;
+   from_chars_result result = from_chars(field.data(), end, parsed);
+
+   if (field.empty() || result.ec != errc() || result.ptr != end)
+      return false;
+   value = parsed;
+   return true;
+}
+
+/** ----------------------------- toInt(string_view, int&) ---------------
+ * Converts a field made up only of decimal digits (and optional sign).
+ * @param field Text to convert
+ * @param value Set to the converted value on success
+ * @return True if the whole field was a valid int of the type of value,
+ *           false if not
+ */
+bool CommandParser::toInt(string_view field, int& value)
+{
+   return toNumber(field, value);
+}
+
+bool CommandParser::toInt(string_view field, int64_t& value)
+{
+   return toNumber(field, value);
+}
+
+/** ----------------------------- parseItem(...) ------------------------
+ * Parses the fields of a single item into record.
+ * @param fields   Item text beginning with the item symbol
+ * @param record   Overwritten with the parsed fields
+ * @param hasStock True if a stock count follows the symbol (inventory
+ *                   lines), false if not (command lines)
+ * @pre    None
+ * @post   record views into fields; on failure record.symbol is '\0'
+ * @return True if every field was found, false if not
+ */
+bool CommandParser::parseItem(string_view fields, ItemRecord& record, bool hasStock)
+{
+   record = ItemRecord();
+
+   string_view symbol = nextField(fields);
+   if (symbol.size() != 1)
+      return false;
+
+   if (hasStock) {
+      if (!toInt(nextField(fields), record.stock))
+         return false;
+   } else {
+      record.stock = 1;             // Single-item transaction
+   }
+
+   if (!toInt(nextField(fields), record.year))
+      return false;
+
+   record.grade = nextField(fields);
+   string_view description = trim(fields);
+   char separator = symbol[0] == 'M' ? ' ' : ',';  // Coin: "Lincoln Cent"
+   size_t pos = description.find(separator);
+
+   if (pos == string_view::npos)
+      return false;
+
+   record.name = trim(description.substr(0, pos));
+   record.type = trim(description.substr(pos + 1));
+   record.symbol = symbol[0];
+   return true;
+}
+
+/** ----------------------------- parseCommand(...) ---------------------
+ * Parses a line of the transactions file into command.
+ * A customer ID is parsed when the first argument is a number, and an item
+ *   is parsed from whatever follows it.
+ * @param line    Line of the transactions file
+ * @param command Overwritten with the parsed fields
+ * @pre    None
+ * @post   command views into line; action is '\0' if the line is not
+ *           blank but its action symbol is not followed by a comma
+ * @return True if the line had anything to process, false if it was blank
+ */
+bool CommandParser::parseCommand(string_view line, Command& command)
+{
+   command = Command();
+   line = trim(line);
+
+   if (line.empty())
+      return false;
+
+   command.action = line[0];
+   line.remove_prefix(1);
+   if (line.empty())                // Command without arguments
+      return true;
+   if (line[0] != ',') {            // Malformed, reported as unrecognized
+      command.action = '\0';
+      return true;
+   }
+
+   line.remove_prefix(1);
+   command.args = trim(line);
+
+   string_view rest = command.args;
+   if (toInt(nextField(rest), command.customerId) && !rest.empty())
+      parseItem(rest, command.item, false);
+   return true;
+}
@@ -0,0 +1,108 @@
+/** @file CommandParser.h
+ * @author Korosh Moosavi
+ * @date 2026-10-16
+ *
+ * CommandParser class:
+ * Splits inventory and command lines into typed records without copying.
+ * Every string field of a record is a string_view into the parsed line, so
+ *   parsing a line never allocates memory.
+ *
+ * Record formats:
+ * Inventory line - S, 9, 1989, Near Mint, Ken Griffey Jr., Upper Deck
+ *                  symbol, stock, year, grade, description
+ * Command line   - S, 001, S, 1989, Near Mint, Ken Griffey Jr., Upper Deck
+ *                  action, customer ID, then an item without a stock count
+ * Coin descriptions separate name and type with a space ("Lincoln Cent"),
+ *   all other items separate them with a comma.
+ *
+ * Assumptions:
+ * Parsed line outlives every record built from it.
+ * Fields are separated by a comma and optional spaces.
+ */
+#pragma once
+#include <cstdint>
+#include <string_view>
+
+using namespace std;
+
+/** ------------------------ ItemRecord struct --------------------------
+ * Fields identifying a single Collectible, plus its stock count
+ * Stock is 1 for items named in a transaction, since only single-item
+ *   transactions are supported
+ * symbol is '\0' when no item was parsed
+ */
+struct ItemRecord {
+   char symbol = '\0';
+   int stock = 0;
+   int year = 0;
+   string_view grade;
+   string_view name;
+   string_view type;
+};
+
+/** ------------------------ Command struct --------------------------
+ * A single parsed line of the transactions file
+ * action is '\0' when the line is malformed, so no operation is found for it
+ * customerId is -1 when the command does not begin with a customer ID
+ * args holds everything after the action symbol for commands with their own
+ *   argument format
+ * sequence is the position of the command in the transactions file, set by
+ *   the caller, and orders trades made by concurrent workers
+ */
+struct Command {
+   char action = '\0';
+   int64_t customerId = -1;
+   ItemRecord item;
+   string_view args;
+   uint64_t sequence = 0;
+};
+
+class CommandParser {
+public:
+   /** ----------------------------- nextField(string_view&) ---------------
+    * Removes the next comma separated field from the front of rest.
+    * @param rest Unparsed part of the line, advanced past the field
+    * @return The field with surrounding spaces removed
+    */
+   static string_view nextField(string_view& rest);
+
+   /** ----------------------------- trim(string_view) ---------------------
+    * @return Parameter without leading and trailing spaces
+    */
+   static string_view trim(string_view text);
+
+   /** ----------------------------- toInt(string_view, int&) ---------------
+    * Converts a field made up only of decimal digits (and optional sign).
+    * @param field Text to convert
+    * @param value Set to the converted value on success
+    * @return True if the whole field was a valid int of the type of value,
+    *           false if not
+    */
+   static bool toInt(string_view field, int& value);
+   static bool toInt(string_view field, int64_t& value);
+
+   /** ----------------------------- parseItem(...) ------------------------
+    * Parses the fields of a single item into record.
+    * @param fields   Item text beginning with the item symbol
+    * @param record   Overwritten with the parsed fields
+    * @param hasStock True if a stock count follows the symbol (inventory
+    *                   lines), false if not (command lines)
+    * @pre    None
+    * @post   record views into fields; on failure record.symbol is '\0'
+    * @return True if every field was found, false if not
+    */
+   static bool parseItem(string_view fields, ItemRecord& record, bool hasStock);
+
+   /** ----------------------------- parseCommand(...) ---------------------
+    * Parses a line of the transactions file into command.
+    * A customer ID is parsed when the first argument is a number, and an item
+    *   is parsed from whatever follows it.
+    * @param line    Line of the transactions file
+    * @param command Overwritten with the parsed fields
+    * @pre    None
+    * @post   command views into line; action is '\0' if the line is not
+    *           blank but its action symbol is not followed by a comma
+    * @return True if the line had anything to process, false if it was blank
+    */
+   static bool parseCommand(string_view line, Command& command);
+};
@@ -1,90 +1,127 @@
-/** @file Customer.h
- * @author Korosh Moosavi
- * @date 2021-03-12
- *
- * Customer class:
- * Stores data on an individual customer for CustomerStore operations.
- *
- * Assumptions:
- * ID from input file will be a unique 3 digit int
- */
-#pragma once
-#include "Hashable.h"
-#include "Collectible.h"
-#include <vector>
-
-using namespace std;
-
-class Customer : public Hashable {
-private:
-   string name = "NULL_CUSTOMER";
-   int id = 000;
-   vector<Collectible*> transactions;
-   vector<bool> txnTypes; // Buy = 1 vs Sell = 0
-
-public:
-   /** ------------------------------ Default constructor --------------------
-    * Data members are pre-initialized.
-    * @pre  None
-    * @post Customer object created with identifiable default data value.
-    */
-   Customer();
-
-   /** ----------------------------- Parameter constructor -------------------
-    * Data members are pre-initialized.
-    * @param nameIn Name to use when constructed.
-    * @param idIn   ID to use when constructed.
-    * @pre  None
-    * @post Customer object created with identifiable default data value.
-    */
-   Customer(string nameIn, int idIn) : name(nameIn), id(idIn) {};
-
-   /** ------------------------------ Destructor -------------------------------
-   * Transaction pointers are deleted.
-   * @pre  None
-   * @post Data is deallocated for destruction.
-   */
-   virtual ~Customer();
-
-   /** ----------------------------- hash() ---------------------
-    * Uses data members to return a hash value.
-    * @pre    Data members are valid and initialized.
-    * @return A (hopefully) unique int value.
-    */
-   virtual int hash() { return id; };
-
-   /** ----------------------------- addTransaction() ---------------------
-    * Adds an item to the transaction log for this customer.
-    * @param item  Item to be added to the customer's log.
-    * @param isBuy Whether item was bought from or sold to store.
-    * @pre    Data members are valid and initialized.
-    * @return True if item was added successfully (always true).
-    */
-   bool addTransaction(Collectible* item, bool isBuy);
-
-   /** ----------------------------- isLess(Hashable&) ---------------------
-    * Main functionality for less-than operator used in SearchTree
-    * @param  rhs  Other Hashable object being compared to.
-    * @pre    Parameter is a Customer.
-    * @return True if priority of this object is lower than that
-    *           of rhs Hashable, false otherwise.
-    */
-   bool isLess(const Hashable& rhs) const;
-
-   /** ----------------------------- isEqual(Hashable&) ---------------------
-    * Compares two Hashables to see if they are equal.
-    * @param  rhs  Other Hashable object being compared to.
-    * @pre    Parameter is a Customer.
-    * @return True if this and rhs have equal data members (except for stock).
-    */
-   bool isEqual(const Hashable& rhs) const;
-
-   /** ----------------------------- print(ostream&) ---------------------
-    * Main functionality of output operator<<
-    * Outputs customer name, ID, and transaction log details
-    * @param  output Ostream object passed from operator<< overload in Hashable
-    * @pre    Data members are valid and initialized.
-    * @post   Information on this object is output.
-    */
-   void print(ostream& output) const;
+/** @file Customer.h
+ * @author Korosh Moosavi
+ * @date 2021-03-12
+ *
+ * Customer class:
+ * Stores data on an individual customer for CustomerStore operations.
+ * Transactions are kept in the store-wide TransactionLog, the customer only
+ *   keeps the positions of its own entries.
+ *
+ * Assumptions:
+ * ID from input file will be a unique, non-negative 64-bit int, printed
+ *   with at least 3 digits
+ */
+#pragma once
+#include "Hashable.h"
+#include "Collectible.h"
+#include "TransactionLog.h"
+#include <vector>
+
+using namespace std;
+
+class Customer : public Hashable {
+private:
+   string name = "NULL_CUSTOMER";
+   int64_t id = 0;
+   const TransactionLog* log = nullptr;
+   vector<uint64_t> entries;   // Positions in log, oldest first
+
+   /** ----------------------------- buildSortKey() ---------------------
+    * Packs the sorting fields into sortKey, called by every constructor.
+    */
+   void buildSortKey() { sortKey.append(name).append(id); };
+
+public:
+   /** ------------------------------ Default constructor --------------------
+    * Data members are pre-initialized.
+    * @pre  None
+    * @post Customer object created with identifiable default data value.
+    */
+   Customer();
+
+   /** ----------------------------- Parameter constructor -------------------
+    * Data members are pre-initialized.
+    * @param nameIn Name to use when constructed.
+    * @param idIn   ID to use when constructed.
+    * @pre  None
+    * @post Customer object created with identifiable default data value.
+    */
+   Customer(string nameIn, int64_t idIn) : name(nameIn), id(idIn) { buildSortKey(); };
+
+   /** ------------------------------ Destructor -------------------------------
+   * No special operations needed, log entries belong to the TransactionLog.
+   * @pre  None
+   * @post Data is deallocated for destruction.
+   */
+   virtual ~Customer();
+
+   /** ----------------------------- hash() ---------------------
+    * Uses data members to return a hash value.
+    * @pre    Data members are valid and initialized.
+    * @return A (hopefully) unique int value.
+    */
+   virtual int hash() { return (int)(id ^ (id >> 32)); };
+
+   /** ----------------------------- getId() ---------------------
+    * @return ID of this customer.
+    */
+   int64_t getId() const { return id; };
+
+   /** ----------------------------- getName() ---------------------
+    * @return Name of this customer.
+    */
+   const string& getName() const { return name; };
+
+   /** ----------------------------- getEntries() ---------------------
+    * @return Positions of this customer's trades in the store-wide log,
+    *           oldest first.
+    */
+   const vector<uint64_t>& getEntries() const { return entries; };
+
+   /** ----------------------------- reserveTransactions(size_t) -------------
+    * Makes room for a known number of entries, such as when restoring a
+    *   saved history.
+    * @param count Number of entries the history will hold
+    */
+   void reserveTransactions(size_t count) { entries.reserve(count); };
+
+   /** ----------------------------- setLog(TransactionLog*) ---------------
+    * Sets the store-wide log this customer's entries are kept in.
+    * @param storeLog Log owned by the CustomerRegistry holding this customer
+    */
+   void setLog(const TransactionLog* storeLog) { log = storeLog; };
+
+   /** ----------------------------- addTransaction(size_t) ------------------
+    * Adds an entry of the store-wide log to this customer's history.
+    * @param entry  Position returned by TransactionLog::append().
+    * @pre    setLog() was called with the log holding entry.
+    * @return True if entry was added successfully (always true).
+    */
+   bool addTransaction(size_t entry);
+
+   /** ----------------------------- isLess(Hashable&) ---------------------
+    * Main functionality for less-than operator used in SearchTree
+    * @param  rhs  Other Hashable object being compared to.
+    * @pre    Parameter is a Customer.
+    * @return True if priority of this object is lower than that
+    *           of rhs Hashable, false otherwise.
+    */
+   bool isLess(const Hashable& rhs) const;
+
+   /** ----------------------------- isEqual(Hashable&) ---------------------
+    * Compares two Hashables to see if they are equal.
+    * @param  rhs  Other Hashable object being compared to.
+    * @pre    Parameter is a Customer.
+    * @return True if this and rhs have equal data members (except for stock).
+    */
+   bool isEqual(const Hashable& rhs) const;
+
+   /** ----------------------------- print(ostream&) ---------------------
+    * Main functionality of output operator<<
+    * Outputs customer name, ID, and transaction log details
+    * @param  output Ostream object passed from operator<< overload in Hashable
+    * @pre    Data members are valid and initialized.
+    * @post   Information on this object is output.
+    */
+   void print(ostream& output) const;
 };
\ No newline at end of file
@@ -0,0 +1,188 @@
+/** @file CustomerIndex.cpp
+ * @author Korosh Moosavi
+ * @date 2026-10-16
+ *
+ * CustomerIndex class:
+ * Open-addressing hash table mapping 64-bit customer IDs to the Customer
+ *   objects held by CustomerRegistry, resized incrementally.
+ *
+ * Assumptions:
+ * Indexed customers are owned elsewhere and outlive this index.
+ * Customer IDs are not negative.
+ */
+#include "CustomerIndex.h"
+
+/** ------------------------------ Constructor ----------------------
+ * Allocates an empty table of INITIAL_CAPACITY slots.
+ */
+CustomerIndex::CustomerIndex()
+   : capacity(INITIAL_CAPACITY), count(0), oldTable(nullptr), oldCapacity(0), migrated(0)
+{
+   table = new Slot[capacity]();
+}
+
+/** ------------------------------ Destructor -------------------------------
+ * Frees the tables only, indexed customers are owned elsewhere.
+ */
+CustomerIndex::~CustomerIndex()
+{
+   delete[] table;
+   delete[] oldTable;
+}
+
+/** ----------------------------- hashId(int64_t) ---------------------
+ * Uses the splitmix64 finalizer.
+ * @return Well mixed 64-bit hash of a customer ID, since IDs are often
+ *           sequential.
+ */
+uint64_t CustomerIndex::hashId(int64_t id)
+{
+   uint64_t hashVal = (uint64_t)id;
+
+   hashVal = (hashVal ^ (hashVal >> 30)) * 0xbf58476d1ce4e5b9ULL;
+   hashVal = (hashVal ^ (hashVal >> 27)) * 0x94d049bb133111ebULL;
+   return hashVal ^ (hashVal >> 31);
+}
+
+/** ----------------------------- locate(Slot*, size_t, int64_t) -----------
+ * Follows the probe sequence of an ID in a table.
+ * @return The slot holding id, or the empty slot where it belongs
+ */
+CustomerIndex::Slot* CustomerIndex::locate(Slot* slots, size_t size, int64_t id)
+{
+   size_t mask = size - 1;
+
+   for (size_t pos = hashId(id) & mask; ; pos = (pos + 1) & mask) {
+      if (slots[pos].customer == nullptr || slots[pos].id == id)
+         return &slots[pos];
+   }
+}
+
+/** ------------------------ startResize() --------------------------
+ * Finishes any resize in progress, then allocates a table of twice the
+ *   capacity and makes the current table the one being emptied.
+ */
+void CustomerIndex::startResize()
+{
+   if (oldTable != nullptr)
+      migrate(oldCapacity);
+
+   oldTable = table;
+   oldCapacity = capacity;
+   migrated = 0;
+   capacity *= 2;
+   table = new Slot[capacity]();
+   resizes++;
+}
+
+/** ------------------------ migrate(size_t) --------------------------
+ * Copies up to steps slots of the old table into the current one, and
+ *   frees the old table once every slot has been copied.
+ * A copied slot is left in the old table: lookups check the current table
+ *   first, so they find the copy.
+ * @param steps Number of old slots to visit
+ */
+void CustomerIndex::migrate(size_t steps)
+{
+   for (; steps > 0 && migrated < oldCapacity; steps--, migrated++) {
+      const Slot& entry = oldTable[migrated];
+      if (entry.customer != nullptr) {
+         Slot* slot = locate(table, capacity, entry.id);
+         if (slot->customer == nullptr)     // Not replaced since the resize
+            *slot = entry;
+      }
+   }
+
+   if (migrated == oldCapacity) {
+      delete[] oldTable;
+      oldTable = nullptr;
+      oldCapacity = 0;
+   }
+}
+
+/** ----------------------------- insert(Customer*) ---------------------
+ * Adds a customer under its ID, replacing any customer with that ID.
+ * Moves MIGRATE_STEP slots of a resize in progress. With a load limit of
+ *   70% and doubling, a resize is always finished long before the next.
+ * @param customer Customer to index, not nullptr
+ * @post   customer is found by its ID
+ * @return The customer it replaced, nullptr if the ID was new
+ */
+Customer* CustomerIndex::insert(Customer* customer)
+{
+   int64_t id = customer->getId();
+   Slot* slot = locate(table, capacity, id);
+   Customer* replaced = slot->customer;
+
+   if (replaced == nullptr && oldTable != nullptr) {
+      Slot* old = locate(oldTable, oldCapacity, id);
+      if (old->customer != nullptr && old >= oldTable + migrated) {
+         replaced = old->customer;             // Not copied yet, replace the
+         old->customer = customer;             //   original so the copy is
+         return replaced;                      //   the new customer
+      }
+   }
+
+   if (replaced != nullptr) {                  // Replace in place
+      slot->customer = customer;
+      return replaced;
+   }
+
+   if ((count + 1) * 100 > capacity * MAX_LOAD_PERCENT) {
+      startResize();
+      slot = locate(table, capacity, id);
+   }
+   slot->id = id;
+   slot->customer = customer;
+   count++;
+
+   if (oldTable != nullptr)
+      migrate(MIGRATE_STEP);
+   return nullptr;
+}
+
+/** ----------------------------- reserve(size_t) ---------------------
+ * Grows an empty table ahead of time so expected customers can be
+ *   inserted without resizing.
+ * @param expected Number of customers the table should hold
+ */
+void CustomerIndex::reserve(size_t expected)
+{
+   if (count != 0)
+      return;
+
+   size_t needed = capacity;
+   while (expected * 100 > needed * MAX_LOAD_PERCENT)
+      needed *= 2;
+   if (needed != capacity) {
+      delete[] table;
+      capacity = needed;
+      table = new Slot[capacity]();
+   }
+}
+
+/** ----------------------------- find(int64_t) ---------------------
+ * @param id Customer ID to search for
+ * @return The customer with that ID, nullptr if not found
+ */
+Customer* CustomerIndex::find(int64_t id) const
+{
+   Customer* found = locate(table, capacity, id)->customer;
+
+   if (found == nullptr && oldTable != nullptr)
+      found = locate(oldTable, oldCapacity, id)->customer;
+   return found;
+}
+
+/** ----------------------------- outputStats(ostream&) ---------------------
+ * Outputs size, capacity, load factor and number of resizes.
+ * @param output Stream to write the statistics to
+ * @pre    None
+ * @post   Statistics are output on a single line
+ */
+void CustomerIndex::outputStats(ostream& output) const
+{
+   output << "Customer index: " << count << " customers, capacity " << capacity
+      << ", load factor " << (double)count / capacity << ", " << resizes
+      << " resizes" << (oldTable != nullptr ? ", resize in progress" : "") << endl;
+}
@@ -0,0 +1,123 @@
+/** @file CustomerIndex.h
+ * @author Korosh Moosavi
+ * @date 2026-10-16
+ *
+ * CustomerIndex class:
+ * Open-addressing hash table mapping 64-bit customer IDs to the Customer
+ *   objects held by CustomerRegistry.
+ * Collisions are resolved with linear probing over a power of 2 capacity,
+ *   and each slot keeps the ID next to the pointer, so a lookup usually
+ *   touches a single cache line.
+ * The table grows incrementally: when it gets too full a table of twice the
+ *   size is allocated, and every later insert moves a few slots of the old
+ *   table into the new one. No single insert pays for rehashing the whole
+ *   table, so registering customers never stalls a Buy or Sell for long.
+ *   Lookups check the new table, then the old one until every slot moved.
+ *
+ * Assumptions:
+ * Indexed customers are owned elsewhere and outlive this index.
+ * Customer IDs are not negative.
+ */
+#pragma once
+#include "Customer.h"
+#include <cstdint>
+
+class CustomerIndex {
+private:
+   /** ------------------------ Slot struct --------------------------
+    * Entry of the table, customer is nullptr when the slot is unoccupied
+    */
+   struct Slot {
+      int64_t id;
+      Customer* customer;
+   };
+
+   static const size_t INITIAL_CAPACITY = 64;   // Must be a power of 2
+   static const int MAX_LOAD_PERCENT = 70;      // Grow past this load factor
+   static const size_t MIGRATE_STEP = 32;       // Old slots moved per insert
+
+   Slot* table;
+   size_t capacity;
+   size_t count;
+
+   // Table being emptied into table, nullptr when no resize is in progress.
+   //   Slots before migrated have already been copied.
+   Slot* oldTable;
+   size_t oldCapacity;
+   size_t migrated;
+
+   uint64_t resizes = 0;
+
+   /** ----------------------------- hashId(int64_t) ---------------------
+    * @return Well mixed 64-bit hash of a customer ID, since IDs are often
+    *           sequential.
+    */
+   static uint64_t hashId(int64_t id);
+
+   /** ----------------------------- locate(Slot*, size_t, int64_t) -----------
+    * Follows the probe sequence of an ID in a table.
+    * @return The slot holding id, or the empty slot where it belongs
+    */
+   static Slot* locate(Slot* slots, size_t size, int64_t id);
+
+   /** ------------------------ startResize() --------------------------
+    * Finishes any resize in progress, then allocates a table of twice the
+    *   capacity and makes the current table the one being emptied.
+    */
+   void startResize();
+
+   /** ------------------------ migrate(size_t) --------------------------
+    * Copies up to steps slots of the old table into the current one, and
+    *   frees the old table once every slot has been copied.
+    * @param steps Number of old slots to visit
+    */
+   void migrate(size_t steps);
+
+public:
+   /** ------------------------------ Constructor ----------------------
+    * Allocates an empty table of INITIAL_CAPACITY slots.
+    */
+   CustomerIndex();
+
+   /** ------------------------------ Destructor -------------------------------
+    * Frees the tables only, indexed customers are owned elsewhere.
+    */
+   ~CustomerIndex();
+
+   CustomerIndex(const CustomerIndex&) = delete;
+   CustomerIndex& operator=(const CustomerIndex&) = delete;
+
+   /** ----------------------------- insert(Customer*) ---------------------
+    * Adds a customer under its ID, replacing any customer with that ID.
+    * @param customer Customer to index, not nullptr
+    * @post   customer is found by its ID
+    * @return The customer it replaced, nullptr if the ID was new
+    */
+   Customer* insert(Customer* customer);
+
+   /** ----------------------------- reserve(size_t) ---------------------
+    * Grows an empty table ahead of time so expected customers can be
+    *   inserted without resizing.
+    * @param expected Number of customers the table should hold
+    */
+   void reserve(size_t expected);
+
+   /** ----------------------------- find(int64_t) ---------------------
+    * @param id Customer ID to search for
+    * @return The customer with that ID, nullptr if not found
+    */
+   Customer* find(int64_t id) const;
+
+   /** ----------------------------- size() ---------------------
+    * @return Number of customers indexed.
+    */
+   size_t size() const { return count; };
+
+   /** ----------------------------- outputStats(ostream&) ---------------------
+    * Outputs size, capacity, load factor and number of resizes.
+    * @param output Stream to write the statistics to
+    * @pre    None
+    * @post   Statistics are output on a single line
+    */
+   void outputStats(ostream& output) const;
+};
@@ -1,120 +1,516 @@
-/** @file CustomerRegistry.cpp
- * @author Korosh Moosavi
- * @date 2021-03-12
- *
- * CustomerRegistry class:
- * Used to manage registered customers and their interactions with the store
- *   and its inventory.
- *
- * Assumptions:
- * Only Customer objects and its subclasses will be hashed.
- * Input file includes IDs as 3-digit numbers with leading 0s if necessary.
- * Name will be saved and sorted as-is, including any extra spaces or characters.
- */
-#include "CustomerRegistry.h"
-
-/** ------------------------------ Constructor ----------------------
- * Parses input file to create Customer objects and insert their pointers into
- *   both the SearchTree 'customers' and hash table 'registry'
- * @param fileName Name of the input file containing data on store Customers.
- * @pre  Pre-formatted and pre-determined file is in the same directory.
- * @post Only one instance of each Customer is create with pointers in both data
- *         members of this object.
- */
-CustomerRegistry::CustomerRegistry(string fileName)
-{
-   customers = new SearchTree;
-   int size = sizeof(registry) / sizeof(*registry);
-   ifstream input(fileName);
-   
-   for (int i = 0; i < size; i++)
-      registry[i] = nullptr;
-
-   while (input.peek() != EOF) {
-      string fileInput;
-      getline(input, fileInput);
-      int id = stoi(fileInput.substr(0, 4));
-      
-      if (id > size - 1 || id < 0) {
-         cerr << "Invalid customer ID entered.\n" << endl;
-         continue;
-      }
-      
-      Customer* temp = new Customer(fileInput.substr(5), id);
-      registry[temp->hash()] = temp;
-      (*customers).insert(temp);
-   }
-}
-
-/** ------------------------------ Destructor -------------------------------
- * SearchTree destructor is used to free memory.
- * @pre  None
- * @post Data is deallocated for destruction.
- */
-CustomerRegistry::~CustomerRegistry()
-{
-   delete customers;
-   customers = nullptr;
-}
-
-/** --------------------- updateLog(Collectible*, int, bool) -----------------
-* Adds parameter item to transaction vector in Customer object corresponding
-*   to the parameter id.
-* Adds bool value to txnType vector indicating whether the store bought from
-*   or sold to the customer.
-* @param item  Collectible object to add to Customer's transaction log.
-* @param id    Customer ID whose log to add this item to.
-* @param isBuy Whether the transaction is a buy or sell
-* @pre        Customer and item both exist in their respective tables.
-*             Calling method calls Inventory.updateInventory(item, -1) first
-*               to ensure there is enough stock.
-* @post       Item has been added to the transaction log of the Customer.
-*             Transaction type (buy/sell) has also been recorded in Customer.
-* @return     Returns true on successful execution, false on failure.
-*/
-bool CustomerRegistry::updateLog(Collectible* item, int id, bool isBuy)
-{
-   if (id > sizeof(registry) / sizeof(*registry) - 1 || registry[id] == nullptr) {
-      cerr << "Invalid customer ID entered.\n" << endl;
-      return false;
-   }
-   return registry[id]->addTransaction(item, isBuy);
-}
-
-/** ----------------------------- outputLog(int) ---------------------
- * Finds Customer object with given ID and outputs items stored in its
- *   transactions vector as well as whether it was bought or sold.
- * In this implementation all customer transactions will be
- *   of quantity 1.
- * @param id Desired customer to print transaction log for.
- * @pre      Customer with given ID exists and is initialized.
- * @post     Items stored in transactions vector are output.
- * @return   True if desired Customer was found, false if not.
- */
-bool CustomerRegistry::outputLog(int id)
-{
-   if (registry[id] != nullptr) {
-      cout << *registry[id] << endl;
-      cout << endl;
-      return true;
-   }
-   cerr << "Unrecognized customer ID entered.\n" << endl;
-   return false;
-}
-
-/** ----------------------------- outputAll() ---------------------
- * Calls the customers SearchTree's output operator to in-order traverse
- *   through each Customer and call their output operators.
- * @pre      None, tree will indicate if it is empty.
- * @post     Items stored in transactions vector of each customer
- *             are output, customers are listed in alphabetical order.
- * @return   True if all Customers were output, false if there is no tree.
- */
-bool CustomerRegistry::outputAll()
-{
-   if (customers != nullptr) {
-      cout << *customers << endl;
-      return true;
-   }
-   return false;
-}
+/** @file CustomerRegistry.cpp
+ * @author Korosh Moosavi
+ * @date 2021-03-12
+ *
+ * CustomerRegistry class:
+ * Used to manage registered customers and their interactions with the store
+ *   and its inventory.
+ * Customers are allocated in Arenas owned by the registry, and released
+ *   together when it is destroyed.
+ * Customers are looked up by ID through a CustomerIndex, which grows with
+ *   the number of customers, and new customers can be registered while
+ *   transactions are processed.
+ * Histories can be paged through, resuming at a customer ID.
+ * Customers can be found by name through a NameIndex.
+ *
+ * Assumptions:
+ * Only Customer objects and its subclasses will be hashed.
+ * Input file includes IDs as non-negative 64-bit numbers, written with at
+ *   least 3 digits using leading 0s if necessary.
+ * Name will be saved and sorted as-is, including any extra spaces or characters.
+ */
+#include "CustomerRegistry.h"
+#include <iomanip>
+
+// Bytes of a log entry in a Snapshot: sequence, item ID, quantity, direction
+static const size_t SAVED_RECORD_BYTES = sizeof(uint64_t) + sizeof(uint32_t) +
+                                         sizeof(uint16_t) + sizeof(uint8_t);
+
+// Fewest bytes of a customer in a Snapshot: ID, flags, name length, entries
+static const size_t SAVED_CUSTOMER_BYTES = sizeof(int64_t) + sizeof(uint8_t) +
+                                           sizeof(uint32_t) + sizeof(uint64_t);
+
+/** ------------------------------ Constructor ----------------------
+ * Parses input file to create Customer objects and insert their pointers into
+ *   both the SearchTree 'customers' and hash table 'registry'
+ * The file is memory mapped and each line is parsed in place, so only the
+ *   customer name is copied.
+ * @param fileName Name of the input file containing data on store Customers.
+ * @pre  Pre-formatted and pre-determined file is in the same directory.
+ * @post Only one instance of each Customer is create with pointers in both data
+ *         members of this object.
+ */
+CustomerRegistry::CustomerRegistry(string fileName)
+{
+   customers = new SearchTree(false);
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   MappedFile input(fileName);
+   string_view unread = input.contents();
+   
+   customerArenas.push_back(new Arena);
+
+   while (!unread.empty()) {
+      string_view fileInput = MappedFile::nextLine(unread);
+      if (fileInput.empty())
+         continue;
+
+      loadStats.records++;
+      Customer* temp = parseCustomer(fileInput, *customerArenas[0]);
+      if (temp != nullptr)
+         add(temp);
+   }
+   names.build(*customers);
+
+   loadStats.bytes = input.size();
+   loadStats.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+/** ------------------------------ Parallel constructor ----------------------
+ * Builds the same registry as CustomerRegistry(string) using a ThreadPool.
+ * The file is split into chunks that are parsed concurrently, then the
+ *   Customers are inserted in file order so the result does not depend
+ *   on timing.
+ * @param fileName Name of the input file containing data on store Customers.
+ * @param pool     Workers to parse with.
+ * @pre  Pre-formatted and pre-determined file is in the same directory.
+ *       Not called from a task running on pool.
+ * @post Only one instance of each Customer is create with pointers in both data
+ *         members of this object.
+ */
+CustomerRegistry::CustomerRegistry(string fileName, ThreadPool& pool)
+{
+   customers = new SearchTree(false);
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   MappedFile input(fileName);
+   vector<string_view> chunks = MappedFile::splitLines(input.contents(), pool.size() * 4);
+   vector<vector<Customer*>> parsed(chunks.size());
+   vector<uint64_t> records(chunks.size(), 0);
+
+   for (size_t chunk = 0; chunk < chunks.size(); chunk++)
+      customerArenas.push_back(new Arena);        // One per chunk, no locking
+
+   pool.parallelFor(chunks.size(), [&](size_t chunk) {         // Parse chunks
+      string_view unread = chunks[chunk];
+
+      while (!unread.empty()) {
+         string_view fileInput = MappedFile::nextLine(unread);
+         if (fileInput.empty())
+            continue;
+
+         records[chunk]++;
+         Customer* temp = parseCustomer(fileInput, *customerArenas[chunk]);
+         if (temp != nullptr)
+            parsed[chunk].push_back(temp);
+      }
+   });
+
+   size_t total = 0;
+   for (const vector<Customer*>& chunk : parsed)
+      total += chunk.size();
+   registry.reserve(total);
+
+   for (size_t chunk = 0; chunk < chunks.size(); chunk++) {    // Insert in order
+      loadStats.records += records[chunk];
+      for (Customer* temp : parsed[chunk])
+         add(temp);
+   }
+   names.build(*customers);
+
+   loadStats.bytes = input.size();
+   loadStats.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+/** ------------------------------ Snapshot constructor ----------------------
+ * Rebuilds a registry saved by save(Snapshot&), with every customer, the
+ *   whole TransactionLog and each customer's history. The SearchTree is
+ *   built directly from its saved order, so no customer is compared.
+ * @param snapshot  Snapshot being read, positioned where save() started.
+ * @param inventory Inventory restored from the same snapshot, holding the
+ *                    logged items.
+ * @pre  None
+ * @post Every saved customer and trade is restored, unless snapshot turns
+ *         out to be invalid, in which case the registry should be discarded.
+ */
+CustomerRegistry::CustomerRegistry(Snapshot& snapshot, const Inventory& inventory)
+{
+   customers = new SearchTree(false);
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   size_t first = snapshot.position();
+
+   customerArenas.push_back(new Arena);
+
+   uint64_t entries = snapshot.get<uint64_t>();
+   if (snapshot.fits(entries, SAVED_RECORD_BYTES))
+      log.reserve(entries);
+   for (uint64_t i = 0; i < entries && snapshot.isValid(); i++) {
+      uint64_t sequence = snapshot.get<uint64_t>();
+      const Collectible* item = inventory.getItem(snapshot.get<uint32_t>());
+      uint16_t quantity = snapshot.get<uint16_t>();
+      bool isBuy = snapshot.get<uint8_t>() != 0;
+
+      if (item == nullptr
+          || log.append(*item, quantity, isBuy, sequence) == TransactionLog::FULL) {
+         snapshot.invalidate();
+         break;
+      }
+   }
+
+   uint64_t count = snapshot.get<uint64_t>();
+   vector<Hashable*> sorted;
+   if (snapshot.fits(count, SAVED_CUSTOMER_BYTES)) {
+      registry.reserve(count);
+      sorted.reserve(count);
+   }
+   for (uint64_t i = 0; i < count && snapshot.isValid(); i++) {
+      int64_t id = snapshot.get<int64_t>();
+      uint8_t flags = snapshot.get<uint8_t>();
+      string_view name = snapshot.getString();
+      uint64_t trades = snapshot.get<uint64_t>();
+
+      if (id < 0 || !snapshot.fits(trades, sizeof(uint64_t))) {
+         snapshot.invalidate();
+         break;
+      }
+      Customer* temp = customerArenas[0]->create<Customer>(string(name), id);
+      temp->setLog(&log);
+      temp->reserveTransactions(trades);
+      for (uint64_t trade = 0; trade < trades; trade++) {
+         uint64_t entry = snapshot.get<uint64_t>();
+         if (entry >= log.size()) {
+            snapshot.invalidate();
+            break;
+         }
+         temp->addTransaction(entry);
+      }
+
+      if (flags & SAVED_INDEXED)
+         registry.insert(temp);
+      if (flags & SAVED_IN_TREE)
+         sorted.push_back(temp);
+   }
+   customers->build(sorted);
+   names.build(*customers);
+
+   loadStats.records = count;
+   loadStats.bytes = snapshot.position() - first;
+   loadStats.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+/** ----------------------------- parseCustomer(string_view, Arena&) -------
+ * Creates a Customer from a line of the customer file.
+ * @param fileInput Line formatted as "001, Michael Jordan"
+ * @param arena     Arena to create the Customer in
+ * @return New Customer, nullptr if the ID is malformed or negative
+ */
+Customer* CustomerRegistry::parseCustomer(string_view fileInput, Arena& arena) const
+{
+   size_t comma = fileInput.find(',');
+   int64_t id = -1;
+
+   if (comma == string_view::npos || comma + 2 > fileInput.size() ||
+       !CommandParser::toInt(fileInput.substr(0, comma), id) || id < 0) {
+      cerr << "Invalid customer ID entered.\n\n";
+      return nullptr;
+   }
+   return arena.create<Customer>(string(fileInput.substr(comma + 2)), id);
+}
+
+/** ----------------------------- add(Customer*) ---------------------
+ * Inserts a Customer into both the hash table and the SearchTree.
+ * @param temp Customer created in one of customerArenas
+ */
+void CustomerRegistry::add(Customer* temp)
+{
+   temp->setLog(&log);
+   registry.insert(temp);           // A later customer with the same ID wins
+   (*customers).insert(temp);
+}
+
+/** ------------------------------ Destructor -------------------------------
+ * The SearchTree is deleted, then every Customer is released with its Arena.
+ * @pre  None
+ * @post Data is deallocated for destruction.
+ */
+CustomerRegistry::~CustomerRegistry()
+{
+   delete customers;
+   customers = nullptr;
+   for (Arena* arena : customerArenas)
+      delete arena;
+   customerArenas.clear();
+}
+
+/** ----------------------------- outputMemoryStats(ostream&) --------------
+ * Outputs bytes used and reserved by the Arenas of tree nodes and customers.
+ * @param output Stream to write the statistics to.
+ * @pre      None.
+ * @post     Statistics are output on a single line.
+ */
+void CustomerRegistry::outputMemoryStats(ostream& output) const
+{
+   size_t customersUsed = 0, customersReserved = 0;
+
+   for (const Arena* arena : customerArenas) {
+      customersUsed += arena->bytesUsed();
+      customersReserved += arena->bytesReserved();
+   }
+   output << "Customer memory: nodes " << customers->getNodeArena().bytesUsed()
+      << " bytes (" << customers->getNodeArena().bytesReserved()
+      << " reserved), customers " << customersUsed << " bytes ("
+      << customersReserved << " reserved)" << endl;
+}
+
+/** --------------------- registerCustomer(int64_t, string_view) ------------
+* Adds a new customer while the store is running.
+* The customer is created in the newest Arena, transactions are processed
+*   by a single thread at a time.
+* @param id   ID of the new customer.
+* @param name Name of the new customer.
+* @pre        None.
+* @post       The customer can trade, is listed by outputAll() and
+*               outputNamed(), and is added to the Journal if one is set.
+* @return     True if the customer was added, false if the ID is negative,
+*               already registered, or the name is empty.
+*/
+bool CustomerRegistry::registerCustomer(int64_t id, string_view name)
+{
+   if (id < 0 || name.empty()) {
+      cerr << "Invalid customer entered.\n\n";
+      return false;
+   }
+   if (registry.find(id) != nullptr) {
+      cerr << "Customer ID already registered.\n\n";
+      return false;
+   }
+   Customer* temp = customerArenas.back()->create<Customer>(string(name), id);
+   add(temp);
+   names.insert(temp);
+   if (journal != nullptr)
+      journal->logRegistration(id, name);
+   return true;
+}
+
+/** --------------------- updateLog(Collectible&, int64_t, bool, uint64_t) ---
+* Appends a single-item trade of parameter item to the store-wide
+*   TransactionLog and adds the entry to the Customer corresponding to the
+*   parameter id.
+* Several threads may call this at once. Inside a batch the entry is only
+*   added to the Customer by commitBatch().
+* @param item     Inventory item traded, referred to by its item ID.
+* @param id       Customer ID whose log to add this item to.
+* @param isBuy    Whether the transaction is a buy or sell
+* @param sequence Position of the trading command in the transactions file
+* @pre        Customer and item both exist in their respective tables.
+*             Calling method calls Inventory.updateInventory(item, -1) first
+*               to ensure there is enough stock.
+* @post       Trade has been added to the transaction log of the Customer,
+*               including whether it was a buy or sell, and to the
+*               Journal if one is set.
+* @return     Returns true on successful execution, false on failure.
+*/
+bool CustomerRegistry::updateLog(const Collectible& item, int64_t id, bool isBuy,
+                                 uint64_t sequence)
+{
+   Customer* customer = registry.find(id);
+
+   if (customer == nullptr) {
+      cerr << "Invalid customer ID entered.\n\n";
+      return false;
+   }
+   size_t entry = log.append(item, 1, isBuy, sequence);
+   if (entry == TransactionLog::FULL)
+      return false;
+   if (journal != nullptr)
+      journal->logTrade(sequence, id, item.getItemId(), isBuy);
+
+   if (batching) {                     // Each command has its own slot
+      batch[sequence - batchStart] = { customer, entry };
+      return true;
+   }
+   lock_guard<mutex> guard(historyLocks[id % HISTORY_LOCKS]);
+   return customer->addTransaction(entry);
+}
+
+/** --------------------- beginBatch(uint64_t, size_t) ----------------------
+* Starts a batch of commands whose trades are logged concurrently.
+* @param firstSequence Sequence of the first command in the batch.
+* @param commands      Number of commands in the batch, whose sequences
+*                        follow firstSequence without gaps.
+* @pre        No batch is open, and no customer is registered or output
+*               until endBatch().
+* @post       updateLog() defers adding entries to customers.
+*/
+void CustomerRegistry::beginBatch(uint64_t firstSequence, size_t commands)
+{
+   batch.assign(commands, { nullptr, 0 });
+   batchStart = firstSequence;
+   batching = true;
+}
+
+/** --------------------- commitBatch(int, int) -----------------------------
+* Adds the trades logged in the open batch to their customers, in the
+*   order of the transactions file.
+* Only customers whose ID falls in the given shard are updated, so each
+*   shard can be committed by its own thread.
+* @param shard  Shard to commit, 0 to shards - 1.
+* @param shards Number of shards the customers are split into.
+* @pre        Every updateLog() call of the batch has returned.
+*/
+void CustomerRegistry::commitBatch(int shard, int shards)
+{
+   for (const PendingTrade& trade : batch) {
+      if (trade.customer != nullptr && trade.customer->getId() % shards == shard)
+         trade.customer->addTransaction(trade.entry);
+   }
+}
+
+/** ----------------------------- save(Snapshot&) ---------------------
+ * Adds the TransactionLog and every customer with its history to a
+ *   snapshot being written, after the Inventory the log refers to.
+ * Customers are saved in tree order, so they are restored without sorting.
+ *   A customer whose ID was given again with the same name is only in the
+ *   index, see add(Customer*), and is saved after the others.
+ * @param snapshot Snapshot being written.
+ * @pre      No batch is open and no transaction is being processed.
+ * @post     The registry can be rebuilt by the Snapshot constructor.
+ */
+void CustomerRegistry::save(Snapshot& snapshot) const
+{
+   snapshot.put((uint64_t)log.size());
+   for (size_t entry = 0; entry < log.size(); entry++) {
+      const LogRecord& record = log.getRecord(entry);
+      snapshot.put(record.sequence);
+      snapshot.put(record.itemId);
+      snapshot.put(record.quantity);
+      snapshot.put((uint8_t)record.isBuy);
+   }
+
+   vector<Hashable*> sorted;
+   vector<const Customer*> indexOnly;
+   customers->collect(sorted);
+   for (const Hashable* listed : sorted) {
+      const Customer* customer = static_cast<const Customer*>(listed);
+      const Customer* found = registry.find(customer->getId());
+      if (found != nullptr && found != customer && found->isEqual(*customer))
+         indexOnly.push_back(found);
+   }
+
+   snapshot.put((uint64_t)(sorted.size() + indexOnly.size()));
+   for (size_t i = 0; i < sorted.size() + indexOnly.size(); i++) {
+      bool listed = i < sorted.size();
+      const Customer* customer = listed ? static_cast<const Customer*>(sorted[i])
+                                        : indexOnly[i - sorted.size()];
+      uint8_t flags = listed ? SAVED_IN_TREE : 0;
+      if (registry.find(customer->getId()) == customer)
+         flags |= SAVED_INDEXED;
+
+      snapshot.put(customer->getId());
+      snapshot.put(flags);
+      snapshot.putString(customer->getName());
+      snapshot.put((uint64_t)customer->getEntries().size());
+      for (uint64_t entry : customer->getEntries())
+         snapshot.put(entry);
+   }
+}
+
+/** ----------------------------- outputLog(int64_t, ostream&) -----------------
+ * Finds Customer object with given ID and outputs items stored in its
+ *   transactions vector as well as whether it was bought or sold.
+ * In this implementation all customer transactions will be
+ *   of quantity 1.
+ * @param id     Desired customer to print transaction log for.
+ * @param output Stream to write the log to.
+ * @pre      Customer with given ID exists and is initialized.
+ * @post     Items stored in transactions vector are output.
+ * @return   True if desired Customer was found, false if not.
+ */
+bool CustomerRegistry::outputLog(int64_t id, ostream& output)
+{
+   Customer* customer = registry.find(id);
+
+   if (customer != nullptr) {
+      output << *customer << '\n';
+      output << '\n';
+      return true;
+   }
+   cerr << "Unrecognized customer ID entered.\n\n";
+   return false;
+}
+
+/** ----------------------------- outputAll(ostream&) ---------------------
+ * Calls the customers SearchTree's output operator to in-order traverse
+ *   through each Customer and call their output operators.
+ * @param output Stream to write the logs to.
+ * @pre      None, tree will indicate if it is empty.
+ * @post     Items stored in transactions vector of each customer
+ *             are output, customers are listed in alphabetical order.
+ * @return   True if all Customers were output, false if there is no tree.
+ */
+bool CustomerRegistry::outputAll(ostream& output)
+{
+   if (customers != nullptr) {
+      output << *customers << '\n';
+      return true;
+   }
+   return false;
+}
+
+/** ----------------------------- outputPage(int64_t&, size_t, ostream&) ---
+* Outputs the histories of a page of customers in alphabetical order,
+*   starting at a customer and walking the SearchTree from there with an
+*   Iterator, so a page costs O(log n + limit) wherever it starts.
+* A customer sharing its ID with a later line of the customer file cannot
+*   be resumed at, so it is added to the end of the page before it.
+* @param cursor ID of the customer to start at, -1 for the first. Set to
+*                 the ID the next page starts at, -1 once every customer
+*                 is output.
+* @param limit  Most customers to output.
+* @param output Stream to write the logs to.
+* @pre      None.
+* @post     limit histories are output, fewer on the last page, nothing
+*             if cursor is not a registered customer.
+* @return   True once the page is output, false if cursor is not a
+*             registered customer.
+*/
+bool CustomerRegistry::outputPage(int64_t& cursor, size_t limit, ostream& output) const
+{
+   const Customer* from = nullptr;
+
+   if (cursor >= 0 && (from = registry.find(cursor)) == nullptr)
+      return false;
+
+   SearchTree::Iterator cur = from != nullptr ? customers->seek(from) : customers->begin();
+   for (; cur != customers->end(); ++cur) {
+      Customer* customer = static_cast<Customer*>(*cur);
+      if (limit == 0 && registry.find(customer->getId()) == customer) {
+         cursor = customer->getId();   // Page is full, resume here
+         return true;
+      }
+      output << *customer << '\n';
+      limit -= limit > 0 ? 1 : 0;
+   }
+   cursor = -1;
+   return true;
+}
+
+/** ----------------------------- outputNamed(string_view, bool, ostream&) -
+* Outputs the ID and name of every customer with a name, or with a name
+*   starting with it, found in the NameIndex in O(log n + k) for k
+*   matching customers.
+* @param name   Name or start of a name to find.
+* @param prefix True to match every name starting with name.
+* @param output Stream to write the customers to.
+* @pre      None.
+* @post     Matching customers are output one per line as "001, Name",
+*             in alphabetical order, then by ID.
+*/
+void CustomerRegistry::outputNamed(string_view name, bool prefix, ostream& output) const
+{
+   vector<const Customer*> matches;
+
+   names.find(name, prefix, matches);
+   for (const Customer* customer : matches) {
+      output << setw(3) << right << setfill('0') << customer->getId()
+         << left << setfill(' ') << ", " << customer->getName() << '\n';
+   }
+}
@@ -1,82 +1,304 @@
-/** @file CustomerRegistry.h
- * @author Korosh Moosavi
- * @date 2021-03-12
- *
- * CustomerRegistry class:
- * Used to manage registered customers and their interactions with the store
- *   and its inventory.
- * 
- * Assumptions:
- * Only Customer objects and its subclasses will be hashed.
- * Input file includes IDs as 3-digit numbers with leading 0s if necessary.
- * Name will be saved and sorted as-is, including any extra spaces or characters.
- */
-#pragma once
-#include "Customer.h"
-#include "Collectible.h"
-#include "SearchTree.h"
-#include <fstream>
-
-class CustomerRegistry {
-private:
-   Customer* registry[1000];
-
-   SearchTree* customers;
-
-public:
-   /** ------------------------------ Constructor ----------------------
-    * Parses input file to create Customer objects and insert their pointers into
-    *   both the SearchTree 'customers' and hash table 'registry'
-    * @param fileName Name of the input file containing data on store Customers.
-    * @pre  Pre-formatted and pre-determined file is in the same directory.
-    * @post Only one instance of each Customer is create with pointers in both data
-    *         members of this object.
-    */
-   CustomerRegistry(string fileName);
-
-   /** ------------------------------ Destructor -------------------------------
-    * SearchTree destructor is used to free memory.
-    * @pre  None
-    * @post Data is deallocated for destruction.
-    */
-   virtual ~CustomerRegistry();
-
-   /** --------------------- updateLog(Collectible*, int, bool) -----------------
-   * Adds parameter item to transaction vector in Customer object corresponding
-   *   to the parameter id.
-   * Adds bool value to txnType vector indicating whether the store bought from
-   *   or sold to the customer.
-   * @param item  Collectible object to add to Customer's transaction log.
-   * @param id    Customer ID whose log to add this item to.
-   * @param isBuy Whether the transaction is a buy or sell
-   * @pre        Customer and item both exist in their respective tables.
-   *             Calling method calls Inventory.updateInventory(item, -1) first
-   *               to ensure there is enough stock.
-   * @post       Item has been added to the transaction log of the Customer.
-   *             Transaction type (buy/sell) has also been recorded in Customer.
-   * @return     Returns true on successful execution, false on failure.
-   */
-   bool updateLog(Collectible* item, int id, bool isBuy);
-
-   /** ----------------------------- outputLog(int) ---------------------
-    * Finds Customer object with given ID and outputs items stored in its
-    *   transactions vector as well as whether it was bought or sold.
-    * In this implementation all customer transactions will be
-    *   of quantity 1.
-    * @param id Desired customer to print transaction log for.
-    * @pre      Customer with given ID exists and is initialized.
-    * @post     Items stored in transactions vector are output.
-    * @return   True if desired Customer was found, false if not.
-    */
-   bool outputLog(int id);
-
-   /** ----------------------------- outputAll() ---------------------
-    * Calls the customers SearchTree's output operator to in-order traverse
-    *   through each Customer and call their output operators.
-    * @pre      None, tree will indicate if it is empty.
-    * @post     Items stored in transactions vector of each customer
-    *             are output, customers are listed in alphabetical order.
-    * @return   True if all Customers were output, false if there is no tree.
-    */
-   bool outputAll();
-};
+/** @file CustomerRegistry.h
+ * @author Korosh Moosavi
+ * @date 2021-03-12
+ *
+ * CustomerRegistry class:
+ * Used to manage registered customers and their interactions with the store
+ *   and its inventory.
+ * Customers are allocated in Arenas owned by the registry, and released
+ *   together when it is destroyed.
+ * Customers are looked up by ID through a CustomerIndex, which grows with
+ *   the number of customers, and new customers can be registered while
+ *   transactions are processed.
+ * Trades can be logged by several threads at once. Inside a batch, see
+ *   beginBatch(), each customer's history still lists its trades in the
+ *   order of the transactions file.
+ * Every customer and the whole TransactionLog can be saved to a Snapshot
+ *   and restored from it, along with the Inventory the log refers to.
+ * Once a Journal is set, every trade and registration is also appended to
+ *   it, so the changes can be replayed after a crash.
+ * Histories can be paged through with outputPage(), which resumes at a
+ *   customer ID instead of visiting every customer before it.
+ * Customers can be found by name or by the start of their name through a
+ *   NameIndex, a sorted array built once loading is done.
+ * 
+ * Assumptions:
+ * Only Customer objects and its subclasses will be hashed.
+ * Input file includes IDs as non-negative 64-bit numbers, written with at
+ *   least 3 digits using leading 0s if necessary.
+ * Name will be saved and sorted as-is, including any extra spaces or characters.
+ */
+#pragma once
+#include "Customer.h"
+#include "CustomerIndex.h"
+#include "NameIndex.h"
+#include "TransactionLog.h"
+#include "Collectible.h"
+#include "Inventory.h"
+#include "SearchTree.h"
+#include "MappedFile.h"
+#include "Snapshot.h"
+#include "Journal.h"
+#include "CommandParser.h"
+#include "ThreadPool.h"
+#include <chrono>
+#include <mutex>
+
+class CustomerRegistry {
+private:
+   CustomerIndex registry;
+
+   SearchTree* customers;
+   NameIndex names;           // Customers of the tree by name
+   vector<Arena*> customerArenas;   // Own every customer, one per parsed chunk
+   TransactionLog log;        // Every customer's transactions, in order
+   Journal* journal = nullptr;   // Records every change if set
+   LoadStats loadStats;
+
+   /** ------------------------ PendingTrade struct --------------------------
+    * Trade logged inside a batch, added to its customer by commitBatch()
+    * customer is nullptr when the command of the slot made no trade
+    */
+   struct PendingTrade {
+      Customer* customer;
+      uint64_t entry;
+   };
+
+   static const uint8_t SAVED_IN_TREE = 1;   // Snapshot flags of a customer
+   static const uint8_t SAVED_INDEXED = 2;
+
+   static const int HISTORY_LOCKS = 64;   // Customers share locks by ID
+   mutex historyLocks[HISTORY_LOCKS];     // Guard histories outside a batch
+
+   vector<PendingTrade> batch;   // One slot per command of the open batch
+   uint64_t batchStart = 0;      // Sequence of the first command in batch
+   bool batching = false;
+
+   /** ----------------------------- parseCustomer(string_view, Arena&) -------
+    * Creates a Customer from a line of the customer file.
+    * @param fileInput Line formatted as "001, Michael Jordan"
+    * @param arena     Arena to create the Customer in
+    * @return New Customer, nullptr if the ID is malformed or negative
+    */
+   Customer* parseCustomer(string_view fileInput, Arena& arena) const;
+
+   /** ----------------------------- add(Customer*) ---------------------
+    * Inserts a Customer into both the hash table and the SearchTree.
+    * @param temp Customer created in one of customerArenas
+    */
+   void add(Customer* temp);
+
+public:
+   /** ------------------------------ Constructor ----------------------
+    * Parses input file to create Customer objects and insert their pointers into
+    *   both the SearchTree 'customers' and hash table 'registry'
+    * The file is memory mapped and each line is parsed in place, so only the
+    *   customer name is copied.
+    * @param fileName Name of the input file containing data on store Customers.
+    * @pre  Pre-formatted and pre-determined file is in the same directory.
+    * @post Only one instance of each Customer is create with pointers in both data
+    *         members of this object.
+    */
+   CustomerRegistry(string fileName);
+
+   /** ------------------------------ Parallel constructor ----------------------
+    * Builds the same registry as CustomerRegistry(string) using a ThreadPool.
+    * The file is split into chunks that are parsed concurrently, then the
+    *   Customers are inserted in file order so the result does not depend
+    *   on timing.
+    * @param fileName Name of the input file containing data on store Customers.
+    * @param pool     Workers to parse with.
+    * @pre  Pre-formatted and pre-determined file is in the same directory.
+    *       Not called from a task running on pool.
+    * @post Only one instance of each Customer is create with pointers in both data
+    *         members of this object.
+    */
+   CustomerRegistry(string fileName, ThreadPool& pool);
+
+   /** ------------------------------ Snapshot constructor ----------------------
+    * Rebuilds a registry saved by save(Snapshot&), with every customer, the
+    *   whole TransactionLog and each customer's history. The SearchTree is
+    *   built directly from its saved order, so no customer is compared.
+    * @param snapshot  Snapshot being read, positioned where save() started.
+    * @param inventory Inventory restored from the same snapshot, holding the
+    *                    logged items.
+    * @pre  None
+    * @post Every saved customer and trade is restored, unless snapshot turns
+    *         out to be invalid, in which case the registry should be discarded.
+    */
+   CustomerRegistry(Snapshot& snapshot, const Inventory& inventory);
+
+   /** ------------------------------ Destructor -------------------------------
+    * The SearchTree is deleted, then every Customer is released with its Arena.
+    * @pre  None
+    * @post Data is deallocated for destruction.
+    */
+   virtual ~CustomerRegistry();
+
+   /** --------------------- registerCustomer(int64_t, string_view) ------------
+   * Adds a new customer while the store is running.
+   * @param id   ID of the new customer.
+   * @param name Name of the new customer.
+   * @pre        None.
+   * @post       The customer can trade, is listed by outputAll() and
+   *               outputNamed(), and is added to the Journal if one is set.
+   * @return     True if the customer was added, false if the ID is negative,
+   *               already registered, or the name is empty.
+   */
+   bool registerCustomer(int64_t id, string_view name);
+
+   /** --------------------- isRegistered(int64_t) -----------------------------
+   * @param id ID of a customer.
+   * @return True if a customer with that ID can trade.
+   */
+   bool isRegistered(int64_t id) const { return registry.find(id) != nullptr; };
+
+   /** --------------------- setJournal(Journal*) ------------------------------
+   * Sets the journal every later trade and registration is appended to.
+   * @param changes Open journal owned by the caller, nullptr to stop
+   *                  journaling.
+   */
+   void setJournal(Journal* changes) { journal = changes; };
+
+   /** --------------------- updateLog(Collectible&, int64_t, bool, uint64_t) ---
+   * Appends a single-item trade of parameter item to the store-wide
+   *   TransactionLog and adds the entry to the Customer corresponding to the
+   *   parameter id.
+   * Several threads may call this at once. Inside a batch the entry is only
+   *   added to the Customer by commitBatch().
+   * @param item     Inventory item traded, referred to by its item ID.
+   * @param id       Customer ID whose log to add this item to.
+   * @param isBuy    Whether the transaction is a buy or sell
+   * @param sequence Position of the trading command in the transactions file
+   * @pre        Customer and item both exist in their respective tables.
+   *             Calling method calls Inventory.updateInventory(item, -1) first
+   *               to ensure there is enough stock.
+   * @post       Trade has been added to the transaction log of the Customer,
+   *               including whether it was a buy or sell, and to the
+   *               Journal if one is set.
+   * @return     Returns true on successful execution, false on failure.
+   */
+   bool updateLog(const Collectible& item, int64_t id, bool isBuy, uint64_t sequence);
+
+   /** --------------------- beginBatch(uint64_t, size_t) ----------------------
+   * Starts a batch of commands whose trades are logged concurrently.
+   * @param firstSequence Sequence of the first command in the batch.
+   * @param commands      Number of commands in the batch, whose sequences
+   *                        follow firstSequence without gaps.
+   * @pre        No batch is open, and no customer is registered or output
+   *               until endBatch().
+   * @post       updateLog() defers adding entries to customers.
+   */
+   void beginBatch(uint64_t firstSequence, size_t commands);
+
+   /** --------------------- commitBatch(int, int) -----------------------------
+   * Adds the trades logged in the open batch to their customers, in the
+   *   order of the transactions file.
+   * Only customers whose ID falls in the given shard are updated, so each
+   *   shard can be committed by its own thread.
+   * @param shard  Shard to commit, 0 to shards - 1.
+   * @param shards Number of shards the customers are split into.
+   * @pre        Every updateLog() call of the batch has returned.
+   */
+   void commitBatch(int shard, int shards);
+
+   /** --------------------- endBatch() ----------------------------------------
+   * Closes the open batch once every shard is committed.
+   * @post       updateLog() adds entries to customers directly again.
+   */
+   void endBatch() { batching = false; };
+
+   /** ----------------------------- save(Snapshot&) ---------------------
+    * Adds the TransactionLog and every customer with its history to a
+    *   snapshot being written, after the Inventory the log refers to.
+    * Customers are saved in tree order, so they are restored without sorting.
+    * @param snapshot Snapshot being written.
+    * @pre      No batch is open and no transaction is being processed.
+    * @post     The registry can be rebuilt by the Snapshot constructor.
+    */
+   void save(Snapshot& snapshot) const;
+
+   /** ----------------------------- outputLog(int64_t, ostream&) -----------------
+    * Finds Customer object with given ID and outputs items stored in its
+    *   transactions vector as well as whether it was bought or sold.
+    * In this implementation all customer transactions will be
+    *   of quantity 1.
+    * @param id     Desired customer to print transaction log for.
+    * @param output Stream to write the log to.
+    * @pre      Customer with given ID exists and is initialized.
+    * @post     Items stored in transactions vector are output.
+    * @return   True if desired Customer was found, false if not.
+    */
+   bool outputLog(int64_t id, ostream& output);
+
+   /** ----------------------------- outputAll(ostream&) ---------------------
+    * Calls the customers SearchTree's output operator to in-order traverse
+    *   through each Customer and call their output operators.
+    * @param output Stream to write the logs to.
+    * @pre      None, tree will indicate if it is empty.
+    * @post     Items stored in transactions vector of each customer
+    *             are output, customers are listed in alphabetical order.
+    * @return   True if all Customers were output, false if there is no tree.
+    */
+   bool outputAll(ostream& output);
+
+   /** ----------------------------- outputPage(int64_t&, size_t, ostream&) ---
+    * Outputs the histories of a page of customers in alphabetical order,
+    *   starting at a customer and walking the SearchTree from there with an
+    *   Iterator, so a page costs O(log n + limit) wherever it starts.
+    * A customer sharing its ID with a later line of the customer file cannot
+    *   be resumed at, so it is added to the end of the page before it.
+    * @param cursor ID of the customer to start at, -1 for the first. Set to
+    *                 the ID the next page starts at, -1 once every customer
+    *                 is output.
+    * @param limit  Most customers to output.
+    * @param output Stream to write the logs to.
+    * @pre      None.
+    * @post     limit histories are output, fewer on the last page, nothing
+    *             if cursor is not a registered customer.
+    * @return   True once the page is output, false if cursor is not a
+    *             registered customer.
+    */
+   bool outputPage(int64_t& cursor, size_t limit, ostream& output) const;
+
+   /** ----------------------------- outputNamed(string_view, bool, ostream&) -
+    * Outputs the ID and name of every customer with a name, or with a name
+    *   starting with it, found in the NameIndex in O(log n + k) for k
+    *   matching customers.
+    * @param name   Name or start of a name to find.
+    * @param prefix True to match every name starting with name.
+    * @param output Stream to write the customers to.
+    * @pre      None.
+    * @post     Matching customers are output one per line as "001, Name",
+    *             in alphabetical order, then by ID.
+    */
+   void outputNamed(string_view name, bool prefix, ostream& output) const;
+
+   /** ----------------------------- getLoadStats() ---------------------
+    * @return Size and duration of loading the customer file.
+    */
+   const LoadStats& getLoadStats() const { return loadStats; };
+
+   /** ----------------------------- outputMemoryStats(ostream&) --------------
+    * Outputs bytes used and reserved by the Arenas of tree nodes and customers.
+    * @param output Stream to write the statistics to.
+    * @pre      None.
+    * @post     Statistics are output on a single line.
+    */
+   void outputMemoryStats(ostream& output) const;
+
+   /** ----------------------------- outputIndexStats(ostream&) ---------------
+    * Outputs size and resize statistics of the customer lookup index, and
+    *   size statistics of the name index.
+    * @param output Stream to write the statistics to.
+    * @pre      None.
+    * @post     Statistics are output on two lines.
+    */
+   void outputIndexStats(ostream& output) const
+   { registry.outputStats(output); names.outputStats(output); };
+
+   /** ----------------------------- getLog() ---------------------
+    * @return Store-wide log of every customer's transactions.
+    */
+   const TransactionLog& getLog() const { return log; };
+};
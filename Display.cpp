@@ -1,27 +1,85 @@
-/** @file Display.cpp
- * @author Korosh Moosavi
- * @date 2021-03-12
- *
- * Display class:
- * Class encompassing the store function to output details of the store's
- *   current inventory state.
- *
- * Assumptions:
- * Objects used in this method are valid and initialized.
- */
-#include "Display.h"
-
-/** ----------------------- process(Inventory&, CustomerRegistry&) ---------
-* Uses outputAll() method within Inventory to output details on all the 
-*   Collectible objects it has stored.
-* @param inventory  Inventory storing data on the store's current items.
-* @param registry   Not used, remnant of parent class parameter.
-* @param input      String containing any additional transaction details.
-* @pre    None, but will not output anything if inventory is empty.
-* @return Returns true once output is complete.
-*/
-bool Display::process(Inventory& inventory, CustomerRegistry& registry, string input)
-{
-   cout << "Current inventory: " << endl;
-   return inventory.outputAll();
-}
+/** @file Display.cpp
+ * @author Korosh Moosavi
+ * @date 2021-03-12
+ *
+ * Display class:
+ * Class encompassing the store function to output details of the store's
+ *   current inventory state.
+ * "D" outputs every item. "D, 50" outputs the first 50 items and ends with
+ *   the command for the next page, such as "D, 50, 1234", where 1234 is the
+ *   item ID the next page resumes at.
+ * A leading "+" limits the display to items in stock, such as "D, +" or
+ *   "D, +, 50, 1234".
+ *
+ * Assumptions:
+ * Objects used in this method are valid and initialized.
+ */
+#include "Display.h"
+
+/** ----------------------- process(Inventory&, CustomerRegistry&, Command&, ostream&) ---
+* Uses outputAll() method within Inventory to output details on all the 
+*   Collectible objects it has stored.
+* Runs alone, so the display cache of Inventory needs no locking.
+* A page size in the command outputs a single page with outputPage().
+* A leading "+" outputs only items in stock with outputInStock(), skipping
+*   sold out items without visiting them.
+* @param inventory  Inventory storing data on the store's current items.
+* @param registry   Not used, remnant of parent class parameter.
+* @param command    Parsed transaction line, args are empty or hold
+*                     "limit" or "limit, cursor", optionally after "+".
+* @param output     Stream the operation's report is written to.
+* @pre    None, but will not output anything if inventory is empty.
+* @return Returns true once output is complete, false if the page size or
+*           cursor is not valid.
+*/
+bool Display::process(Inventory& inventory, CustomerRegistry& registry, const Command& command,
+                      ostream& output)
+{
+   if (command.args.empty()) {
+      output << "Current inventory: \n";
+      return inventory.outputAll(output);
+   }
+
+   string_view rest = command.args;
+   int limit = 0, start = -1;
+   bool inStock = rest.substr(0, 1) == "+";
+
+   if (inStock) {
+      bool valid = CommandParser::nextField(rest) == "+";
+      if (valid && rest.empty()) {     // Every item in stock
+         int64_t cursor = -1;
+         output << "Current inventory in stock: \n";
+         return inventory.outputInStock(cursor, SIZE_MAX, output);
+      }
+      if (!valid) {
+         cerr << "Invalid display page entered.\n\n";
+         return false;
+      }
+   }
+
+   bool valid = CommandParser::toInt(CommandParser::nextField(rest), limit) && limit > 0;
+   if (valid && !rest.empty())         // Resume cursor
+      valid = CommandParser::toInt(CommandParser::nextField(rest), start) && start >= 0 &&
+              rest.empty();
+   if (!valid) {
+      cerr << "Invalid display page entered.\n\n";
+      return false;
+   }
+   if (start >= 0 && inventory.getItem(start) == nullptr) {
+      cerr << "Unrecognized display cursor entered.\n\n";
+      return false;
+   }
+   int64_t cursor = start;
+   if (inStock) {
+      output << "Current inventory in stock: \n";
+      inventory.outputInStock(cursor, limit, output);
+   } else {
+      output << "Current inventory: \n";
+      inventory.outputPage(cursor, limit, output);
+   }
+   if (cursor >= 0) {
+      output << "More items follow, next page: D, " << (inStock ? "+, " : "") << limit
+         << ", " << cursor << "\n\n";
+   }
+   return true;
+}
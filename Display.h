@@ -1,40 +1,52 @@
-/** @file Display.cpp
- * @author Korosh Moosavi
- * @date 2021-03-12
- *
- * Display class:
- * Class encompassing the store function to output details of the store's
- *   current inventory state.
- *
- * Assumptions:
- * Objects used in this method are valid and initialized.
- */
-#include "Transaction.h"
-
-class Display : public Transaction {
-public:
-   /** ------------------------------ Default constructor ----------------------
-    * No special operations needed.
-    * @pre  None
-    * @post Display object created.
-    */
-   Display() {};
-
-   /** ------------------------------ Destructor -------------------------------
-    * No special operations needed.
-    * @pre  None
-    * @post Data is deallocated after destruction.
-    */
-   virtual ~Display() {};
-
-   /** -------------- process(Inventory&, CustomerRegistry&, string) ---------
-   * Uses outputAll() method within Inventory to output details on all the
-   *   Collectible objects it has stored.
-   * @param inventory  Inventory storing data on the store's current items.
-   * @param registry   Not used, remnant of parent class parameter.
-   * @param input      String containing any additional transaction details.
-   * @pre    None, but will not output anything if inventory is empty.
-   * @return Returns true once output is complete.
-   */
-   bool process(Inventory& inventory, CustomerRegistry& registry, string input);
-};
+/** @file Display.cpp
+ * @author Korosh Moosavi
+ * @date 2021-03-12
+ *
+ * Display class:
+ * Class encompassing the store function to output details of the store's
+ *   current inventory state.
+ * "D" outputs every item. "D, 50" outputs the first 50 items and ends with
+ *   the command for the next page, such as "D, 50, 1234", where 1234 is the
+ *   item ID the next page resumes at.
+ * A leading "+" limits the display to items in stock, such as "D, +" or
+ *   "D, +, 50, 1234".
+ *
+ * Assumptions:
+ * Objects used in this method are valid and initialized.
+ */
+#include "Transaction.h"
+
+class Display : public Transaction {
+public:
+   /** ------------------------------ Default constructor ----------------------
+    * No special operations needed.
+    * @pre  None
+    * @post Display object created.
+    */
+   Display() {};
+
+   /** ------------------------------ Destructor -------------------------------
+    * No special operations needed.
+    * @pre  None
+    * @post Data is deallocated after destruction.
+    */
+   virtual ~Display() {};
+
+   /** -------------- process(Inventory&, CustomerRegistry&, Command&, ostream&) ---
+   * Uses outputAll() method within Inventory to output details on all the
+   *   Collectible objects it has stored.
+   * Runs alone, so the display cache of Inventory needs no locking.
+   * A page size in the command outputs a single page with outputPage().
+   * A leading "+" outputs only items in stock with outputInStock().
+   * @param inventory  Inventory storing data on the store's current items.
+   * @param registry   Not used, remnant of parent class parameter.
+   * @param command    Parsed transaction line, args are empty or hold
+   *                     "limit" or "limit, cursor", optionally after "+".
+   * @param output     Stream the operation's report is written to.
+   * @pre    None, but will not output anything if inventory is empty.
+   * @return Returns true once output is complete, false if the page size or
+   *           cursor is not valid.
+   */
+   bool process(Inventory& inventory, CustomerRegistry& registry, const Command& command,
+                ostream& output);
+};
@@ -1,64 +1,83 @@
-/** @file Factory.cpp
- * @author Korosh Moosavi
- * @date 2021-03-12
- * 
- * Factory class:
- * Class used to create various subclasses of Collectible.
- * Return is dependent on string parameter containing details of object
- *   to be created.
- *
- * Assumptions:
- * All subclasses of Collectible that are to be used by the program must be
- *   manually entered into the constructor of this class.
- * Each subclass has implemented create() and create(string) methods where
- *   create(string) accepts a string containing all of the object details
- * Each subclass has a unique identifying char symbol between '@' and 'Z'
- * Input string begins with char symbol for the desired object
- */
-#include "Factory.h"
-
-/** ----------------------------- Constructor ---------------------
-* Manually create new dummy subclass objects at the appropriate indeces
-*   within the hash table itemFactory[].
-* @pre  All subclasses have a unique char symbol
-* @post Factory is able to create any subclass object using its own create()
-*        given its corresponding symbol
-*/
-Factory::Factory()
-{
-   itemFactory[hash('M')] = new Coin;
-   itemFactory[hash('C')] = new ComicBook;
-   itemFactory[hash('S')] = new SportsCard;
-}
-
-/** ----------------------------- Destructor ---------------------
-* All dummy objects in itemFactory[] are deleted and no more memory is tied
-*   to this object.
-* @pre   None
-* @post  Memory tied to this Factory object is freed.
-*/
-Factory::~Factory()
-{
-   for (int i = 0; i < sizeof(itemFactory) / sizeof(*itemFactory); i++) {
-      if (itemFactory[i] != nullptr) {
-         delete itemFactory[i];
-         itemFactory[i] = nullptr;
-      }
-   }
-}
-
-/** ----------------------------- create(string) --------------------------
-* Uses hash(char) to determine which subclass to create and return. 
-* Passes string along for parameter construction.
-* @pre    All subclasses are properly hashed and have a create(string) method
-* @post   An indicated subclass is parameter constructed
-* @return A pointer to the newly created indicated subclass
-*/
-Collectible* Factory::create(string details) const
-{
-   if(itemFactory[hash(details[0])] != nullptr)
-      return itemFactory[hash(details[0])]->create(details);
-   
-   cerr << "Unrecognized Collectible entered.\n" << endl;
-   return nullptr;
+/** @file Factory.cpp
+ * @author Korosh Moosavi
+ * @date 2021-03-12
+ * 
+ * Factory class:
+ * Class used to create various subclasses of Collectible.
+ * Return is dependent on string parameter containing details of object
+ *   to be created.
+ * The factory is a constant table of creation functions indexed by item
+ *   symbol, built at compile time. It holds no state and no prototype
+ *   objects, so it is never constructed and is safe to use from any thread.
+ *
+ * Assumptions:
+ * All subclasses of Collectible that are to be used by the program must be
+ *   manually entered into buildTable() of this class.
+ * Each subclass has a constructor accepting an ItemRecord containing all of
+ *   the object details
+ * Each subclass has a unique identifying char symbol between '@' and 'Z'
+ * Input string begins with char symbol for the desired object
+ */
+#include "Factory.h"
+
+// Constant initialized before any code runs, never modified afterwards
+const Factory::CreatorTable<ItemRecord> Factory::itemFactory = Factory::buildTable<ItemRecord>();
+const Factory::CreatorTable<StoredItem> Factory::storedFactory = Factory::buildTable<StoredItem>();
+
+/** ----------------------------- create(string, Arena*) ------------------
+* Parses the details then uses hash(char) to determine which subclass to
+*   create and return.
+* @param  arena Arena to create the item in, nullptr to use new
+* @pre    Details are formatted as a line of the inventory file
+* @post   An indicated subclass is parameter constructed
+* @return A pointer to the newly created indicated subclass, nullptr if
+*           the symbol is not recognized or the details are malformed
+*/
+Collectible* Factory::create(string_view details, Arena* arena)
+{
+   ItemRecord record;
+
+   if (!details.empty() && !isRecognized(details[0])) {
+      cerr << "Unrecognized Collectible entered.\n\n";
+      return nullptr;
+   }
+   if (!CommandParser::parseItem(details, record, true))
+      return nullptr;
+   return create(record, arena);
+}
+
+/** ----------------------------- create(ItemRecord&, Arena*) --------------
+* Uses hash(char) to determine which subclass to create and return.
+* Copies the fields of an already parsed item.
+* @param  arena Arena to create the item in, nullptr to use new
+* @pre    None
+* @post   An indicated subclass is record constructed
+* @return A pointer to the newly created indicated subclass, nullptr if
+*           the symbol is not recognized
+*/
+Collectible* Factory::create(const ItemRecord& record, Arena* arena)
+{
+   if (isRecognized(record.symbol))
+      return itemFactory.entries[hash(record.symbol)](record, arena);
+
+   cerr << "Unrecognized Collectible entered.\n\n";
+   return nullptr;
+}
+
+/** ----------------------------- create(StoredItem&, Arena*) --------------
+* Uses hash(char) to determine which subclass to create and return.
+* Copies the fields of an item saved in a Snapshot.
+* @param  arena Arena to create the item in, nullptr to use new
+* @pre    None
+* @post   An indicated subclass is stored constructed
+* @return A pointer to the newly created indicated subclass, nullptr if
+*           the symbol is not recognized
+*/
+Collectible* Factory::create(const StoredItem& stored, Arena* arena)
+{
+   if (isRecognized(stored.symbol))
+      return storedFactory.entries[hash(stored.symbol)](stored, arena);
+
+   cerr << "Unrecognized Collectible entered.\n\n";
+   return nullptr;
 }
\ No newline at end of file
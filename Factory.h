@@ -1,64 +1,125 @@
-/** @file Factory.h
- * @author Korosh Moosavi
- * @date 2021-03-12
- *
- * Factory class:
- * Class used to create various subclasses of Collectible.
- * Return is dependent on string parameter containing details of object
- *   to be created.
- *
- * Assumptions:
- * All subclasses of Collectible that are to be used by the program must be
- *   manually entered into the constructor of this class.
- * Each subclass has implemented create() and create(string) methods where
- *   create(string) accepts a string containing all of the object details
- * Each subclass has a unique identifying char symbol between '@' and 'Z'
- * Input string begins with char symbol for the desired object
- */
-#pragma once
-#include "Coin.h"
-#include "ComicBook.h"
-#include "SportsCard.h"
-
-class Factory {
-private:
-   Collectible* itemFactory[Collectible::UNIQUES] = { nullptr };
-
-   /** ----------------------------- hash(char) ---------------------
-   * Items are identified by a single capital letter
-   * The base Collectible class is identified by the @ symbol, but is not used
-   *   This comes right before 'A' on the ASCII table
-   * As a result, the first element of itemFactory[] is left empty 
-   *   in this implementation due to Collectible being an abstract class
-   * @pre    c is between @ and Z (64 and 90)
-   * @return A unique int value between 0 and 26 inclusive
-   */
-   int hash(char c) const { return c - '@'; };
-
-public:
-   /** ----------------------------- Constructor ---------------------
-   * Manually create new dummy subclass objects at the appropriate indeces
-   *   within the hash table itemFactory[].
-   * @pre  All subclasses have a unique char symbol
-   * @post Factory is able to create any subclass object using its own create()
-   *        given its corresponding symbol
-   */
-   Factory();
-
-   /** ----------------------------- Destructor ---------------------
-   * All dummy objects in itemFactory[] are deleted and no more memory is tied
-   *   to this object.
-   * @pre   None
-   * @post  Memory tied to this Factory object is freed.
-   */
-   ~Factory();
-
-   /** ----------------------------- create(string) --------------------------
-   * Uses hash(char) to determine which subclass to create and return.
-   * Passes string along for parameter construction.
-   * @pre    All subclasses are properly hashed and have create(string) method
-   * @post   An indicated subclass is parameter constructed
-   * @return A pointer to the newly created indicated subclass
-   */
-   Collectible* create(string details) const;
+/** @file Factory.h
+ * @author Korosh Moosavi
+ * @date 2021-03-12
+ *
+ * Factory class:
+ * Class used to create various subclasses of Collectible.
+ * Return is dependent on string parameter containing details of object
+ *   to be created.
+ * The factory is a constant table of creation functions indexed by item
+ *   symbol, built at compile time. It holds no state and no prototype
+ *   objects, so it is never constructed and is safe to use from any thread.
+ *
+ * Assumptions:
+ * All subclasses of Collectible that are to be used by the program must be
+ *   manually entered into buildTable() of this class.
+ * Each subclass has a constructor accepting an ItemRecord containing all of
+ *   the object details, and one accepting a StoredItem saved in a Snapshot
+ * Each subclass has a unique identifying char symbol between '@' and 'Z'
+ * Input string begins with char symbol for the desired object
+ */
+#pragma once
+#include "Coin.h"
+#include "ComicBook.h"
+#include "SportsCard.h"
+#include "Arena.h"
+
+class Factory {
+private:
+   /** ----------------------------- Creator ---------------------
+   * Creation function for one subclass, copies fields of a parsed record R
+   *   (ItemRecord) or a saved one (StoredItem)
+   * Allocates in arena, or on the heap if arena is nullptr
+   */
+   template <class R>
+   using Creator = Collectible* (*)(const R& record, Arena* arena);
+
+   /** ----------------------------- CreatorTable ---------------------
+   * Wrapper allowing the table to be built by a constexpr function
+   */
+   template <class R>
+   struct CreatorTable {
+      Creator<R> entries[Collectible::UNIQUES];
+   };
+
+   static const CreatorTable<ItemRecord> itemFactory;
+   static const CreatorTable<StoredItem> storedFactory;
+
+   /** ----------------------------- hash(char) ---------------------
+   * Items are identified by a single capital letter
+   * The base Collectible class is identified by the @ symbol, but is not used
+   *   This comes right before 'A' on the ASCII table
+   * As a result, the first element of itemFactory is left empty 
+   *   in this implementation due to Collectible being an abstract class
+   * @pre    c is between @ and Z (64 and 90)
+   * @return A unique int value between 0 and 26 inclusive
+   */
+   static constexpr int hash(char c) { return c - '@'; };
+
+   /** ----------------------------- createItem(R&, Arena*) --------
+   * Creation function stored in a table for subclass T.
+   * @return A pointer to a newly record constructed T, owned by arena if
+   *           one is given
+   */
+   template <class T, class R>
+   static Collectible* createItem(const R& record, Arena* arena)
+   { return arena == nullptr ? new T(record) : arena->create<T>(record); };
+
+   /** ----------------------------- buildTable() ---------------------
+   * Manually place the creation function of each subclass at the appropriate
+   *   index within the table. Evaluated at compile time, once for each kind
+   *   of record R.
+   * @pre    All subclasses have a unique char symbol
+   * @return Table able to create any subclass given its corresponding symbol
+   */
+   template <class R>
+   static constexpr CreatorTable<R> buildTable()
+   {
+      CreatorTable<R> table = {};
+      table.entries[hash('M')] = &createItem<Coin, R>;
+      table.entries[hash('C')] = &createItem<ComicBook, R>;
+      table.entries[hash('S')] = &createItem<SportsCard, R>;
+      return table;
+   };
+
+public:
+   /** ----------------------------- create(string, Arena*) ------------------
+   * Parses the details then uses hash(char) to determine which subclass to
+   *   create and return.
+   * @param  arena Arena to create the item in, nullptr to use new
+   * @pre    Details are formatted as a line of the inventory file
+   * @post   An indicated subclass is parameter constructed
+   * @return A pointer to the newly created indicated subclass, nullptr if
+   *           the symbol is not recognized or the details are malformed
+   */
+   static Collectible* create(string_view details, Arena* arena = nullptr);
+
+   /** ----------------------------- create(ItemRecord&, Arena*) --------------
+   * Uses hash(char) to determine which subclass to create and return.
+   * Copies the fields of an already parsed item.
+   * @param  arena Arena to create the item in, nullptr to use new
+   * @pre    None
+   * @post   An indicated subclass is record constructed
+   * @return A pointer to the newly created indicated subclass, nullptr if
+   *           the symbol is not recognized
+   */
+   static Collectible* create(const ItemRecord& record, Arena* arena = nullptr);
+
+   /** ----------------------------- create(StoredItem&, Arena*) --------------
+   * Uses hash(char) to determine which subclass to create and return.
+   * Copies the fields of an item saved in a Snapshot.
+   * @param  arena Arena to create the item in, nullptr to use new
+   * @pre    None
+   * @post   An indicated subclass is stored constructed
+   * @return A pointer to the newly created indicated subclass, nullptr if
+   *           the symbol is not recognized
+   */
+   static Collectible* create(const StoredItem& stored, Arena* arena = nullptr);
+
+   /** ----------------------------- isRecognized(char) ----------------------
+   * @param  c Symbol of the item
+   * @return True if this Factory can create items identified by c.
+   */
+   static bool isRecognized(char c)
+   { return c >= '@' && c < '@' + Collectible::UNIQUES && itemFactory.entries[hash(c)] != nullptr; };
 };
\ No newline at end of file
@@ -0,0 +1,40 @@
+/** @file Grade.cpp
+ * @author Korosh Moosavi
+ * @date 2026-10-16
+ *
+ * Grade class:
+ * Converts the grade text of a Collectible into an ordinal code on the
+ *   grading scale of its category.
+ *
+ * Assumptions:
+ * Condition names match the scale exactly, including capitalization.
+ */
+#include "Grade.h"
+#include "CommandParser.h"
+
+// Condition scale of comic books and sports cards, worst first
+static const string_view CONDITIONS[] = { "Poor", "Fair", "Good", "Very Good", "Fine",
+                                          "Very Fine", "Excellent", "Near Mint", "Mint",
+                                          "Gem Mint" };
+
+/** ----------------------------- code(char, string_view) ----------------
+ * @param symbol Category symbol of the item, 'M' for Coin
+ * @param grade  Grade text as written in the inventory file
+ * @return Place of grade on the scale of the category, higher is better,
+ *           UNGRADED if it is not on the scale.
+ */
+uint8_t Grade::code(char symbol, string_view grade)
+{
+   if (symbol == 'M') {                      // Sheldon scale
+      int number = 0;
+      if (CommandParser::toInt(grade, number) && number >= 1 && number < LEVELS)
+         return (uint8_t)number;
+      return UNGRADED;
+   }
+
+   for (size_t i = 0; i < sizeof(CONDITIONS) / sizeof(*CONDITIONS); i++) {
+      if (grade == CONDITIONS[i])
+         return (uint8_t)(i + 1);
+   }
+   return UNGRADED;
+}
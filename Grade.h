@@ -0,0 +1,38 @@
+/** @file Grade.h
+ * @author Korosh Moosavi
+ * @date 2026-10-16
+ *
+ * Grade class:
+ * Converts the grade text of a Collectible into an ordinal code on the
+ *   grading scale of its category, so grades compare in the order collectors
+ *   rank them instead of alphabetically.
+ * Coins use the numeric Sheldon scale, "1" (Poor) to "70" (perfect Mint
+ *   State), and the code is the number itself.
+ * Comic books and sports cards use the condition scale
+ *   Poor < Fair < Good < Very Good < Fine < Very Fine < Excellent
+ *   < Near Mint < Mint < Gem Mint, coded 1 to 10.
+ * Code 0 means the grade is not on the scale of its category. Such grades
+ *   sort before every graded item, by their text.
+ *
+ * Assumptions:
+ * Condition names match the scale exactly, including capitalization.
+ */
+#pragma once
+#include <cstdint>
+#include <string_view>
+
+using namespace std;
+
+class Grade {
+public:
+   static const uint8_t UNGRADED = 0;
+   static const int LEVELS = 71;       // Codes 0 to 70, the top Sheldon grade
+
+   /** ----------------------------- code(char, string_view) ----------------
+    * @param symbol Category symbol of the item, 'M' for Coin
+    * @param grade  Grade text as written in the inventory file
+    * @return Place of grade on the scale of the category, higher is better,
+    *           UNGRADED if it is not on the scale.
+    */
+   static uint8_t code(char symbol, string_view grade);
+};
@@ -0,0 +1,51 @@
+/** @file GradeQuery.cpp
+ * @author Korosh Moosavi
+ * @date 2026-10-16
+ *
+ * GradeQuery class:
+ * Class encompassing the store function to output every item of a category
+ *   graded at or above a given grade.
+ *
+ * Assumptions:
+ * Objects used in this method are valid and initialized.
+ */
+#include "GradeQuery.h"
+
+/** ----------------------- process(Inventory&, CustomerRegistry&, Command&, ostream&) ---
+* Parses the category symbol and grade from the command and outputs the
+*   matching items with outputGraded() of Inventory.
+* @param inventory  Inventory storing data on the store's current items.
+* @param registry   Not used, remnant of parent class parameter.
+* @param command    Parsed transaction line, args hold "symbol, grade".
+* @param output     Stream the operation's report is written to.
+* @pre    None
+* @return True once output is complete, false if the category or grade
+*           is not recognized.
+*/
+bool GradeQuery::process(Inventory& inventory, CustomerRegistry& registry, const Command& command,
+                         ostream& output)
+{
+   string_view rest = command.args;
+   string_view symbol = CommandParser::nextField(rest);
+   string_view grade = CommandParser::nextField(rest);
+
+   if (symbol.size() != 1 || grade.empty() || !rest.empty()) {
+      cerr << "Invalid grade query entered.\n\n";
+      return false;
+   }
+   if (!Factory::isRecognized(symbol[0])) {
+      cerr << "Unrecognized Collectible entered.\n\n";
+      return false;
+   }
+
+   uint8_t minimum = Grade::code(symbol[0], grade);
+   if (minimum == Grade::UNGRADED) {
+      cerr << "Unrecognized grade entered.\n\n";
+      return false;
+   }
+
+   output << "Items graded " << grade << " or better:\n";
+   inventory.outputGraded(symbol[0], minimum, output);
+   output << '\n';
+   return true;
+}
@@ -0,0 +1,46 @@
+/** @file GradeQuery.h
+ * @author Korosh Moosavi
+ * @date 2026-10-16
+ *
+ * GradeQuery class:
+ * Class encompassing the store function to output every item of a category
+ *   graded at or above a given grade, such as "G, C, Near Mint" for comic
+ *   books in Near Mint or Mint condition, or "G, M, 60" for coins graded 60
+ *   or better on the Sheldon scale.
+ * Items are read from the grade index of Inventory, see Grade.
+ *
+ * Assumptions:
+ * Objects used in this method are valid and initialized.
+ */
+#include "Transaction.h"
+
+class GradeQuery : public Transaction {
+public:
+   /** ------------------------------ Default constructor ----------------------
+    * No special operations needed.
+    * @pre  None
+    * @post GradeQuery object created.
+    */
+   GradeQuery() {};
+
+   /** ------------------------------ Destructor -------------------------------
+    * No special operations needed.
+    * @pre  None
+    * @post Data is deallocated after destruction.
+    */
+   virtual ~GradeQuery() {};
+
+   /** -------------- process(Inventory&, CustomerRegistry&, Command&, ostream&) ---
+   * Parses the category symbol and grade from the command and outputs the
+   *   matching items with outputGraded() of Inventory.
+   * @param inventory  Inventory storing data on the store's current items.
+   * @param registry   Not used, remnant of parent class parameter.
+   * @param command    Parsed transaction line, args hold "symbol, grade".
+   * @param output     Stream the operation's report is written to.
+   * @pre    None
+   * @return True once output is complete, false if the category or grade
+   *           is not recognized.
+   */
+   bool process(Inventory& inventory, CustomerRegistry& registry, const Command& command,
+                ostream& output);
+};
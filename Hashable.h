@@ -1,102 +1,127 @@
-/** @file Hashable.h
- * @author Korosh Moosavi
- * @date 2021-03-12
- *
- * Hashable class:
- * Abstract class
- * Serves as parent to Collectible and Customer classes
- * Ensures necessary methods are implemented for use in CollectibleStore.
- * 
- * Assumptions:
- * Subclasses will include at least 1 string data member and will be used
- *   within Collectible store and its many data structures
- */
-#pragma once
-#include <iostream>
-#include <iomanip>
-
-using namespace std;
-
-class Hashable {
-private:
-   string name = "NULL_HASHABLE";
-
-public:
-   /** ------------------------------ Default constructor --------------------
-    * Data members are pre-initialized.
-    * @pre  None
-    * @post Hashable object created with identifiable default data value.
-    */
-   Hashable() {};
-
-   /** ------------------------------ Destructor -----------------------------
-    * No special operations needed.
-    * @pre  None
-    * @post Data is deallocated after destruction.
-    */
-   virtual ~Hashable() {};
-
-   /** ----------------------------- hash() ---------------------
-   * Uses data member to return a hash value.
-   * @pre    Data member is valid and initialized.
-   * @return A (hopefully) unique int value.
-   */
-   virtual int hash() = 0;
-
-   /** ----------------------------- operator< ---------------------
-    * Provides sorting priority based on name data member.
-    * @param  rhs  Other Hashable object being compared to.
-    * @pre    Data member is valid and initialized.
-    * @return True if ASCII value of name in this object is lower than that
-    *           of rhs Hashable, false otherwise.
-    */
-   bool operator<(const Hashable& rhs) const { return isLess(rhs); };;
-
-   /** ----------------------------- isLess(Hashable) ---------------------
-    * Main functionality for less-than operator to be implemented in subclasses
-    * @param  rhs  Other Hashable object being compared to.
-    * @pre    Data member is valid and initialized.
-    * @return True if ASCII value of name in this object is lower than that
-    *           of rhs Hashable, false otherwise.
-    */
-   virtual bool isLess(const Hashable& rhs) const = 0;
-
-   /** ------------------- operators == and != ---------------------
-    * Compares two Hashables to see if they are equal.
-    * @param  rhs  Other Hashable object being compared to.
-    * @pre    Data member is valid and initialized.
-    * @return == returns isEqual, != inverts isEqual.
-    */
-   bool operator==(const Hashable& rhs) const { return isEqual(rhs); };
-   bool operator!=(const Hashable& rhs) const { return !(isEqual(rhs)); };
-
-   /** ----------------------------- isEqual(Hashable) ---------------------
-    * Main functionality for equality operator to be implemented in subclasses
-    * @param  rhs  Other Hashable object being compared to.
-    * @pre    Data member is valid and initialized.
-    * @return True if name is equal to rhs name.
-    */
-   virtual bool isEqual(const Hashable& rhs) const = 0;
-
-   /** ----------------------------- print(ostream&) ---------------------
-    * Main functionality of output operator<<
-    * Outputs data on this object in a single, formatted line
-    * @param  output Ostream object passed from operator<< overload below
-    * @pre    Data members are valid and initialized.
-    * @post   Information on this object is output.
-    */
-   virtual void print(ostream& output) const = 0;
-
-   /** ------------------- operator<<(ostream&, Hashable&) -----------------
-    * Uses print() method implemented in subclasses to output object details.
-    * @pre  Data members are valid and initialized.
-    * @post Object details are output in an appropriate way for the subclass.
-    */
-   friend ostream& operator<<(ostream& output, const Hashable& item)
-   {
-      item.print(output);
-      return output;
-   };
-};
-
+/** @file Hashable.h
+ * @author Korosh Moosavi
+ * @date 2021-03-12
+ *
+ * Hashable class:
+ * Abstract class
+ * Serves as parent to Collectible and Customer classes
+ * Ensures necessary methods are implemented for use in CollectibleStore.
+ * Subclasses build a SortKey from their sorting fields when constructed,
+ *   so most comparisons are decided by a few integer compares and only
+ *   ties fall back to isLess() and isEqual().
+ * 
+ * Assumptions:
+ * Subclasses will include at least 1 string data member and will be used
+ *   within Collectible store and its many data structures
+ */
+#pragma once
+#include <iostream>
+#include <iomanip>
+#include "SortKey.h"
+
+using namespace std;
+
+class Hashable {
+private:
+   string name = "NULL_HASHABLE";
+
+protected:
+   SortKey sortKey;     // Packed sorting fields, empty unless set by subclass
+
+public:
+   /** ------------------------------ Default constructor --------------------
+    * Data members are pre-initialized.
+    * @pre  None
+    * @post Hashable object created with identifiable default data value.
+    */
+   Hashable() {};
+
+   /** ------------------------------ Destructor -----------------------------
+    * No special operations needed.
+    * @pre  None
+    * @post Data is deallocated after destruction.
+    */
+   virtual ~Hashable() {};
+
+   /** ----------------------------- hash() ---------------------
+   * Uses data member to return a hash value.
+   * @pre    Data member is valid and initialized.
+   * @return A (hopefully) unique int value.
+   */
+   virtual int hash() = 0;
+
+   /** ----------------------------- getSortKey() ---------------------
+    * @return Packed sorting fields of this object.
+    */
+   const SortKey& getSortKey() const { return sortKey; };
+
+   /** ----------------------------- operator< ---------------------
+    * Provides sorting priority based on name data member.
+    * Decided by the sort keys unless they are equal and incomplete.
+    * @param  rhs  Other Hashable object being compared to.
+    * @pre    Data member is valid and initialized.
+    * @return True if ASCII value of name in this object is lower than that
+    *           of rhs Hashable, false otherwise.
+    */
+   bool operator<(const Hashable& rhs) const
+   {
+      int order = sortKey.compare(rhs.sortKey);
+
+      if (order != 0)
+         return order < 0;
+      return !sortKey.isComplete() && isLess(rhs);
+   };
+
+   /** ----------------------------- isLess(Hashable) ---------------------
+    * Main functionality for less-than operator to be implemented in subclasses
+    * @param  rhs  Other Hashable object being compared to.
+    * @pre    Data member is valid and initialized.
+    * @return True if ASCII value of name in this object is lower than that
+    *           of rhs Hashable, false otherwise.
+    */
+   virtual bool isLess(const Hashable& rhs) const = 0;
+
+   /** ------------------- operators == and != ---------------------
+    * Compares two Hashables to see if they are equal.
+    * Objects with different sort keys are never equal, so isEqual() is
+    *   only called when the keys match.
+    * @param  rhs  Other Hashable object being compared to.
+    * @pre    Data member is valid and initialized.
+    * @return == returns isEqual, != inverts isEqual.
+    */
+   bool operator==(const Hashable& rhs) const
+   {
+      return sortKey.compare(rhs.sortKey) == 0 && isEqual(rhs);
+   };
+   bool operator!=(const Hashable& rhs) const { return !(*this == rhs); };
+
+   /** ----------------------------- isEqual(Hashable) ---------------------
+    * Main functionality for equality operator to be implemented in subclasses
+    * @param  rhs  Other Hashable object being compared to.
+    * @pre    Data member is valid and initialized.
+    * @return True if name is equal to rhs name.
+    */
+   virtual bool isEqual(const Hashable& rhs) const = 0;
+
+   /** ----------------------------- print(ostream&) ---------------------
+    * Main functionality of output operator<<
+    * Outputs data on this object in a single, formatted line
+    * @param  output Ostream object passed from operator<< overload below
+    * @pre    Data members are valid and initialized.
+    * @post   Information on this object is output.
+    */
+   virtual void print(ostream& output) const = 0;
+
+   /** ------------------- operator<<(ostream&, Hashable&) -----------------
+    * Uses print() method implemented in subclasses to output object details.
+    * @pre  Data members are valid and initialized.
+    * @post Object details are output in an appropriate way for the subclass.
+    */
+   friend ostream& operator<<(ostream& output, const Hashable& item)
+   {
+      item.print(output);
+      return output;
+   };
+};
+
 ostream& operator<<(ostream& output, const Hashable& item);
\ No newline at end of file
@@ -0,0 +1,54 @@
+/** @file History.cpp
+ * @author Korosh Moosavi
+ * @date 2026-10-17
+ *
+ * History class:
+ * Class encompassing the store function to output the purchase history
+ *   of all Customer objects within CustomerRegistry, whole or a page at a
+ *   time.
+ *
+ * Assumptions:
+ * Objects used in this method are valid and initialized.
+ */
+#include "History.h"
+
+/** ---------------- process(Inventory&, CustomerRegistry&, Command&, ostream&) ---
+* Uses outputAll() method within CustomerRegistry to output all Customer
+*   transaction data.
+* A page size in the command outputs a single page with outputPage().
+* @param inventory  Not used, remnant of parent class parameter.
+* @param registry   CustomerRegistry object containing customer data.
+* @param command    Parsed transaction line, args are empty or hold
+*                     "limit" or "limit, cursor".
+* @param output     Stream the operation's report is written to.
+* @pre    None, but will not output anything if registry is empty.
+* @return True if the Customers were output, false if Customer tree isn't
+*           initialized or the page size or cursor is not valid
+*/
+bool History::process(Inventory& inventory, CustomerRegistry& registry, const Command& command,
+                      ostream& output)
+{
+   if (command.args.empty())
+      return registry.outputAll(output);
+
+   string_view rest = command.args;
+   int limit = 0;
+   int64_t cursor = -1;
+
+   bool valid = CommandParser::toInt(CommandParser::nextField(rest), limit) && limit > 0;
+   if (valid && !rest.empty())         // Resume cursor
+      valid = CommandParser::toInt(CommandParser::nextField(rest), cursor) && cursor >= 0 &&
+              rest.empty();
+   if (!valid) {
+      cerr << "Invalid history page entered.\n\n";
+      return false;
+   }
+   if (!registry.outputPage(cursor, limit, output)) {
+      cerr << "Unrecognized customer ID entered.\n\n";
+      return false;
+   }
+   if (cursor >= 0)
+      output << "More customers follow, next page: H, " << limit << ", " << cursor << '\n';
+   output << '\n';
+   return true;
+}
@@ -1,42 +1,48 @@
-/** @file History.h
- * @author Korosh Moosavi
- * @date 2021-03-12
- *
- * History class:
- * Class encompassing the store function to output the purchase history
- *   of all Customer objects within CustomerRegistry.
- * 
- * 
- * Assumptions:
- * Objects used in this method are valid and initialized.
- */
-#include "Transaction.h"
-
-class History : public Transaction {
-public:
-   /** ------------------------------ Default constructor ----------------------
-    * No special operations needed.
-    * @pre  None
-    * @post Buy object created.
-    */
-   History() {};
-
-   /** ------------------------------ Destructor -------------------------------
-    * No special operations needed.
-    * @pre  None
-    * @post Data is deallocated after destruction.
-    */
-   virtual ~History() {};
-
-   /** ---------------- process(Inventory&, CustomerRegistry&, string) ---------
-   * Uses outputAll() method within CustomerRegistry to output all Customer
-   *   transaction data.
-   * @param inventory  Not used, remnant of parent class parameter.
-   * @param registry   CustomerRegistry object containing customer data.
-   * @param input      String containing any additional transaction details.
-   * @pre    None, but will not output anything if registry is empty.
-   * @return True if all Customers were output, false if Customer tree isn't initialized
-   */
-   bool process(Inventory& inventory, CustomerRegistry& registry, string input)
-   { return registry.outputAll(); };
-};
+/** @file History.h
+ * @author Korosh Moosavi
+ * @date 2021-03-12
+ *
+ * History class:
+ * Class encompassing the store function to output the purchase history
+ *   of all Customer objects within CustomerRegistry.
+ * "H" outputs every customer. "H, 50" outputs the first 50 customers and
+ *   ends with the command for the next page, such as "H, 50, 123", where
+ *   123 is the ID of the customer the next page resumes at.
+ * 
+ * Assumptions:
+ * Objects used in this method are valid and initialized.
+ */
+#include "Transaction.h"
+
+class History : public Transaction {
+public:
+   /** ------------------------------ Default constructor ----------------------
+    * No special operations needed.
+    * @pre  None
+    * @post Buy object created.
+    */
+   History() {};
+
+   /** ------------------------------ Destructor -------------------------------
+    * No special operations needed.
+    * @pre  None
+    * @post Data is deallocated after destruction.
+    */
+   virtual ~History() {};
+
+   /** ---------------- process(Inventory&, CustomerRegistry&, Command&, ostream&) ---
+   * Uses outputAll() method within CustomerRegistry to output all Customer
+   *   transaction data.
+   * A page size in the command outputs a single page with outputPage().
+   * @param inventory  Not used, remnant of parent class parameter.
+   * @param registry   CustomerRegistry object containing customer data.
+   * @param command    Parsed transaction line, args are empty or hold
+   *                     "limit" or "limit, cursor".
+   * @param output     Stream the operation's report is written to.
+   * @pre    None, but will not output anything if registry is empty.
+   * @return True if the Customers were output, false if Customer tree isn't
+   *           initialized or the page size or cursor is not valid
+   */
+   bool process(Inventory& inventory, CustomerRegistry& registry, const Command& command,
+                ostream& output);
+};
@@ -0,0 +1,266 @@
+/** @file InternPool.cpp
+ * @author Korosh Moosavi
+ * @date 2026-10-16
+ *
+ * InternPool class:
+ * Store-wide table of unique strings, each identified by a dense ID from 0
+ *   to size() - 1.
+ *
+ * Assumptions:
+ * IDs are only passed to get() after intern() returned them, on the same
+ *   thread or one synchronized with it, such as through ThreadPool.
+ * Values are only removed by clear(), the pool lives as long as the program.
+ */
+#include "InternPool.h"
+#include <functional>
+#include <algorithm>
+#include <mutex>
+
+/** ------------------------------ Constructor ----------------------
+ * Creates a pool holding only the empty string.
+ */
+InternPool::InternPool()
+{
+   allocate();
+   intern("");                               // Becomes EMPTY_STRING
+   for (Requests& local : requests) {
+      local.calls = 0;
+      local.bytes = 0;
+   }
+}
+
+/** ------------------------------ Destructor -------------------------------
+ * Frees every stored value.
+ */
+InternPool::~InternPool()
+{
+   release();
+}
+
+/** ------------------------ allocate() --------------------------
+ * Sets up an empty table and block array of their initial sizes.
+ */
+void InternPool::allocate()
+{
+   blockSlots = INITIAL_BLOCKS;
+   blocks = new string*[blockSlots]();
+   count = 0;
+   capacity = INITIAL_CAPACITY;
+   table = new Slot[capacity];
+   for (size_t i = 0; i < capacity; i++)
+      table[i].id = EMPTY;
+}
+
+/** ------------------------ release() --------------------------
+ * Frees every stored value, the table and every block array.
+ */
+void InternPool::release()
+{
+   string** current = blocks.load(memory_order_relaxed);
+
+   for (uint32_t i = 0; i < blockSlots && current[i] != nullptr; i++)
+      delete[] current[i];
+   delete[] current;
+   for (string** old : retired)
+      delete[] old;
+   retired.clear();
+   delete[] table;
+}
+
+/** ----------------------------- clear() ---------------------
+ * Empties the pool back to the state of a new one, holding only the
+ *   empty string, with the request counts reset.
+ * Used to start each benchmark run from a cold pool.
+ * @pre  No ID returned by intern() is still in use, and no other thread
+ *         is using the pool.
+ */
+void InternPool::clear()
+{
+   {
+      unique_lock<shared_mutex> writing(lock);
+      release();
+      allocate();
+   }
+   intern("");                               // Becomes EMPTY_STRING again
+   for (Requests& local : requests) {
+      local.calls = 0;
+      local.bytes = 0;
+   }
+}
+
+/** ----------------------------- shared() ---------------------
+ * @return The pool used by every Collectible.
+ */
+InternPool& InternPool::shared()
+{
+   static InternPool pool;
+   return pool;
+}
+
+/** ----------------------------- stringBytes(size_t) ---------------------
+ * @param length Length of a value
+ * @return Bytes a string of that length takes, including its heap buffer
+ *           when it is too long for the small string buffer.
+ */
+size_t InternPool::stringBytes(size_t length)
+{
+   const size_t SMALL_STRING = 15;   // Characters kept inside the string itself
+   return sizeof(string) + (length > SMALL_STRING ? length + 1 : 0);
+}
+
+/** ----------------------------- countSlot() ---------------------
+ * @return Slot of request counts used by the calling thread, handed out
+ *           in turn the first time a thread calls intern().
+ */
+static size_t countSlot()
+{
+   static atomic<size_t> nextSlot{0};
+   thread_local size_t slot = nextSlot.fetch_add(1, memory_order_relaxed);
+
+   return slot;
+}
+
+/** ----------------------------- locate(string_view, uint32_t) ------------
+ * Follows the probe sequence of a value.
+ * @param value   Text to find
+ * @param hashVal Hash of value
+ * @return The slot holding value, or the empty slot where it belongs
+ */
+InternPool::Slot* InternPool::locate(string_view value, uint32_t hashVal) const
+{
+   size_t mask = capacity - 1;
+
+   for (size_t pos = hashVal & mask; ; pos = (pos + 1) & mask) {
+      Slot* slot = &table[pos];
+      if (slot->id == EMPTY || (slot->hashVal == hashVal && get(slot->id) == value))
+         return slot;
+   }
+}
+
+/** ------------------------ grow() --------------------------
+ * Doubles the capacity of the table and reinserts every ID.
+ */
+void InternPool::grow()
+{
+   Slot* old = table;
+   size_t oldCapacity = capacity;
+
+   capacity *= 2;
+   table = new Slot[capacity];
+   for (size_t i = 0; i < capacity; i++)
+      table[i].id = EMPTY;
+
+   for (size_t i = 0; i < oldCapacity; i++) {
+      if (old[i].id != EMPTY) {
+         size_t pos = old[i].hashVal & (capacity - 1);
+         while (table[pos].id != EMPTY)
+            pos = (pos + 1) & (capacity - 1);
+         table[pos] = old[i];
+      }
+   }
+   delete[] old;
+}
+
+/** ------------------------ growBlocks() --------------------------
+ * Doubles the number of block slots. The old slot array is kept until
+ *   the pool is destroyed, since get() may be reading it without a lock.
+ * Called with the lock held for writing.
+ */
+void InternPool::growBlocks()
+{
+   string** old = blocks.load(memory_order_relaxed);
+   string** grown = new string*[(size_t)blockSlots * 2]();
+
+   copy(old, old + blockSlots, grown);
+   blocks.store(grown, memory_order_release);
+   retired.push_back(old);
+   blockSlots *= 2;
+}
+
+/** ----------------------------- intern(string_view) ---------------------
+ * Finds the ID of a value, adding the value if it is new.
+ * Safe to call from several threads at once. Values already in the pool,
+ *   the common case, only take a shared lock.
+ * @param value Text to intern, copied if new
+ * @return ID of the value, the same for every call with equal text
+ */
+uint32_t InternPool::intern(string_view value)
+{
+   uint32_t hashVal = (uint32_t)hash<string_view>()(value);
+   Requests& local = requests[countSlot() % COUNT_SLOTS];
+
+   local.calls.fetch_add(1, memory_order_relaxed);       // Uncontended line
+   local.bytes.fetch_add(stringBytes(value.size()), memory_order_relaxed);
+
+   {
+      shared_lock<shared_mutex> reading(lock);
+      Slot* found = locate(value, hashVal);
+      if (found->id != EMPTY)
+         return found->id;
+   }
+
+   unique_lock<shared_mutex> writing(lock);
+   if (((size_t)count + 1) * 100 > capacity * MAX_LOAD_PERCENT)
+      grow();
+
+   Slot* slot = locate(value, hashVal);
+   if (slot->id != EMPTY)                    // Added while waiting for the lock
+      return slot->id;
+
+   uint32_t id = count;
+   if (id == EMPTY) {                        // Every ID is taken
+      cerr << "Intern pool is full, " << value << " is stored as an empty string.\n\n";
+      return EMPTY_STRING;
+   }
+   if (id >> BLOCK_BITS >= blockSlots)
+      growBlocks();
+
+   string** current = blocks.load(memory_order_relaxed);
+   if ((id & (BLOCK_SIZE - 1)) == 0)         // Start a new block
+      current[id >> BLOCK_BITS] = new string[BLOCK_SIZE];
+
+   current[id >> BLOCK_BITS][id & (BLOCK_SIZE - 1)] = value;
+   slot->hashVal = hashVal;
+   slot->id = id;
+   count++;
+   return id;
+}
+
+/** ----------------------------- size() ---------------------
+ * @return Number of unique values held.
+ */
+size_t InternPool::size() const
+{
+   shared_lock<shared_mutex> reading(lock);
+   return count;
+}
+
+/** ----------------------------- outputStats(ostream&) ---------------------
+ * Outputs the number of unique values, calls to intern(), and bytes used
+ *   by the pool against bytes the callers would use with their own strings.
+ * @param output Stream to write the statistics to
+ * @pre    None
+ * @post   Statistics are output on a single line
+ */
+void InternPool::outputStats(ostream& output) const
+{
+   shared_lock<shared_mutex> reading(lock);
+   uint64_t calls = 0, withoutPool = 0;
+   uint64_t blocksUsed = (count + BLOCK_SIZE - 1) / BLOCK_SIZE;
+   uint64_t poolBytes = blocksUsed * BLOCK_SIZE * sizeof(string) + blockSlots * sizeof(string*)
+      + capacity * sizeof(Slot);
+
+   for (const Requests& local : requests) {
+      calls += local.calls.load(memory_order_relaxed);
+      withoutPool += local.bytes.load(memory_order_relaxed);
+   }
+   for (uint32_t id = 0; id < count; id++)
+      poolBytes += stringBytes(get(id).size()) - sizeof(string);
+
+   uint64_t withPool = calls * sizeof(uint32_t) + poolBytes;
+
+   output << "Interned strings: " << count << " unique of " << calls
+      << " interned, " << withPool << " bytes instead of " << withoutPool
+      << " (" << (withoutPool > withPool ? withoutPool - withPool : 0)
+      << " saved)" << endl;
+}
@@ -0,0 +1,177 @@
+/** @file InternPool.h
+ * @author Korosh Moosavi
+ * @date 2026-10-16
+ *
+ * InternPool class:
+ * Store-wide table of unique strings, each identified by a dense ID from 0
+ *   to size() - 1.
+ * Collectible fields repeat the same few values across the whole catalog
+ *   (grades, publishers, manufacturers), so items keep the 4-byte ID of
+ *   each value instead of a string of their own, and two values are equal
+ *   exactly when their IDs are.
+ * Strings are stored in fixed-size blocks that never move, so get() needs
+ *   no lock even while other threads intern new values. The array of
+ *   blocks doubles when full and outgrown arrays are kept, so the pool
+ *   holds up to 2^32 - 1 values.
+ * ID 0 is always the empty string, so IDs can default to it without
+ *   interning anything.
+ * Values are found by an open-addressing table of IDs with linear probing,
+ *   the same scheme as ItemIndex, so interning allocates nothing but the
+ *   string itself.
+ * Reports how many values are held and how many bytes interning saved
+ *   compared to every caller keeping its own string.
+ *
+ * Assumptions:
+ * IDs are only passed to get() after intern() returned them, on the same
+ *   thread or one synchronized with it, such as through ThreadPool.
+ * Values are only removed by clear(), the pool lives as long as the program.
+ */
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+class InternPool {
+private:
+   static const int BLOCK_BITS = 12;                  // 4096 values per block
+   static const uint32_t BLOCK_SIZE = 1u << BLOCK_BITS;
+   static const uint32_t INITIAL_BLOCKS = 64;         // Block slots at first
+   static const size_t INITIAL_CAPACITY = 1024;       // Must be a power of 2
+   static const int MAX_LOAD_PERCENT = 70;            // Grow past this load factor
+   static const uint32_t EMPTY = UINT32_MAX;  // Slot holds no ID
+
+   /** ------------------------ Slot struct --------------------------
+    * Entry of the lookup table, id is EMPTY when the slot is unoccupied
+    * The hash is kept to skip most string compares and to grow the table
+    */
+   struct Slot {
+      uint32_t hashVal;
+      uint32_t id;
+   };
+
+   atomic<string**> blocks;                  // blockSlots slots, filled in order
+   uint32_t blockSlots;
+   vector<string**> retired;                 // Outgrown slot arrays, which
+                                             //   readers may still hold
+   uint32_t count;                           // Values stored
+   Slot* table;
+   size_t capacity;
+   mutable shared_mutex lock;                // Guards table and count
+
+   /** ------------------------ Requests struct --------------------------
+    * Calls to intern() and the bytes their values would take as strings,
+    *   kept per thread on a cache line of their own so parse threads never
+    *   write a shared counter
+    * Threads past the first COUNT_SLOTS share a line, so stay atomic
+    */
+   struct alignas(64) Requests {
+      atomic<uint64_t> calls{0};
+      atomic<uint64_t> bytes{0};
+   };
+
+   static const size_t COUNT_SLOTS = 16;              // Threads counted apart
+
+   Requests requests[COUNT_SLOTS];                    // Summed by outputStats()
+
+   /** ----------------------------- stringBytes(size_t) ---------------------
+    * @param length Length of a value
+    * @return Bytes a string of that length takes, including its heap buffer
+    *           when it is too long for the small string buffer.
+    */
+   static size_t stringBytes(size_t length);
+
+   /** ----------------------------- locate(string_view, uint32_t) ------------
+    * Follows the probe sequence of a value.
+    * @param value   Text to find
+    * @param hashVal Hash of value
+    * @return The slot holding value, or the empty slot where it belongs
+    */
+   Slot* locate(string_view value, uint32_t hashVal) const;
+
+   /** ------------------------ grow() --------------------------
+    * Doubles the capacity of the table and reinserts every ID.
+    */
+   void grow();
+
+   /** ------------------------ growBlocks() --------------------------
+    * Doubles the number of block slots. The old slot array is kept until
+    *   the pool is destroyed, since get() may be reading it without a lock.
+    */
+   void growBlocks();
+
+   /** ------------------------ allocate() --------------------------
+    * Sets up an empty table and block array of their initial sizes.
+    */
+   void allocate();
+
+   /** ------------------------ release() --------------------------
+    * Frees every stored value, the table and every block array.
+    */
+   void release();
+
+public:
+   static const uint32_t EMPTY_STRING = 0;
+
+   /** ------------------------------ Constructor ----------------------
+    * Creates a pool holding only the empty string.
+    */
+   InternPool();
+
+   /** ------------------------------ Destructor -------------------------------
+    * Frees every stored value.
+    */
+   ~InternPool();
+
+   InternPool(const InternPool&) = delete;
+   InternPool& operator=(const InternPool&) = delete;
+
+   /** ----------------------------- shared() ---------------------
+    * @return The pool used by every Collectible.
+    */
+   static InternPool& shared();
+
+   /** ----------------------------- clear() ---------------------
+    * Empties the pool back to the state of a new one, holding only the
+    *   empty string, with the request counts reset.
+    * @pre  No ID returned by intern() is still in use, and no other thread
+    *         is using the pool.
+    */
+   void clear();
+
+   /** ----------------------------- intern(string_view) ---------------------
+    * Finds the ID of a value, adding the value if it is new.
+    * Safe to call from several threads at once.
+    * @param value Text to intern, copied if new
+    * @return ID of the value, the same for every call with equal text
+    */
+   uint32_t intern(string_view value);
+
+   /** ----------------------------- get(uint32_t) ---------------------
+    * @param id ID returned by intern()
+    * @return The value with that ID, valid as long as the pool.
+    */
+   const string& get(uint32_t id) const
+   {
+      return blocks.load(memory_order_acquire)[id >> BLOCK_BITS][id & (BLOCK_SIZE - 1)];
+   };
+
+   /** ----------------------------- size() ---------------------
+    * @return Number of unique values held.
+    */
+   size_t size() const;
+
+   /** ----------------------------- outputStats(ostream&) ---------------------
+    * Outputs the number of unique values, calls to intern(), and bytes used
+    *   by the pool against bytes the callers would use with their own strings.
+    * @param output Stream to write the statistics to
+    * @pre    None
+    * @post   Statistics are output on a single line
+    */
+   void outputStats(ostream& output) const;
+};
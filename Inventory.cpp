@@ -1,102 +1,952 @@
-/** @file Inventory.cpp
- * @author Korosh Moosavi
- * @date 2021-03-12
- *
- * Inventory class:
- * Specialized HashTable class used to track inventory of items in
- *   CollectibleStore.
- * Reads from a file containing inventory data to build hash tables
- *   of various collectibles sold in the store.
- *
- * Assumptions:
- * Only Collectible objects and its subclasses will be handled by this class.
- */
-#include "Inventory.h"
-
-
-/** ------------------------------ Constructor ----------------------
-* Uses Factory to construct subclasses of Collectible as needed based on
-*   data in the input file.
-* Adds items to corresponding SearchTrees for easy sorting.
-* @param fileName Name of the input file containing data on store items.
-* @pre  File is pre-formatted and in the same directory.
-* @post All items in the input file are parsed and created (when able) then
-*         added to its corresponding SearchTree within the hash table items[]
-*/
-Inventory::Inventory(string fileName)
-{
-   int size = sizeof(items) / sizeof(*items);
-   Factory factory;
-   ifstream input(fileName);
-   
-   for (int i = 0; i < size; i++)
-      items[i] = nullptr;
-   
-   while (input.peek() != EOF) {
-      string fileInput;
-      getline(input, fileInput);
-      Collectible* temp = factory.create(fileInput);
-      
-      if (temp == nullptr)                      // Collectible creation failed
-         continue;
-
-      if (items[temp->hash()] == nullptr)       // If one doesn't already exist,
-         items[temp->hash()] = new SearchTree;  //   create a tree for this object
-      
-      (*items[temp->hash()]).insert(temp);      // Insert object into its tree
-   }
-}
-
-/** ------------------------------ Destructor -------------------------------
-* Every object in the table is deleted from memory.
-* @pre  None
-* @post Data is deallocated after destruction.
-*/
-Inventory::~Inventory()
-{
-   for (int i = 0; i < sizeof(items) / sizeof(*items); i++) {
-      if (items[i] != nullptr) {
-         delete items[i];
-         items[i] = nullptr;
-      }
-   }
-}
-
-/** ----------------------------- updateInventory() ---------------------
-* Changes the stock count of an item by the amount indicated.
-* The current implementation only uses +1 and -1 for change.
-* @param item   Collectible object to update.
-* @param change Amount to change the stock count by. Note that this is a
-*                 change amount, not an absolute amount.
-* @pre          Parameter item already exists in Inventory.
-* @post         Stock count of item is increased by amount indicated
-*                 (decreased if negative).
-* @return       Returns true on successful execution, false on failure.
-*/
-bool Inventory::updateInventory(Collectible* item, int change)
-{
-   Collectible* temp = static_cast<Collectible*>((*items[item->hash()]).retrieve(item));
-  
-   if (temp == nullptr)                // Invalid object passed as item parameter
-      return false;
-   
-   else
-      return temp->updateStock(change);// True on success, false on failure
-}
-
-/** ----------------------------- outputAll() ---------------------
-* Traverses each tree in-order and outputs each item.
-* Tree priority is Coin -> Comic Book -> Sports Card
-* @pre      None.
-* @post     Details on each item stored is output in order, including items
-*             with zero stock count.
-* @return   True after all nodes of each tree have been visited.
-*/
-bool Inventory::outputAll()
-{
-   for (int i = 0; i < Collectible::UNIQUES; i++) {
-      if(items[i] != nullptr)
-         cout << (*items[i]) << endl;
-   }
-   return true;
-}
+/** @file Inventory.cpp
+ * @author Korosh Moosavi
+ * @date 2021-03-12
+ *
+ * Inventory class:
+ * Specialized HashTable class used to track inventory of items in
+ *   CollectibleStore.
+ * Reads from a file containing inventory data to build hash tables
+ *   of various collectibles sold in the store.
+ * Items are kept in two structures: a SearchTree per category for ordered
+ *   output, and an ItemIndex over all categories for stock lookups.
+ * Items are allocated in Arenas owned by the Inventory and tree nodes in
+ *   Arenas owned by each SearchTree, so both are laid out in file order and
+ *   released together.
+ * The whole inventory, stock included, can be saved to a Snapshot and
+ *   rebuilt from it without parsing or comparing any item.
+ * The full display is cached. Each item keeps its rendered line until its
+ *   stock changes, and the whole display is reused as long as no stock has
+ *   changed since it was rendered.
+ * The display can also be paged through, resuming at an item ID.
+ * Ranges of the sort order of a category are found with a single search.
+ * Secondary indexes list the items of each category by name and by type.
+ * Items in stock are tracked by a bitmap in display order, kept up to date
+ *   by every stock change that crosses zero.
+ *
+ * Assumptions:
+ * Only Collectible objects and its subclasses will be handled by this class.
+ */
+#include "Inventory.h"
+#include <algorithm>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Bytes of an item in a Snapshot: symbol, grade code, stock, year and the
+//   IDs of its name, type and grade
+static const size_t SAVED_ITEM_BYTES = 2 * sizeof(uint8_t) + 5 * sizeof(uint32_t);
+
+/** ------------------------------ Constructor ----------------------
+* Uses Factory to construct subclasses of Collectible as needed based on
+*   data in the input file.
+* The file is memory mapped and each line is parsed in place, without
+*   being copied.
+* Adds items to corresponding SearchTrees for easy sorting, and to the
+*   ItemIndex for lookups. Duplicate items are discarded.
+* Stocked items are given item IDs 0 to item count - 1.
+* @param fileName Name of the input file containing data on store items.
+* @pre  File is pre-formatted and in the same directory.
+* @post All items in the input file are parsed and created (when able) then
+*         added to its corresponding SearchTree within the hash table items[]
+*/
+Inventory::Inventory(string fileName)
+{
+   int size = sizeof(items) / sizeof(*items);
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   MappedFile input(fileName);
+   string_view unread = input.contents();
+   
+   for (int i = 0; i < size; i++)
+      items[i] = nullptr;
+   itemArenas.push_back(new Arena);
+   
+   while (!unread.empty()) {
+      string_view fileInput = MappedFile::nextLine(unread);
+      if (fileInput.empty())
+         continue;
+
+      loadStats.records++;
+      Collectible* temp = Factory::create(fileInput, itemArenas[0]);
+      
+      if (temp == nullptr || !stock(temp))      // Creation failed, or already
+         continue;                              //   stocked and the arena
+                                                //   releases it later
+      if (items[temp->hash()] == nullptr)       // If one doesn't already exist,
+         items[temp->hash()] = new SearchTree(false); // create a tree for this object
+      (*items[temp->hash()]).insert(temp);      // Never a repeat, stock()
+   }                                            //   rejected those
+   sortGraded();
+   buildFields();
+   buildOrder();
+
+   loadStats.bytes = input.size();
+   loadStats.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+/** ------------------------------ Parallel constructor ----------------------
+* Builds the same Inventory as Inventory(string) using a ThreadPool.
+* The file is split into chunks that are parsed concurrently. Items are
+*   then stocked in file order, so they get the same item IDs as with
+*   Inventory(string) whatever the number of chunks, and the SearchTree of
+*   each category is built concurrently from its stocked items.
+* @param fileName Name of the input file containing data on store items.
+* @param pool     Workers to parse and build with.
+* @pre  File is pre-formatted and in the same directory.
+*       Not called from a task running on pool.
+* @post All items in the input file are parsed and created (when able) then
+*         added to its corresponding SearchTree within the hash table items[]
+*/
+Inventory::Inventory(string fileName, ThreadPool& pool)
+{
+   const int size = sizeof(items) / sizeof(*items);
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   MappedFile input(fileName);
+   vector<string_view> chunks = MappedFile::splitLines(input.contents(), pool.size() * 4);
+   vector<vector<Collectible*>> parsed(chunks.size());   // In file order
+   vector<vector<Collectible*>> sorted(size);            // Stocked, by tree
+   vector<uint64_t> records(chunks.size(), 0);
+
+   for (int i = 0; i < size; i++)
+      items[i] = nullptr;
+   for (size_t chunk = 0; chunk < chunks.size(); chunk++)
+      itemArenas.push_back(new Arena);            // One per chunk, no locking
+
+   pool.parallelFor(chunks.size(), [&](size_t chunk) {         // Parse chunks
+      string_view unread = chunks[chunk];
+
+      while (!unread.empty()) {
+         string_view fileInput = MappedFile::nextLine(unread);
+         if (fileInput.empty())
+            continue;
+
+         records[chunk]++;
+         Collectible* temp = Factory::create(fileInput, itemArenas[chunk]);
+         if (temp != nullptr)                   // Collectible creation succeeded
+            parsed[chunk].push_back(temp);
+      }
+   });
+
+   size_t total = 0;
+   for (const vector<Collectible*>& chunk : parsed)
+      total += chunk.size();
+   index.reserve(total);
+   stocked.reserve(total);
+
+   for (const vector<Collectible*>& chunk : parsed) {          // Stock in order
+      for (Collectible* temp : chunk) {
+         if (stock(temp))                       // Else already stocked, it is
+            sorted[temp->hash()].push_back(temp);   //   released with its arena
+      }
+   }
+
+   vector<int> trees;                           // Trees needed by this file
+   for (int i = 0; i < size; i++) {
+      if (!sorted[i].empty()) {
+         items[i] = new SearchTree(false);
+         trees.push_back(i);
+      }
+   }
+
+   pool.parallelFor(trees.size(), [&](size_t tree) {           // Build trees
+      int i = trees[tree];
+
+      for (Collectible* temp : sorted[i])       // Never a repeat, stock()
+         (*items[i]).insert(temp);              //   rejected those
+   });
+   sortGraded();
+   buildFields();
+   buildOrder();
+
+   for (uint64_t count : records)
+      loadStats.records += count;
+   loadStats.bytes = input.size();
+   loadStats.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+/** ------------------------------ Snapshot constructor ----------------------
+* Rebuilds an Inventory saved by save(Snapshot&), with the same items,
+*   item IDs and stock. Each SearchTree is built directly from its saved
+*   order, only checking each item sorts after the one before it.
+* Saved strings are interned again and the items remapped to their new IDs,
+*   in case the pool already held other strings.
+* @param snapshot Snapshot being read, positioned where save() started.
+* @pre  None
+* @post Every saved item is restored, unless snapshot turns out to be
+*         invalid, such as when it holds an item twice or a tree out of
+*         order, in which case the Inventory should be discarded.
+*/
+Inventory::Inventory(Snapshot& snapshot)
+{
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   size_t first = snapshot.position();
+   InternPool& pool = InternPool::shared();
+
+   for (int i = 0; i < Collectible::UNIQUES; i++)
+      items[i] = nullptr;
+   itemArenas.push_back(new Arena);
+
+   uint32_t strings = snapshot.get<uint32_t>();
+   vector<uint32_t> stringIds;
+   if (snapshot.fits(strings, sizeof(uint32_t)))
+      stringIds.reserve(strings);
+   for (uint32_t i = 0; i < strings && snapshot.isValid(); i++)
+      stringIds.push_back(pool.intern(snapshot.getString()));
+
+   uint32_t count = snapshot.get<uint32_t>();
+   if (snapshot.fits(count, SAVED_ITEM_BYTES)) {
+      index.reserve(count);
+      stocked.reserve(count);
+   }
+   for (uint32_t i = 0; i < count && snapshot.isValid(); i++) {
+      StoredItem stored;
+      stored.symbol = snapshot.get<char>();
+      stored.gradeCode = snapshot.get<uint8_t>();
+      stored.stock = snapshot.get<int32_t>();
+      stored.year = snapshot.get<int32_t>();
+      stored.nameId = snapshot.get<uint32_t>();
+      stored.typeId = snapshot.get<uint32_t>();
+      stored.gradeId = snapshot.get<uint32_t>();
+
+      if (stored.nameId >= strings || stored.typeId >= strings || stored.gradeId >= strings) {
+         snapshot.invalidate();
+         break;
+      }
+      stored.nameId = stringIds[stored.nameId];
+      stored.typeId = stringIds[stored.typeId];
+      stored.gradeId = stringIds[stored.gradeId];
+
+      Collectible* temp = Factory::create(stored, itemArenas[0]);
+      if (temp == nullptr) {
+         snapshot.invalidate();
+         break;
+      }
+      if (!index.insert(temp)) {                // Same item saved twice
+         snapshot.invalidate();
+         break;
+      }
+      temp->setItemId(i);
+      stocked.push_back(temp);
+   }
+
+   uint32_t trees = snapshot.get<uint32_t>();
+   vector<Hashable*> sorted;
+   for (uint32_t tree = 0; tree < trees && snapshot.isValid(); tree++) {
+      uint32_t slot = snapshot.get<uint32_t>();
+      uint32_t size = snapshot.get<uint32_t>();
+
+      if (slot >= Collectible::UNIQUES || items[slot] != nullptr ||
+          !snapshot.fits(size, sizeof(uint32_t))) {
+         snapshot.invalidate();
+         break;
+      }
+      sorted.clear();
+      for (uint32_t i = 0; i < size; i++) {
+         uint32_t itemId = snapshot.get<uint32_t>();
+         if (itemId >= stocked.size() || stocked[itemId]->hash() != (int)slot
+             || (!sorted.empty() && !(*sorted.back() < *stocked[itemId]))) {
+            snapshot.invalidate();
+            break;
+         }
+         sorted.push_back(stocked[itemId]);
+      }
+      if (!snapshot.isValid())
+         break;
+
+      items[slot] = new SearchTree(false);
+      items[slot]->build(sorted);
+      for (Hashable* item : sorted)             // Already in tree order, so
+         addGraded(static_cast<Collectible*>(item));   //   nothing to sort
+   }
+   buildFields();
+   buildOrder();
+
+   loadStats.records = count;
+   loadStats.bytes = snapshot.position() - first;
+   loadStats.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+/** ------------------------------ Destructor -------------------------------
+* Every tree is deleted, then every item is released with its Arena.
+* @pre  None
+* @post Data is deallocated after destruction.
+*/
+Inventory::~Inventory()
+{
+   for (size_t i = 0; i < sizeof(items) / sizeof(*items); i++) {
+      if (items[i] != nullptr) {
+         delete items[i];
+         items[i] = nullptr;
+      }
+   }
+   for (Arena* arena : itemArenas)
+      delete arena;
+   itemArenas.clear();
+}
+
+/** ----------------------------- stock(Collectible*) ---------------------
+* Adds an item to the lookup index, then gives it the next item ID and
+*   adds it to the grade index, unless an equal item is already stocked.
+* The caller adds stocked items to their SearchTree.
+* @param item Item just parsed
+* @return True if the item was stocked, false if it is a repeat
+*/
+bool Inventory::stock(Collectible* item)
+{
+   if (!index.insert(item))            // Equal item already stocked
+      return false;
+   item->setItemId((uint32_t)stocked.size());
+   stocked.push_back(item);
+   addGraded(item);
+   return true;
+}
+
+/** ----------------------------- fingerprint() ---------------------
+* @return Hash of the composite key of every item in item ID order, so
+*           inventories that give different IDs to their items almost
+*           surely differ. Stock is left out.
+*/
+uint64_t Inventory::fingerprint() const
+{
+   uint64_t hashVal = 14695981039346656037ull ^ stocked.size();
+
+   for (const Collectible* item : stocked) {
+      hashVal ^= ItemIndex::hashKey(item->getSymbol(), item->getYear(), item->getGrade(),
+                                    item->getName(), item->getType());
+      hashVal *= 1099511628211ull;
+   }
+   return hashVal;
+}
+
+/** ----------------------------- save(Snapshot&) ---------------------
+* Adds the interned strings, every item in item ID order, and the order
+*   of each SearchTree, by its slot in items[], to a snapshot being written.
+* @param snapshot Snapshot being written.
+* @pre      No transaction is being processed.
+* @post     The Inventory can be rebuilt by the Snapshot constructor.
+*/
+void Inventory::save(Snapshot& snapshot) const
+{
+   const InternPool& pool = InternPool::shared();
+   uint32_t strings = (uint32_t)pool.size();
+
+   snapshot.put(strings);
+   for (uint32_t id = 0; id < strings; id++)
+      snapshot.putString(pool.get(id));
+
+   snapshot.put((uint32_t)stocked.size());
+   for (const Collectible* item : stocked) {
+      StoredItem stored = item->getStored();
+      snapshot.put(stored.symbol);
+      snapshot.put(stored.gradeCode);
+      snapshot.put(stored.stock);
+      snapshot.put(stored.year);
+      snapshot.put(stored.nameId);
+      snapshot.put(stored.typeId);
+      snapshot.put(stored.gradeId);
+   }
+
+   uint32_t trees = 0;
+   for (int i = 0; i < Collectible::UNIQUES; i++)
+      trees += items[i] != nullptr;
+   snapshot.put(trees);
+
+   vector<Hashable*> sorted;
+   for (int i = 0; i < Collectible::UNIQUES; i++) {
+      if (items[i] == nullptr)
+         continue;
+      sorted.clear();
+      items[i]->collect(sorted);
+      snapshot.put((uint32_t)i);
+      snapshot.put((uint32_t)sorted.size());
+      for (const Hashable* item : sorted)
+         snapshot.put(static_cast<const Collectible*>(item)->getItemId());
+   }
+}
+
+/** ----------------------------- addGraded(Collectible*) ---------------
+* Adds a stocked item to the grade index if its grade is on its scale.
+* Items are added in file order, which sortGraded() keeps for items of
+*   equal sorting priority, as their SearchTree does.
+* @param item Item just added to the lookup index
+*/
+void Inventory::addGraded(Collectible* item)
+{
+   if (item->getGradeCode() == Grade::UNGRADED)
+      return;
+
+   vector<vector<Collectible*>>& scale = graded[item->getSymbol() - '@'];
+   if (scale.empty())
+      scale.resize(Grade::LEVELS);
+   scale[item->getGradeCode()].push_back(item);
+}
+
+/** ----------------------------- sortGraded() ---------------------
+* Sorts every list of the grade index once loading is done.
+*/
+void Inventory::sortGraded()
+{
+   for (vector<vector<Collectible*>>& scale : graded) {
+      for (vector<Collectible*>& level : scale)
+         stable_sort(level.begin(), level.end(),
+                     [](const Collectible* a, const Collectible* b) { return *a < *b; });
+   }
+}
+
+/** ----------------------------- outputPage(int64_t&, size_t, ostream&) ---
+* Outputs a page of the display, starting at an item and walking each
+*   tree from there with a SearchTree::Iterator, so a page costs
+*   O(log n + limit) wherever it starts.
+* Categories are separated by a blank line, like in outputAll().
+* @param cursor Item ID to start at, -1 for the first item. Set to the item
+*                 ID the next page starts at, -1 once every item is output.
+* @param limit  Most items to output.
+* @param output Stream to write the items to.
+* @pre      None.
+* @post     Up to limit items are output, including items with zero stock.
+* @return   True once the page is output, false if cursor is not an item.
+*/
+bool Inventory::outputPage(int64_t& cursor, size_t limit, ostream& output) const
+{
+   Collectible* from = nullptr;
+   int first = 0;
+
+   if (cursor >= 0) {
+      if (cursor >= (int64_t)stocked.size())
+         return false;
+      from = stocked[cursor];
+      first = from->hash();
+   }
+
+   for (int i = first; i < Collectible::UNIQUES; i++) {
+      if (items[i] == nullptr)
+         continue;
+      SearchTree::Iterator cur = from != nullptr ? items[i]->seek(from) : items[i]->begin();
+      from = nullptr;                  // Later categories start at the top
+
+      for (; cur != items[i]->end(); ++cur) {
+         Collectible* item = static_cast<Collectible*>(*cur);
+         if (limit == 0) {             // Page is full, resume here
+            cursor = item->getItemId();
+            return true;
+         }
+         output << *item << '\n';
+         limit--;
+      }
+      output << '\n';                  // End of a category
+   }
+   cursor = -1;
+   return true;
+}
+
+/** ----------------------------- buildFields() ---------------------
+* Builds the name and type indexes once loading is done.
+* Each category is listed in tree order and then stable sorted by the
+*   field, so items with equal fields stay sorted like their SearchTree
+*   without being compared.
+*/
+void Inventory::buildFields()
+{
+   for (int i = 0; i < Collectible::UNIQUES; i++) {
+      named[i].clear();
+      if (items[i] == nullptr)
+         continue;
+      for (SearchTree::Iterator cur = items[i]->begin(); cur != items[i]->end(); ++cur)
+         named[i].push_back(static_cast<Collectible*>(*cur));
+      typed[i] = named[i];
+
+      for (int field : { NAME, TYPE }) {
+         vector<Collectible*>& list = field == NAME ? named[i] : typed[i];
+         stable_sort(list.begin(), list.end(), [field](const Collectible* a, const Collectible* b) {
+            return getField(a, field) < getField(b, field);
+         });
+      }
+   }
+}
+
+/** ----------------------------- buildOrder() ---------------------
+* Ranks every item in display order and marks the items in stock, once
+*   loading is done.
+*/
+void Inventory::buildOrder()
+{
+   ordered.clear();
+   rankOf.assign(stocked.size(), 0);
+   for (int i = 0; i < Collectible::UNIQUES; i++) {
+      rankBegin[i] = (uint32_t)ordered.size();
+      if (items[i] != nullptr) {
+         for (SearchTree::Iterator cur = items[i]->begin(); cur != items[i]->end(); ++cur) {
+            Collectible* item = static_cast<Collectible*>(*cur);
+            rankOf[item->getItemId()] = (uint32_t)ordered.size();
+            ordered.push_back(item);
+         }
+      }
+      rankEnd[i] = (uint32_t)ordered.size();
+   }
+
+   size_t words = (ordered.size() + 63) / 64;
+   vector<atomic<uint64_t>>(words).swap(inStock);
+   vector<atomic<uint64_t>>((words + 63) / 64).swap(inStockWords);
+   for (size_t rank = 0; rank < ordered.size(); rank++) {
+      if (ordered[rank]->getStock() > 0) {
+         inStock[rank / 64].fetch_or(1ull << (rank % 64), memory_order_relaxed);
+         inStockWords[rank / 4096].fetch_or(1ull << (rank / 64 % 64), memory_order_relaxed);
+      }
+   }
+}
+
+/** ----------------------------- changeStock(Collectible*, int) ---------
+* Changes the stock of a stocked item, then updates the display version
+*   and, if the stock crossed zero, the in-stock bitmap.
+* Buys and sells of the same item can run at once, so the bit is not set
+*   from the old stock. Each update reads the stock after its own change,
+*   makes the bit agree with it, and reads the stock again after a fence,
+*   repeating if it changed sides meanwhile. Of two updates racing to set
+*   and clear a bit, the one to set the bit last always reads the stock
+*   written by the other, so the bit ends up matching the final stock.
+* @param item   Item to update.
+* @param change Amount to change the stock count by.
+* @return True if the stock was changed without going below 0.
+*/
+bool Inventory::changeStock(Collectible* item, int change)
+{
+   if (!item->updateStock(change))
+      return false;
+   version.fetch_add(1, memory_order_relaxed);
+
+   uint32_t rank = rankOf[item->getItemId()];
+   atomic<uint64_t>& word = inStock[rank / 64];
+   uint64_t bit = 1ull << (rank % 64);
+   bool want;
+
+   atomic_thread_fence(memory_order_seq_cst);
+   do {
+      want = item->getStock() > 0;
+      if (((word.load(memory_order_relaxed) & bit) != 0) != want) {
+         if (!want)
+            word.fetch_and(~bit, memory_order_acq_rel);
+         else if (word.fetch_or(bit, memory_order_acq_rel) == 0)
+            inStockWords[rank / 4096].fetch_or(1ull << (rank / 64 % 64), memory_order_relaxed);
+      }
+      atomic_thread_fence(memory_order_seq_cst);
+   } while ((item->getStock() > 0) != want);
+   return true;
+}
+
+/** ----------------------------- lowestBit(uint64_t) ---------------------
+* @param bits Word with at least one bit set
+* @return Position of the lowest bit set in bits
+*/
+static int lowestBit(uint64_t bits)
+{
+#ifdef _MSC_VER
+   unsigned long position;
+   _BitScanForward64(&position, bits);
+   return (int)position;
+#else
+   return __builtin_ctzll(bits);
+#endif
+}
+
+/** ----------------------------- nextInStock(uint32_t, uint32_t) --------
+* Finds the next item in stock in display order, skipping 4096 sold out
+*   items at a time where possible. A summary bit found over an empty word
+*   is cleared, which is safe since no stock is being changed.
+* @param rank First rank to check.
+* @param end  Rank to stop at.
+* @return Rank of the first item in stock from rank on, end if none
+*           is before it.
+* @pre    No stock is being changed, such as while a display runs alone.
+*/
+uint32_t Inventory::nextInStock(uint32_t rank, uint32_t end) const
+{
+   while (rank < end) {
+      size_t wordAt = rank / 64;
+      uint64_t summary = inStockWords[wordAt / 64].load(memory_order_relaxed)
+         & (~0ull << (wordAt % 64));
+
+      if (summary == 0) {              // Nothing in stock up to the next 4096
+         rank = (uint32_t)((wordAt / 64 + 1) * 4096);
+         continue;
+      }
+      size_t nextWord = wordAt / 64 * 64 + lowestBit(summary);
+      if (nextWord != wordAt)
+         rank = (uint32_t)(nextWord * 64);
+
+      uint64_t bits = inStock[nextWord].load(memory_order_relaxed) & (~0ull << (rank % 64));
+      if (bits != 0)
+         return min((uint32_t)(nextWord * 64 + lowestBit(bits)), end);
+      if (inStock[nextWord].load(memory_order_relaxed) == 0)    // Sold out since
+         inStockWords[nextWord / 64].fetch_and(~(1ull << (nextWord % 64)), memory_order_relaxed);
+      rank = (uint32_t)((nextWord + 1) * 64);
+   }
+   return end;
+}
+
+/** ----------------------------- outputMatching(Field, string_view, bool, ostream&)
+* Outputs every item whose name or type is value, or starts with it,
+*   read from the name or type index with a binary search in each
+*   category, so the cost is O(log n + k) for k matching items.
+* @param field  Index to search, NAME or TYPE.
+* @param value  Name or type to find.
+* @param prefix True to match every name or type starting with value.
+* @param output Stream to write the items to.
+* @pre      None.
+* @post     Matching items are output one per line, Coin -> Comic Book ->
+*             Sports Card, then by field and like their SearchTree,
+*             including items with zero stock count.
+*/
+void Inventory::outputMatching(Field field, string_view value, bool prefix, ostream& output) const
+{
+   for (const vector<Collectible*>& list : field == NAME ? named : typed) {
+      vector<Collectible*>::const_iterator cur = lower_bound(list.begin(), list.end(), value,
+         [field](const Collectible* item, string_view key) { return getField(item, field) < key; });
+
+      for (; cur != list.end(); ++cur) {
+         string_view found = getField(*cur, field);
+         if (prefix)
+            found = found.substr(0, value.size());
+         if (found != value)           // Past the last match
+            break;
+         output << **cur << '\n';
+      }
+   }
+}
+
+/** ----------------------------- findCategory(char) ---------------------
+* @param symbol Category symbol of the items
+* @return Tree holding the items of the category, nullptr if it has none
+*/
+const SearchTree* Inventory::findCategory(char symbol) const
+{
+   for (int i = 0; i < Collectible::UNIQUES; i++) {
+      if (items[i] != nullptr && !items[i]->isEmpty() &&
+          static_cast<const Collectible*>(*items[i]->begin())->getSymbol() == symbol)
+         return items[i];
+   }
+   return nullptr;
+}
+
+/** ----------------------------- getSortTextFields(char) ----------------
+* @param symbol Category symbol of the items
+* @return Number of text fields the category is sorted by before the
+*           year, 0 if it has no items
+*/
+int Inventory::getSortTextFields(char symbol) const
+{
+   const SearchTree* tree = findCategory(symbol);
+   string_view fields[Collectible::SORT_TEXT_FIELDS];
+
+   if (tree == nullptr)
+      return 0;
+   return static_cast<const Collectible*>(*tree->begin())->getSortText(fields);
+}
+
+/** ----------------------------- rangeOrder(ItemRange&, Collectible&) -----
+* Compares the fields of item the way isLess() does, so the result only
+*   grows along the tree. A prefix compares only as many characters as it
+*   has, which keeps that order.
+* @param range Range of the category of item
+* @param item  Item to place
+* @return Negative if item sorts before range, positive if after it, 0 if
+*           it is in range
+*/
+int Inventory::rangeOrder(const ItemRange& range, const Collectible& item)
+{
+   string_view fields[Collectible::SORT_TEXT_FIELDS];
+   int count = item.getSortText(fields);
+
+   for (int i = 0; i < range.count; i++) {
+      string_view field = fields[i];
+      if (range.prefix && i == range.count - 1)
+         field = field.substr(0, range.fields[i].size());
+
+      int order = field.compare(range.fields[i]);
+      if (order != 0)
+         return order;
+   }
+   if (range.count < count)            // Years are not in order yet
+      return 0;
+   if (item.getYear() < range.firstYear)
+      return -1;
+   return item.getYear() > range.lastYear ? 1 : 0;
+}
+
+/** ----------------------------- outputRange(ItemRange&, ostream&) -------
+* Outputs every item of a range of the sort order of a category, found
+*   with one search of its SearchTree, so the cost is O(log n + k) for
+*   k items in range.
+* @param range  Items to output, see ItemRange.
+* @param output Stream to write the items to.
+* @pre      range does not hold more text fields than its category, and
+*             only bounds years if it matches every text field in full.
+* @post     Items in range are output one per line in tree order,
+*             including items with zero stock count.
+*/
+void Inventory::outputRange(const ItemRange& range, ostream& output) const
+{
+   const SearchTree* tree = findCategory(range.symbol);
+   if (tree == nullptr)
+      return;
+
+   SearchTree::Iterator cur = tree->seek([&range](const Hashable& item) {
+      return rangeOrder(range, static_cast<const Collectible&>(item)) < 0;
+   });
+   for (; cur != tree->end(); ++cur) {
+      const Collectible* item = static_cast<const Collectible*>(*cur);
+      if (rangeOrder(range, *item) > 0)   // Past the end of the range
+         break;
+      output << *item << '\n';
+   }
+}
+
+/** ----------------------------- outputRangeInStock(ItemRange&, ostream&) -
+* Outputs the items of a range of the sort order of a category that are
+*   in stock. The range is found with two searches of its SearchTree, and
+*   its items in stock are read from the in-stock bitmap, so the cost is
+*   O(log n + k) for k items of the range in stock.
+* @param range  Items to output, see ItemRange.
+* @param output Stream to write the items to.
+* @pre      Same as outputRange(), and no stock is being changed.
+* @post     Items in range with stock are output one per line in tree order.
+*/
+void Inventory::outputRangeInStock(const ItemRange& range, ostream& output) const
+{
+   const SearchTree* tree = findCategory(range.symbol);
+   if (tree == nullptr)
+      return;
+
+   SearchTree::Iterator first = tree->seek([&range](const Hashable& item) {
+      return rangeOrder(range, static_cast<const Collectible&>(item)) < 0;
+   });
+   SearchTree::Iterator last = tree->seek([&range](const Hashable& item) {
+      return rangeOrder(range, static_cast<const Collectible&>(item)) <= 0;
+   });
+   if (first == last)
+      return;
+
+   uint32_t rank = rankOf[static_cast<const Collectible*>(*first)->getItemId()];
+   uint32_t end = last == tree->end() ? rankEnd[ordered[rank]->hash()]
+      : rankOf[static_cast<const Collectible*>(*last)->getItemId()];
+
+   for (rank = nextInStock(rank, end); rank < end; rank = nextInStock(rank + 1, end))
+      output << *ordered[rank] << '\n';
+}
+
+/** ----------------------------- outputInStock(int64_t&, size_t, ostream&)
+* Outputs a page of the display limited to items in stock, read from the
+*   in-stock bitmap, so a page costs O(limit) no matter how many sold out
+*   items it skips.
+* Categories are separated by a blank line, like in outputAll().
+* @param cursor Item ID to start at, -1 for the first item. Set to the item
+*                 ID the next page starts at, -1 once every item is output.
+* @param limit  Most items to output.
+* @param output Stream to write the items to.
+* @pre      No stock is being changed.
+* @post     Up to limit items with stock are output.
+* @return   True once the page is output, false if cursor is not an item.
+*/
+bool Inventory::outputInStock(int64_t& cursor, size_t limit, ostream& output) const
+{
+   uint32_t rank = 0;
+   int first = 0;
+
+   if (cursor >= 0) {
+      if (cursor >= (int64_t)stocked.size())
+         return false;
+      rank = rankOf[cursor];
+      first = stocked[cursor]->hash();
+   }
+
+   for (int i = first; i < Collectible::UNIQUES; i++) {
+      if (items[i] == nullptr)
+         continue;
+      rank = max(rank, rankBegin[i]);
+      for (rank = nextInStock(rank, rankEnd[i]); rank < rankEnd[i];
+           rank = nextInStock(rank + 1, rankEnd[i])) {
+         if (limit == 0) {             // Page is full, resume here
+            cursor = ordered[rank]->getItemId();
+            return true;
+         }
+         output << *ordered[rank] << '\n';
+         limit--;
+      }
+      output << '\n';                  // End of a category
+   }
+   cursor = -1;
+   return true;
+}
+
+/** ----------------------------- outputGraded(char, uint8_t, ostream&) ----
+* Outputs every item of a category graded at or above a grade, read from
+*   the grade index instead of scanning the category.
+* Items are listed from the lowest qualifying grade up, and in tree order
+*   within a grade.
+* @param symbol  Category symbol of the items
+* @param minimum Lowest grade code to output, see Grade
+* @param output  Stream to write the items to.
+* @pre      symbol is recognized by Factory.
+* @post     Matching items are output one per line, including items
+*             with zero stock count.
+*/
+void Inventory::outputGraded(char symbol, uint8_t minimum, ostream& output) const
+{
+   const vector<vector<Collectible*>>& scale = graded[symbol - '@'];
+
+   for (size_t level = minimum; level < scale.size(); level++) {
+      for (const Collectible* item : scale[level])
+         output << *item << '\n';
+   }
+}
+
+/** ----------------------------- outputMemoryStats(ostream&) --------------
+* Outputs bytes used and reserved by the Arenas of tree nodes and items.
+* @param output Stream to write the statistics to.
+* @pre      None.
+* @post     Statistics are output on a single line.
+*/
+void Inventory::outputMemoryStats(ostream& output) const
+{
+   size_t nodesUsed = 0, nodesReserved = 0, itemsUsed = 0, itemsReserved = 0;
+
+   for (int i = 0; i < Collectible::UNIQUES; i++) {
+      if (items[i] != nullptr) {
+         nodesUsed += items[i]->getNodeArena().bytesUsed();
+         nodesReserved += items[i]->getNodeArena().bytesReserved();
+      }
+   }
+   for (const Arena* arena : itemArenas) {
+      itemsUsed += arena->bytesUsed();
+      itemsReserved += arena->bytesReserved();
+   }
+   output << "Inventory memory: nodes " << nodesUsed << " bytes (" << nodesReserved
+      << " reserved), items " << itemsUsed << " bytes (" << itemsReserved
+      << " reserved)" << endl;
+}
+
+/** ----------------------------- updateInventory() ---------------------
+* Changes the stock count of an item by the amount indicated.
+* The current implementation only uses +1 and -1 for change.
+* The stored item is found through the ItemIndex in constant time.
+* @param item   Collectible object to update.
+* @param change Amount to change the stock count by. Note that this is a
+*                 change amount, not an absolute amount.
+* @pre          Parameter item already exists in Inventory.
+* @post         Stock count of item is increased by amount indicated
+*                 (decreased if negative).
+* @return       Returns true on successful execution, false on failure.
+*/
+bool Inventory::updateInventory(Collectible* item, int change)
+{
+   Collectible* temp = index.find(*item);
+  
+   if (temp == nullptr)                // Invalid object passed as item parameter
+      return false;
+
+   return changeStock(temp, change);   // False on failure
+}
+
+/** ----------------------------- updateInventory(ItemRecord&, int) --------
+* Changes the stock count of a parsed item by the amount indicated.
+* Used by transactions so no Collectible is built just to find the item.
+* @param item   Parsed fields of the item to update.
+* @param change Amount to change the stock count by.
+* @pre          None.
+* @post         Stock count of item is changed if the item exists and its
+*                 stock stays at or above 0.
+* @return       The updated item, nullptr on failure.
+*/
+Collectible* Inventory::updateInventory(const ItemRecord& item, int change)
+{
+   Collectible* temp = index.find(item);
+
+   if (temp == nullptr || !changeStock(temp, change))
+      return nullptr;                  // Not stocked, or not enough stock
+   return temp;
+}
+
+/** ----------------------------- updateInventory(uint32_t, int) -----------
+* Changes the stock count of an item given by its item ID, such as when
+*   replaying a Journal.
+* @param itemId ID of the item to update.
+* @param change Amount to change the stock count by.
+* @pre          None.
+* @post         Stock count of item is changed if the item exists and its
+*                 stock stays at or above 0.
+* @return       The updated item, nullptr on failure.
+*/
+Collectible* Inventory::updateInventory(uint32_t itemId, int change)
+{
+   if (itemId >= stocked.size() || !changeStock(stocked[itemId], change))
+      return nullptr;
+   return stocked[itemId];
+}
+
+/** ----------------------------- outputAll(ostream&) ---------------------
+* Traverses each tree in-order and outputs each item.
+* Tree priority is Coin -> Comic Book -> Sports Card
+* The output is cached, so it is only rendered again when stock changed
+*   since the last call, and then only for the items that changed.
+* @param output Stream to write the items to.
+* @pre      None.
+* @post     Details on each item stored is output in order, including items
+*             with zero stock count.
+* @return   True after all nodes of each tree have been visited.
+*/
+bool Inventory::outputAll(ostream& output)
+{
+   displays++;
+   if (renderedValid && renderedVersion == version.load(memory_order_relaxed))
+      reusedDisplays++;                // Nothing changed, output it again
+   else
+      render();
+
+   output.write(rendered.data(), rendered.size());
+   return true;
+}
+
+/** ----------------------------- render() ---------------------
+* Brings the cached display up to date, rendering again only the lines of
+*   items whose stock changed since they were last rendered.
+* Items cannot be added once the Inventory is loaded, so the output order
+*   is the one ranked by buildOrder().
+*/
+void Inventory::render()
+{
+   uint64_t current = version.load(memory_order_relaxed);
+
+   lines.resize(stocked.size());
+   rendered.clear();
+   for (int i = 0; i < Collectible::UNIQUES; i++) {
+      if (items[i] == nullptr)
+         continue;
+      for (uint32_t rank = rankBegin[i]; rank < rankEnd[i]; rank++) {
+         Collectible* item = ordered[rank];
+         string& line = lines[item->getItemId()];
+         if (item->takeDirty()) {
+            lineOutput.str(string());
+            lineOutput << *item;
+            line = lineOutput.str();
+            renderedLines++;
+         }
+         rendered += line;
+         rendered += '\n';
+      }
+      rendered += '\n';               // End of a category
+   }
+   renderedVersion = current;
+   renderedValid = true;
+}
+
+/** ----------------------------- outputDisplayStats(ostream&) -------------
+* Outputs how often outputAll() reused the cached display and how many
+*   item lines it rendered.
+* @param output Stream to write the statistics to.
+* @pre      None.
+* @post     Statistics are output on a single line.
+*/
+void Inventory::outputDisplayStats(ostream& output) const
+{
+   output << "Display cache: " << displays << " displays, " << reusedDisplays
+      << " reused, " << renderedLines << " lines rendered, " << rendered.capacity()
+      << " bytes cached" << endl;
+}
@@ -1,64 +1,433 @@
-/** @file Inventory.h
- * @author Korosh Moosavi
- * @date 2021-03-12
- *
- * Inventory class:
- * Specialized HashTable class used to track inventory of items in
- *   CollectibleStore.
- * Reads from a file containing inventory data to build hash tables
- *   of various collectibles sold in the store.
- *
- * Assumptions:
- * Only Collectible objects and its subclasses will be handled by this class.
- */
-#pragma once
-#include "Factory.h"
-#include "SearchTree.h "
-#include <fstream>
-
-class Inventory {
-private:
-   SearchTree* items[Collectible::UNIQUES];
-
-public:
-   /** ------------------------------ Constructor ----------------------
-   * Uses Factory to construct subclasses of Collectible as needed based on
-   *   data in the input file.
-   * Adds items to corresponding SearchTrees for easy sorting.
-   * @param fileName Name of the input file containing data on store items.
-   * @pre  File is pre-formatted and in the same directory.
-   * @post All items in the input file are parsed and created (when able) then
-   *         added to its corresponding SearchTree within the hash table items[]
-   */
-   Inventory(string fileName);
-
-   /** ------------------------------ Destructor -------------------------------
-    * Every object in the table is deleted from memory.
-    * @pre  None
-    * @post Data is deallocated after destruction.
-    */
-   virtual ~Inventory();
-
-   /** ----------------------------- updateInventory() ---------------------
-   * Changes the stock count of an item by the amount indicated.
-   * The current implementation only uses +1 and -1 for change.
-   * @param item   Collectible object to update.
-   * @param change Amount to change the stock count by. Note that this is a
-   *                 change amount, not an absolute amount.
-   * @pre          Parameter item already exists in Inventory.
-   * @post         Stock count of item is increased by amount indicated
-   *                 (decreased if negative).
-   * @return       Returns true on successful execution, false on failure.
-   */
-   bool updateInventory(Collectible* item, int change);
-
-   /** ----------------------------- outputAll() ---------------------
-   * Traverses each tree in-order and outputs each item.
-   * Tree priority is Coin -> Comic Book -> Sports Card
-   * @pre      None.
-   * @post     Details on each item stored is output in order, including items
-   *             with zero stock count.
-   * @return   True after all nodes of each tree have been visited.
-   */
-   bool outputAll();
-};
+/** @file Inventory.h
+ * @author Korosh Moosavi
+ * @date 2021-03-12
+ *
+ * Inventory class:
+ * Specialized HashTable class used to track inventory of items in
+ *   CollectibleStore.
+ * Reads from a file containing inventory data to build hash tables
+ *   of various collectibles sold in the store.
+ * Items are kept in two structures: a SearchTree per category for ordered
+ *   output, and an ItemIndex over all categories for stock lookups.
+ * Items are allocated in Arenas owned by the Inventory and tree nodes in
+ *   Arenas owned by each SearchTree, so both are laid out in file order and
+ *   released together.
+ * The whole inventory, stock included, can be saved to a Snapshot and
+ *   rebuilt from it without parsing or comparing any item.
+ * The full display is cached. Each item keeps its rendered line until its
+ *   stock changes, and the whole display is reused as long as no stock has
+ *   changed since it was rendered, see outputAll().
+ * The display can also be paged through with outputPage(), which resumes at
+ *   an item ID instead of rendering every item before it.
+ * Ranges of the sort order of a category, see ItemRange, are found with a
+ *   single search of its SearchTree, so they cost O(log n + k).
+ * Secondary indexes list the items of each category by name and by type,
+ *   the publisher of a comic book or the manufacturer of a sports card, so
+ *   items can be found by fields their category is not sorted by first.
+ * Items in stock are tracked by a bitmap in display order, updated as
+ *   their stock crosses zero, so displays and range queries limited to
+ *   items in stock skip sold out items without visiting them.
+ *
+ * Assumptions:
+ * Only Collectible objects and its subclasses will be handled by this class.
+ */
+#pragma once
+#include "Factory.h"
+#include "SearchTree.h"
+#include "ItemIndex.h"
+#include "MappedFile.h"
+#include "Snapshot.h"
+#include "ThreadPool.h"
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <sstream>
+
+/** ------------------------ ItemRange struct --------------------------
+ * Contiguous part of the sort order of one category: items whose leading
+ *   text fields, see Collectible::getSortText(), equal fields, and whose
+ *   year is between firstYear and lastYear
+ * Only the first count text fields are matched, and the last of them only
+ *   as a prefix if prefix is set
+ * Years are only matched once every text field of the category is matched
+ *   in full, since they are only in order within equal text fields
+ */
+struct ItemRange {
+   char symbol = '\0';
+   string_view fields[Collectible::SORT_TEXT_FIELDS];
+   int count = 0;
+   bool prefix = false;
+   int firstYear = INT_MIN;
+   int lastYear = INT_MAX;
+};
+
+class Inventory {
+private:
+   SearchTree* items[Collectible::UNIQUES];
+   vector<Arena*> itemArenas;    // Own every item, one per parsed chunk
+   ItemIndex index;
+   vector<Collectible*> stocked;  // Every stocked item, indexed by item ID
+   LoadStats loadStats;
+
+   // Display cache, see outputAll(). version counts stock changes, rendered
+   //   holds the whole display as of renderedVersion.
+   atomic<uint64_t> version{0};
+   uint64_t renderedVersion = 0;
+   bool renderedValid = false;
+   string rendered;
+   vector<string> lines;                // Rendered line of each item by ID
+   ostringstream lineOutput;            // Reused to render a line
+   uint64_t displays = 0, reusedDisplays = 0, renderedLines = 0;
+
+   // Graded items by category symbol - '@' then grade code, each list sorted
+   //   like its SearchTree. A category's list is empty until it has an item.
+   vector<vector<Collectible*>> graded[Collectible::UNIQUES];
+
+   // Items by tree slot, see Collectible::hash(), sorted by name or type,
+   //   then like their SearchTree. Built once loading is done.
+   vector<Collectible*> named[Collectible::UNIQUES];
+   vector<Collectible*> typed[Collectible::UNIQUES];
+
+   // Display order, built once loading is done. The rank of an item is its
+   //   place in ordered, and the items of tree slot i are ranked from
+   //   rankBegin[i] up to rankEnd[i].
+   vector<Collectible*> ordered;
+   vector<uint32_t> rankOf;             // Rank of each item by item ID
+   uint32_t rankBegin[Collectible::UNIQUES];
+   uint32_t rankEnd[Collectible::UNIQUES];
+
+   // Bit per rank, set while the item has stock. A bit of inStockWords is
+   //   set when its word may be non-zero, and only cleared by a scan that
+   //   finds the word empty, see nextInStock().
+   vector<atomic<uint64_t>> inStock;
+   mutable vector<atomic<uint64_t>> inStockWords;
+
+   /** ----------------------------- render() ---------------------
+   * Brings the cached display up to date, rendering again only the lines of
+   *   items whose stock changed since they were last rendered.
+   */
+   void render();
+
+   /** ----------------------------- findCategory(char) ---------------------
+   * @param symbol Category symbol of the items
+   * @return Tree holding the items of the category, nullptr if it has none
+   */
+   const SearchTree* findCategory(char symbol) const;
+
+   /** ----------------------------- rangeOrder(ItemRange&, Collectible&) -----
+   * @param range Range of the category of item
+   * @param item  Item to place
+   * @return Negative if item sorts before range, positive if after it, 0 if
+   *           it is in range
+   */
+   static int rangeOrder(const ItemRange& range, const Collectible& item);
+
+   /** ----------------------------- stock(Collectible*) ---------------------
+   * Adds an item to the lookup index, then gives it the next item ID and
+   *   adds it to the grade index, unless an equal item is already stocked.
+   * @param item Item just parsed
+   * @return True if the item was stocked, false if it is a repeat
+   */
+   bool stock(Collectible* item);
+
+   /** ----------------------------- addGraded(Collectible*) ---------------
+   * Adds a stocked item to the grade index if its grade is on its scale.
+   * @param item Item just added to the lookup index
+   */
+   void addGraded(Collectible* item);
+
+   /** ----------------------------- sortGraded() ---------------------
+   * Sorts every list of the grade index once loading is done.
+   */
+   void sortGraded();
+
+   /** ----------------------------- buildFields() ---------------------
+   * Builds the name and type indexes once loading is done.
+   */
+   void buildFields();
+
+   /** ----------------------------- buildOrder() ---------------------
+   * Ranks every item in display order and marks the items in stock, once
+   *   loading is done.
+   */
+   void buildOrder();
+
+   /** ----------------------------- changeStock(Collectible*, int) ---------
+   * Changes the stock of a stocked item, then updates the display version
+   *   and, if the stock crossed zero, the in-stock bitmap.
+   * @param item   Item to update.
+   * @param change Amount to change the stock count by.
+   * @return True if the stock was changed without going below 0.
+   */
+   bool changeStock(Collectible* item, int change);
+
+   /** ----------------------------- nextInStock(uint32_t, uint32_t) --------
+   * Finds the next item in stock in display order, skipping 4096 sold out
+   *   items at a time where possible.
+   * @param rank First rank to check.
+   * @param end  Rank to stop at.
+   * @return Rank of the first item in stock from rank on, end if none
+   *           is before it.
+   * @pre    No stock is being changed, such as while a display runs alone.
+   */
+   uint32_t nextInStock(uint32_t rank, uint32_t end) const;
+
+   /** ----------------------------- getField(Collectible*, int) ------------
+   * @return Name or type of item, the key of the index of field
+   */
+   static string_view getField(const Collectible* item, int field)
+   { return field == NAME ? item->getName() : item->getType(); };
+
+public:
+   enum Field { NAME, TYPE };    // Fields with a secondary index
+
+   /** ------------------------------ Constructor ----------------------
+   * Uses Factory to construct subclasses of Collectible as needed based on
+   *   data in the input file.
+   * The file is memory mapped and each line is parsed in place, without
+   *   being copied.
+   * Adds items to corresponding SearchTrees for easy sorting, and to the
+   *   ItemIndex for lookups. Duplicate items are discarded.
+   * Stocked items are given item IDs 0 to item count - 1.
+   * @param fileName Name of the input file containing data on store items.
+   * @pre  File is pre-formatted and in the same directory.
+   * @post All items in the input file are parsed and created (when able) then
+   *         added to its corresponding SearchTree within the hash table items[]
+   */
+   Inventory(string fileName);
+
+   /** ------------------------------ Parallel constructor ----------------------
+   * Builds the same Inventory as Inventory(string) using a ThreadPool.
+   * The file is split into chunks that are parsed concurrently, then the
+   *   SearchTree of each category is built concurrently. Items are inserted
+   *   into each tree in file order, so the result does not depend on timing.
+   * @param fileName Name of the input file containing data on store items.
+   * @param pool     Workers to parse and build with.
+   * @pre  File is pre-formatted and in the same directory.
+   *       Not called from a task running on pool.
+   * @post All items in the input file are parsed and created (when able) then
+   *         added to its corresponding SearchTree within the hash table items[]
+   */
+   Inventory(string fileName, ThreadPool& pool);
+
+   /** ------------------------------ Snapshot constructor ----------------------
+   * Rebuilds an Inventory saved by save(Snapshot&), with the same items,
+   *   item IDs and stock. Each SearchTree is built directly from its saved
+   *   order, only checking each item sorts after the one before it.
+   * @param snapshot Snapshot being read, positioned where save() started.
+   * @pre  None
+   * @post Every saved item is restored, unless snapshot turns out to be
+   *         invalid, such as when it holds an item twice or a tree out of
+   *         order, in which case the Inventory should be discarded.
+   */
+   Inventory(Snapshot& snapshot);
+
+   /** ------------------------------ Destructor -------------------------------
+    * Every tree is deleted, then every item is released with its Arena.
+    * @pre  None
+    * @post Data is deallocated after destruction.
+    */
+   virtual ~Inventory();
+
+   /** ----------------------------- updateInventory() ---------------------
+   * Changes the stock count of an item by the amount indicated.
+   * The current implementation only uses +1 and -1 for change.
+   * The stored item is found through the ItemIndex in constant time.
+   * @param item   Collectible object to update.
+   * @param change Amount to change the stock count by. Note that this is a
+   *                 change amount, not an absolute amount.
+   * @pre          Parameter item already exists in Inventory.
+   * @post         Stock count of item is increased by amount indicated
+   *                 (decreased if negative).
+   * @return       Returns true on successful execution, false on failure.
+   */
+   bool updateInventory(Collectible* item, int change);
+
+   /** ----------------------------- updateInventory(ItemRecord&, int) --------
+   * Changes the stock count of a parsed item by the amount indicated.
+   * Used by transactions so no Collectible is built just to find the item.
+   * @param item   Parsed fields of the item to update.
+   * @param change Amount to change the stock count by.
+   * @pre          None.
+   * @post         Stock count of item is changed if the item exists and its
+   *                 stock stays at or above 0.
+   * @return       The updated item, nullptr on failure.
+   */
+   Collectible* updateInventory(const ItemRecord& item, int change);
+
+   /** ----------------------------- updateInventory(uint32_t, int) -----------
+   * Changes the stock count of an item given by its item ID, such as when
+   *   replaying a Journal.
+   * @param itemId ID of the item to update.
+   * @param change Amount to change the stock count by.
+   * @pre          None.
+   * @post         Stock count of item is changed if the item exists and its
+   *                 stock stays at or above 0.
+   * @return       The updated item, nullptr on failure.
+   */
+   Collectible* updateInventory(uint32_t itemId, int change);
+
+   /** ----------------------------- outputAll(ostream&) ---------------------
+   * Traverses each tree in-order and outputs each item.
+   * Tree priority is Coin -> Comic Book -> Sports Card
+   * The output is cached, so it is only rendered again when stock changed
+   *   since the last call, and then only for the items that changed.
+   * @param output Stream to write the items to.
+   * @pre      None.
+   * @post     Details on each item stored is output in order, including items
+   *             with zero stock count.
+   * @return   True after all nodes of each tree have been visited.
+   */
+   bool outputAll(ostream& output);
+
+   /** ----------------------------- outputPage(int64_t&, size_t, ostream&) ---
+   * Outputs a page of the display, starting at an item and walking each
+   *   tree from there with a SearchTree::Iterator, so a page costs
+   *   O(log n + limit) wherever it starts.
+   * Categories are separated by a blank line, like in outputAll().
+   * @param cursor Item ID to start at, -1 for the first item. Set to the item
+   *                 ID the next page starts at, -1 once every item is output.
+   * @param limit  Most items to output.
+   * @param output Stream to write the items to.
+   * @pre      None.
+   * @post     Up to limit items are output, including items with zero stock.
+   * @return   True once the page is output, false if cursor is not an item.
+   */
+   bool outputPage(int64_t& cursor, size_t limit, ostream& output) const;
+
+   /** ----------------------------- getSortTextFields(char) ----------------
+   * @param symbol Category symbol of the items
+   * @return Number of text fields the category is sorted by before the
+   *           year, 0 if it has no items
+   */
+   int getSortTextFields(char symbol) const;
+
+   /** ----------------------------- outputRange(ItemRange&, ostream&) -------
+   * Outputs every item of a range of the sort order of a category, found
+   *   with one search of its SearchTree, so the cost is O(log n + k) for
+   *   k items in range.
+   * @param range  Items to output, see ItemRange.
+   * @param output Stream to write the items to.
+   * @pre      range does not hold more text fields than its category, and
+   *             only bounds years if it matches every text field in full.
+   * @post     Items in range are output one per line in tree order,
+   *             including items with zero stock count.
+   */
+   void outputRange(const ItemRange& range, ostream& output) const;
+
+   /** ----------------------------- outputRangeInStock(ItemRange&, ostream&) -
+   * Outputs the items of a range of the sort order of a category that are
+   *   in stock, read from the in-stock bitmap, so the cost is
+   *   O(log n + k) for k items of the range in stock.
+   * @param range  Items to output, see ItemRange.
+   * @param output Stream to write the items to.
+   * @pre      Same as outputRange(), and no stock is being changed.
+   * @post     Items in range with stock are output one per line.
+   */
+   void outputRangeInStock(const ItemRange& range, ostream& output) const;
+
+   /** ----------------------------- outputInStock(int64_t&, size_t, ostream&)
+   * Outputs a page of the display limited to items in stock, read from
+   *   the in-stock bitmap, so a page costs O(limit) no matter how many
+   *   sold out items it skips.
+   * Categories are separated by a blank line, like in outputAll().
+   * @param cursor Item ID to start at, -1 for the first item. Set to the item
+   *                 ID the next page starts at, -1 once every item is output.
+   * @param limit  Most items to output.
+   * @param output Stream to write the items to.
+   * @pre      No stock is being changed.
+   * @post     Up to limit items with stock are output.
+   * @return   True once the page is output, false if cursor is not an item.
+   */
+   bool outputInStock(int64_t& cursor, size_t limit, ostream& output) const;
+
+   /** ----------------------------- outputMatching(Field, string_view, bool, ostream&)
+   * Outputs every item whose name or type is value, or starts with it,
+   *   read from the name or type index with a binary search in each
+   *   category, so the cost is O(log n + k) for k matching items.
+   * @param field  Index to search, NAME or TYPE.
+   * @param value  Name or type to find.
+   * @param prefix True to match every name or type starting with value.
+   * @param output Stream to write the items to.
+   * @pre      None.
+   * @post     Matching items are output one per line, Coin -> Comic Book ->
+   *             Sports Card, then by field and like their SearchTree,
+   *             including items with zero stock count.
+   */
+   void outputMatching(Field field, string_view value, bool prefix, ostream& output) const;
+
+   /** ----------------------------- outputGraded(char, uint8_t, ostream&) ----
+   * Outputs every item of a category graded at or above a grade, read from
+   *   the grade index instead of scanning the category.
+   * Items are listed from the lowest qualifying grade up, and in tree order
+   *   within a grade.
+   * @param symbol  Category symbol of the items
+   * @param minimum Lowest grade code to output, see Grade
+   * @param output  Stream to write the items to.
+   * @pre      symbol is recognized by Factory.
+   * @post     Matching items are output one per line, including items
+   *             with zero stock count.
+   */
+   void outputGraded(char symbol, uint8_t minimum, ostream& output) const;
+
+   /** ----------------------------- save(Snapshot&) ---------------------
+   * Adds the interned strings, every item in item ID order, and the order
+   *   of each SearchTree to a snapshot being written.
+   * @param snapshot Snapshot being written.
+   * @pre      No transaction is being processed.
+   * @post     The Inventory can be rebuilt by the Snapshot constructor.
+   */
+   void save(Snapshot& snapshot) const;
+
+   /** ----------------------------- getItem(uint32_t) ---------------------
+   * @param itemId ID assigned to a stocked item.
+   * @return The item with that ID, nullptr if there is none.
+   */
+   const Collectible* getItem(uint32_t itemId) const
+   { return itemId < stocked.size() ? stocked[itemId] : nullptr; };
+
+   /** ----------------------------- fingerprint() ---------------------
+   * @return Hash of the composite key of every item in item ID order, so
+   *           inventories that give different IDs to their items almost
+   *           surely differ. Stock is left out.
+   */
+   uint64_t fingerprint() const;
+
+   /** ----------------------------- outputIndexStats(ostream&) ---------------
+   * Outputs load and probe length statistics of the item lookup index.
+   * @param output Stream to write the statistics to.
+   * @pre      None.
+   * @post     Statistics are output, one value per line.
+   */
+   void outputIndexStats(ostream& output) const { index.outputStats(output); };
+
+   /** ----------------------------- outputLookupStats(ostream&) --------------
+   * Outputs how many item lookups were made and their mean probe length.
+   * @param output Stream to write the statistics to.
+   * @pre      No transaction is being processed.
+   * @post     Statistics are output on a single line.
+   */
+   void outputLookupStats(ostream& output) const { index.outputLookupStats(output); };
+
+   /** ----------------------------- outputDisplayStats(ostream&) -------------
+   * Outputs how often outputAll() reused the cached display and how many
+   *   item lines it rendered.
+   * @param output Stream to write the statistics to.
+   * @pre      None.
+   * @post     Statistics are output on a single line.
+   */
+   void outputDisplayStats(ostream& output) const;
+
+   /** ----------------------------- outputMemoryStats(ostream&) --------------
+   * Outputs bytes used and reserved by the Arenas of tree nodes and items.
+   * @param output Stream to write the statistics to.
+   * @pre      None.
+   * @post     Statistics are output on a single line.
+   */
+   void outputMemoryStats(ostream& output) const;
+
+   /** ----------------------------- getLoadStats() ---------------------
+   * @return Size and duration of loading the inventory file.
+   */
+   const LoadStats& getLoadStats() const { return loadStats; };
+};
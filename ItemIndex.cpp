@@ -0,0 +1,273 @@
+/** @file ItemIndex.cpp
+ * @author Korosh Moosavi
+ * @date 2026-10-16
+ *
+ * ItemIndex class:
+ * Open-addressing hash table mapping the composite key
+ *   (category, year, grade, name, type) of a Collectible to the object
+ *   stored in Inventory.
+ * Used for constant time point lookups when updating stock, leaving the
+ *   SearchTrees in Inventory to serve ordered output only.
+ * Collisions are resolved with linear probing over a power of 2 capacity.
+ *
+ * Assumptions:
+ * Indexed objects are owned elsewhere and outlive this index.
+ * No two indexed objects have equal keys.
+ */
+#include "ItemIndex.h"
+#include <algorithm>
+
+/** ----------------------------- countSlot() ---------------------
+ * @return Slot of ItemIndex lookup counts used by the calling thread,
+ *           handed out in turn the first time a thread calls find().
+ */
+static size_t countSlot()
+{
+   static atomic<size_t> nextSlot{0};
+   thread_local size_t slot = nextSlot.fetch_add(1, memory_order_relaxed);
+
+   return slot;
+}
+
+/** ------------------------------ Constructor ----------------------
+ * Allocates an empty table of INITIAL_CAPACITY slots.
+ */
+ItemIndex::ItemIndex() : capacity(INITIAL_CAPACITY), count(0)
+{
+   table = new Slot[capacity]();
+}
+
+/** ------------------------------ Destructor -------------------------------
+ * Frees the table only, indexed items are owned elsewhere.
+ */
+ItemIndex::~ItemIndex()
+{
+   delete[] table;
+   table = nullptr;
+}
+
+/** ----------------------------- hashKey(...) ---------------------
+ * Hashes every field that makes up the identity of a Collectible.
+ * Fields are separated by a 0 byte so "ab"+"c" and "a"+"bc" differ.
+ * @return 64-bit FNV-1a hash of the composite key, with a final mixing step.
+ */
+uint64_t ItemIndex::hashKey(char symbol, int year, string_view grade,
+                            string_view name, string_view type)
+{
+   const uint64_t PRIME = 1099511628211ULL;
+   uint64_t hashVal = 14695981039346656037ULL;
+
+   hashVal = (hashVal ^ (unsigned char)symbol) * PRIME;
+   for (int i = 0; i < 4; i++)               // Year, one byte at a time
+      hashVal = (hashVal ^ ((year >> (8 * i)) & 0xFF)) * PRIME;
+
+   const string_view fields[] = { grade, name, type };
+   for (string_view field : fields) {
+      for (unsigned char c : field)
+         hashVal = (hashVal ^ c) * PRIME;
+      hashVal *= PRIME;                      // Field separator
+   }
+
+   hashVal ^= hashVal >> 33;                 // Mix high bits into the low bits
+   hashVal *= 0xff51afd7ed558ccdULL;         //   used to pick a slot
+   hashVal ^= hashVal >> 33;
+   return hashVal;
+}
+
+/** ----------------------------- insert(Collectible*) ---------------------
+ * Adds an item to the index, growing the table when needed.
+ * @param item Object to index by its composite key.
+ * @pre    item is not nullptr
+ * @post   item can be found using any Collectible with an equal key
+ * @return True if item was added, false if an equal key already exists
+ */
+bool ItemIndex::insert(Collectible* item)
+{
+   if (find(*item) != nullptr)
+      return false;
+
+   if ((count + 1) * 100 > capacity * MAX_LOAD_PERCENT)
+      grow();
+
+   Slot entry = { hashKey(item->getSymbol(), item->getYear(), item->getGrade(),
+                          item->getName(), item->getType()), item };
+   place(entry);
+   count++;
+   return true;
+}
+
+/** ----------------------------- reserve(size_t) ---------------------
+ * Grows the table ahead of time so expected items can be inserted
+ *   without rehashing.
+ * @param expected Number of items the table should hold
+ * @post   Table capacity keeps expected items under the load limit
+ */
+void ItemIndex::reserve(size_t expected)
+{
+   while (expected * 100 > capacity * MAX_LOAD_PERCENT)
+      grow();
+}
+
+/** ----------------------------- find(ItemRecord&) ---------------------
+ * Looks up the indexed object whose key is equal to the parsed record.
+ * No Collectible needs to be constructed to search the index.
+ * @param key Parsed item fields to search for (stock ignored).
+ * @pre    None
+ * @return The indexed object if found, nullptr if not found
+ */
+Collectible* ItemIndex::find(const ItemRecord& key) const
+{
+   uint64_t hashVal = hashKey(key.symbol, key.year, key.grade, key.name, key.type);
+   size_t mask = capacity - 1;
+   size_t pos = hashVal & mask;
+   uint64_t probes = 0;
+   Collectible* found = nullptr;
+
+   while (table[pos].item != nullptr) {         // Empty slot ends the probe
+      const Collectible* item = table[pos].item;
+
+      probes++;
+      if (table[pos].hashVal == hashVal && item->getSymbol() == key.symbol
+          && item->getYear() == key.year && item->getGrade() == key.grade
+          && item->getName() == key.name && item->getType() == key.type) {
+         found = table[pos].item;
+         break;
+      }
+      pos = (pos + 1) & mask;
+   }
+   LookupCounts& local = counts[countSlot() % COUNT_SLOTS];
+   local.lookups.fetch_add(1, memory_order_relaxed);     // Uncontended line
+   local.probes.fetch_add(probes, memory_order_relaxed);
+   return found;
+}
+
+/** ----------------------------- find(Collectible&) ---------------------
+ * Looks up the indexed object whose key is equal to the parameter's.
+ * @param key Object holding the key fields to search for (stock ignored).
+ * @pre    None
+ * @return The indexed object if found, nullptr if not found
+ */
+Collectible* ItemIndex::find(const Collectible& key) const
+{
+   ItemRecord record;
+
+   record.symbol = key.getSymbol();
+   record.year = key.getYear();
+   record.grade = key.getGrade();
+   record.name = key.getName();
+   record.type = key.getType();
+   return find(record);
+}
+
+/** ------------------------ grow() --------------------------
+ * Doubles the capacity of the table and reinserts every item.
+ * @pre    None
+ * @post   All items remain indexed at their new positions
+ */
+void ItemIndex::grow()
+{
+   Slot* oldTable = table;
+   size_t oldCapacity = capacity;
+
+   capacity *= 2;
+   table = new Slot[capacity]();
+
+   for (size_t i = 0; i < oldCapacity; i++) {
+      if (oldTable[i].item != nullptr)
+         place(oldTable[i]);
+   }
+   delete[] oldTable;
+}
+
+/** ------------------------ place(Slot) --------------------------
+ * Stores an entry in the first free slot of its probe sequence.
+ * @param entry Occupied slot to copy into the table
+ * @pre    Table has at least one free slot, key is not already present
+ * @post   entry is stored in the table
+ */
+void ItemIndex::place(const Slot& entry)
+{
+   size_t mask = capacity - 1;
+   size_t pos = entry.hashVal & mask;
+
+   while (table[pos].item != nullptr)
+      pos = (pos + 1) & mask;
+   table[pos] = entry;
+}
+
+/** ------------------------ sumLookups(uint64_t&, uint64_t&) ------------
+ * Adds up the lookup counts of every thread.
+ * @param lookups Set to the number of find() calls made so far
+ * @param probes  Set to the number of slots they examined
+ */
+void ItemIndex::sumLookups(uint64_t& lookups, uint64_t& probes) const
+{
+   lookups = probes = 0;
+   for (const LookupCounts& local : counts) {
+      lookups += local.lookups.load(memory_order_relaxed);
+      probes += local.probes.load(memory_order_relaxed);
+   }
+}
+
+/** ----------------------------- outputStats(ostream&) ---------------------
+ * Outputs table size, load factor, and probe length statistics for the
+ *   stored entries, as well as the average probe length of lookups made
+ *   so far. Used to size the table for large catalogs.
+ * Probe length of an entry is the number of slots examined to find it.
+ * @param output Stream to write the statistics to
+ * @pre    None
+ * @post   Statistics are output, one value per line
+ */
+void ItemIndex::outputStats(ostream& output) const
+{
+   const int BUCKETS = 6;
+   const char* labels[BUCKETS] = { "1", "2", "3", "4-7", "8-15", "16+" };
+   uint64_t histogram[BUCKETS] = { 0 };
+   uint64_t totalProbe = 0;
+   size_t maxProbe = 0;
+   size_t mask = capacity - 1;
+   uint64_t lookups, lookupProbes;
+
+   sumLookups(lookups, lookupProbes);
+
+   for (size_t i = 0; i < capacity; i++) {
+      if (table[i].item == nullptr)
+         continue;
+
+      size_t probe = ((i - (table[i].hashVal & mask)) & mask) + 1;
+      int bucket = probe < 4 ? (int)probe - 1 : probe < 8 ? 3 : probe < 16 ? 4 : 5;
+
+      histogram[bucket]++;
+      totalProbe += probe;
+      maxProbe = max(maxProbe, probe);
+   }
+
+   output << "Item index entries:      " << count << endl
+      << "Item index capacity:     " << capacity << endl
+      << "Item index load factor:  " << (double)count / capacity << endl
+      << "Mean probe length:       "
+      << (count == 0 ? 0.0 : (double)totalProbe / count) << endl
+      << "Max probe length:        " << maxProbe << endl
+      << "Mean lookup probes:      "
+      << (lookups == 0 ? 0.0 : (double)lookupProbes / lookups) << endl;
+
+   for (int i = 0; i < BUCKETS; i++)
+      output << "Probe length " << setw(5) << left << labels[i] << "      "
+         << histogram[i] << endl;
+}
+
+/** ----------------------------- outputLookupStats(ostream&) ---------------
+ * Outputs the number of lookups made so far and their average probe
+ *   length, such as after transaction workers are done.
+ * @param output Stream to write the statistics to
+ * @pre    No thread is looking items up
+ * @post   Statistics are output on a single line
+ */
+void ItemIndex::outputLookupStats(ostream& output) const
+{
+   uint64_t lookups, probes;
+
+   sumLookups(lookups, probes);
+   output << "Item lookups: " << lookups << ", mean probes "
+      << (lookups == 0 ? 0.0 : (double)probes / lookups) << endl;
+}
@@ -0,0 +1,151 @@
+/** @file ItemIndex.h
+ * @author Korosh Moosavi
+ * @date 2026-10-16
+ *
+ * ItemIndex class:
+ * Open-addressing hash table mapping the composite key
+ *   (category, year, grade, name, type) of a Collectible to the object
+ *   stored in Inventory.
+ * Used for constant time point lookups when updating stock, leaving the
+ *   SearchTrees in Inventory to serve ordered output only.
+ * Collisions are resolved with linear probing over a power of 2 capacity.
+ *
+ * Assumptions:
+ * Indexed objects are owned elsewhere and outlive this index.
+ * No two indexed objects have equal keys.
+ */
+#pragma once
+#include "Collectible.h"
+#include <atomic>
+#include <cstdint>
+
+class ItemIndex {
+private:
+   /** ------------------------ Slot struct --------------------------
+    * Entry of the table, item is nullptr when the slot is unoccupied
+    * The full key hash is kept to skip most isEqual() calls while probing
+    */
+   struct Slot {
+      uint64_t hashVal;
+      Collectible* item;
+   };
+
+   static const size_t INITIAL_CAPACITY = 64;   // Must be a power of 2
+   static const int MAX_LOAD_PERCENT = 70;      // Grow past this load factor
+
+   Slot* table;
+   size_t capacity;
+   size_t count;
+
+   /** ------------------------ LookupCounts struct --------------------------
+    * Lookups made by find() and the slots they examined, kept per thread on
+    *   a cache line of their own so workers never write a shared counter
+    * Threads past the first COUNT_SLOTS share a line, so stay atomic
+    */
+   struct alignas(64) LookupCounts {
+      atomic<uint64_t> lookups{0};
+      atomic<uint64_t> probes{0};
+   };
+
+   static const size_t COUNT_SLOTS = 16;        // Threads counted apart
+
+   mutable LookupCounts counts[COUNT_SLOTS];    // Summed by outputStats()
+
+   /** ------------------------ grow() --------------------------
+    * Doubles the capacity of the table and reinserts every item.
+    * @pre    None
+    * @post   All items remain indexed at their new positions
+    */
+   void grow();
+
+   /** ------------------------ place(Slot) --------------------------
+    * Stores an entry in the first free slot of its probe sequence.
+    * @param entry Occupied slot to copy into the table
+    * @pre    Table has at least one free slot, key is not already present
+    * @post   entry is stored in the table
+    */
+   void place(const Slot& entry);
+
+   /** ------------------------ sumLookups(uint64_t&, uint64_t&) ------------
+    * Adds up the lookup counts of every thread.
+    * @param lookups Set to the number of find() calls made so far
+    * @param probes  Set to the number of slots they examined
+    */
+   void sumLookups(uint64_t& lookups, uint64_t& probes) const;
+
+public:
+   /** ------------------------------ Constructor ----------------------
+    * Allocates an empty table of INITIAL_CAPACITY slots.
+    */
+   ItemIndex();
+
+   /** ------------------------------ Destructor -------------------------------
+    * Frees the table only, indexed items are owned elsewhere.
+    */
+   ~ItemIndex();
+
+   /** ----------------------------- hashKey(...) ---------------------
+    * Hashes every field that makes up the identity of a Collectible.
+    * @return 64-bit FNV-1a hash of the composite key, with a final mixing step.
+    */
+   static uint64_t hashKey(char symbol, int year, string_view grade,
+                           string_view name, string_view type);
+
+   /** ----------------------------- insert(Collectible*) ---------------------
+    * Adds an item to the index, growing the table when needed.
+    * @param item Object to index by its composite key.
+    * @pre    item is not nullptr
+    * @post   item can be found using any Collectible with an equal key
+    * @return True if item was added, false if an equal key already exists
+    */
+   bool insert(Collectible* item);
+
+   /** ----------------------------- reserve(size_t) ---------------------
+    * Grows the table ahead of time so expected items can be inserted
+    *   without rehashing.
+    * @param expected Number of items the table should hold
+    * @post   Table capacity keeps expected items under the load limit
+    */
+   void reserve(size_t expected);
+
+   /** ----------------------------- find(ItemRecord&) ---------------------
+    * Looks up the indexed object whose key is equal to the parsed record.
+    * No Collectible needs to be constructed to search the index.
+    * @param key Parsed item fields to search for (stock ignored).
+    * @pre    None
+    * @return The indexed object if found, nullptr if not found
+    */
+   Collectible* find(const ItemRecord& key) const;
+
+   /** ----------------------------- find(Collectible&) ---------------------
+    * Looks up the indexed object whose key is equal to the parameter's.
+    * @param key Object holding the key fields to search for (stock ignored).
+    * @pre    None
+    * @return The indexed object if found, nullptr if not found
+    */
+   Collectible* find(const Collectible& key) const;
+
+   /** ----------------------------- size() ---------------------
+    * @return Number of items currently indexed.
+    */
+   size_t size() const { return count; };
+
+   /** ----------------------------- outputStats(ostream&) ---------------------
+    * Outputs table size, load factor, and probe length statistics for the
+    *   stored entries, as well as the average probe length of lookups made
+    *   so far. Used to size the table for large catalogs.
+    * @param output Stream to write the statistics to
+    * @pre    None
+    * @post   Statistics are output, one value per line
+    */
+   void outputStats(ostream& output) const;
+
+   /** ----------------------------- outputLookupStats(ostream&) ---------------
+    * Outputs the number of lookups made so far and their average probe
+    *   length, such as after transaction workers are done.
+    * @param output Stream to write the statistics to
+    * @pre    No thread is looking items up
+    * @post   Statistics are output on a single line
+    */
+   void outputLookupStats(ostream& output) const;
+};
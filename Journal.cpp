@@ -0,0 +1,365 @@
+/** @file Journal.cpp
+ * @author Korosh Moosavi
+ * @date 2026-10-16
+ *
+ * Journal class:
+ * Append-only binary file of every change applied to the store since it was
+ *   loaded, made durable by a writer thread with group commit.
+ * Uses write and fsync on POSIX systems and their CRT equivalents on Windows.
+ *
+ * Assumptions:
+ * A journal is only replayed on top of the state its store was started from.
+ * Only one store appends to a journal file at a time.
+ */
+#include "Journal.h"
+#include "MappedFile.h"
+#include <cstdio>
+#include <cstring>
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#define fsync _commit
+#define ftruncate _chsize_s
+#define lseek _lseeki64
+#define write(file, data, size) _write(file, data, (unsigned int)(size))
+#define O_FLAGS (_O_WRONLY | _O_CREAT | _O_BINARY)
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#define O_FLAGS (O_WRONLY | O_CREAT)
+#endif
+
+const char Journal::MAGIC[8] = { 'C', 'S', 'T', 'O', 'R', 'E', 'J', 'N' };
+
+/** ------------------------------ Constructor ----------------------
+ * Creates a closed journal, appending to it does nothing until open().
+ */
+Journal::Journal() : file(-1), commitDelay(0)
+{
+}
+
+/** ------------------------------ Destructor -------------------------------
+ * Commits every pending record, then closes the file.
+ */
+Journal::~Journal()
+{
+   close();
+}
+
+/** ----------------------------- checksum(string_view) ---------------
+ * @param bytes Framed record without its checksum
+ * @return FNV-1a hash of bytes, stored after the record
+ */
+uint32_t Journal::checksum(string_view bytes)
+{
+   uint32_t hashVal = 2166136261u;
+
+   for (unsigned char c : bytes)
+      hashVal = (hashVal ^ c) * 16777619u;
+   return hashVal;
+}
+
+/** ----------------------------- replay(string, uint64_t, function, uint64_t&)
+ * Reads every complete record of a journal in the order it was appended.
+ * A record that is cut short or fails its checksum ends the journal, since
+ *   nothing after a torn write can be trusted.
+ * @param name        Journal file, which does not have to exist
+ * @param fingerprint Inventory::fingerprint() of the loaded inventory
+ * @param apply       Called with each record
+ * @param validBytes  Set to the length of the file up to the first torn or
+ *                      corrupt record, 0 if there is no file
+ * @return False with a message on cerr, and no record read, if the file
+ *           is not a journal of this version or was written for another
+ *           inventory, true otherwise
+ */
+bool Journal::replay(const string& name, uint64_t fingerprint,
+                     const function<void(const JournalRecord&)>& apply, uint64_t& validBytes)
+{
+   validBytes = 0;
+   FILE* exists = fopen(name.c_str(), "rb");   // A missing journal is empty
+   if (exists == nullptr)
+      return true;
+   fclose(exists);
+
+   MappedFile input(name);
+   string_view unread = input.contents();
+   uint32_t version = 0;
+   uint64_t written = 0;
+
+   if (unread.empty())
+      return true;
+   if (unread.size() < HEADER_BYTES || memcmp(unread.data(), MAGIC, sizeof(MAGIC)) != 0) {
+      cerr << name << " is not a store journal.\n" << endl;
+      return false;
+   }
+   memcpy(&version, unread.data() + sizeof(MAGIC), sizeof(version));
+   if (version != VERSION) {
+      cerr << name << " was written by an incompatible version.\n" << endl;
+      return false;
+   }
+   memcpy(&written, unread.data() + sizeof(MAGIC) + sizeof(version), sizeof(written));
+   if (written != fingerprint) {
+      cerr << name << " was written for a different inventory.\n" << endl;
+      return false;
+   }
+   unread.remove_prefix(HEADER_BYTES);
+
+   while (unread.size() >= FRAME_BYTES) {
+      JournalRecord record;
+      uint16_t length = 0;
+      uint32_t stored = 0;
+
+      memcpy(&length, unread.data() + 1, sizeof(length));
+      if (unread.size() < FRAME_BYTES + length)
+         break;                                  // Torn write at the end
+      memcpy(&stored, unread.data() + 3 + length, sizeof(stored));
+      if (stored != checksum(unread.substr(0, 3 + length)))
+         break;
+
+      const char* payload = unread.data() + 3;
+      record.type = (JournalRecord::Type)unread[0];
+      if (record.type == JournalRecord::TRADE && length == TRADE_BYTES) {
+         memcpy(&record.sequence, payload, 8);
+         memcpy(&record.customerId, payload + 8, 8);
+         memcpy(&record.itemId, payload + 16, 4);
+         record.isBuy = payload[20] != 0;
+      } else if (record.type == JournalRecord::REGISTER && length >= 8) {
+         memcpy(&record.customerId, payload, 8);
+         record.name = string_view(payload + 8, length - 8);
+      } else {
+         break;                                  // Unknown record
+      }
+
+      apply(record);
+      unread.remove_prefix(FRAME_BYTES + length);
+   }
+
+   validBytes = input.size() - unread.size();
+   if (!unread.empty()) {
+      cerr << name << " ends with a torn record, " << unread.size()
+         << " bytes discarded.\n" << endl;
+   }
+   return true;
+}
+
+/** ----------------------------- open(string, uint64_t, microseconds, uint64_t)
+ * Opens a journal for appending and starts the writer thread.
+ * The header is written and made durable first if the journal is new.
+ * @param name        Journal file, created if it does not exist
+ * @param validBytes  Length returned by replay(), anything after it is
+ *                      discarded
+ * @param delay       Longest a record waits for others to be committed with
+ * @param fingerprint Inventory::fingerprint(), written to a new journal
+ * @pre    The journal is closed
+ * @return True if the file was opened, false with a message on cerr if not
+ */
+bool Journal::open(const string& name, uint64_t validBytes, chrono::microseconds delay,
+                   uint64_t fingerprint)
+{
+   file = ::open(name.c_str(), O_FLAGS, 0644);
+   if (file < 0) {
+      cerr << "Unable to open " << name << ".\n" << endl;
+      return false;
+   }
+
+   bool ready = ftruncate(file, validBytes) == 0 && lseek(file, validBytes, SEEK_SET) >= 0;
+   if (ready && validBytes == 0) {
+      uint32_t version = VERSION;
+      string header(MAGIC, sizeof(MAGIC));
+      header.append(reinterpret_cast<const char*>(&version), sizeof(version));
+      header.append(reinterpret_cast<const char*>(&fingerprint), sizeof(fingerprint));
+      ready = write(file, header.data(), header.size()) == (long)header.size() &&
+              fsync(file) == 0;
+   }
+   if (!ready) {
+      cerr << "Unable to write " << name << ".\n" << endl;
+      ::close(file);
+      file = -1;
+      return false;
+   }
+
+   fileName = name;
+   commitDelay = delay;
+   stopping = false;
+   failed = false;
+   openedAt = chrono::steady_clock::now();
+   writer = thread(&Journal::run, this);
+   return true;
+}
+
+/** ----------------------------- close() ---------------------
+ * Commits every pending record, stops the writer thread and closes the
+ *   file. Does nothing if the journal is closed.
+ */
+void Journal::close()
+{
+   if (file < 0)
+      return;
+   {
+      lock_guard<mutex> guard(lock);
+      stopping = true;
+   }
+   wake.notify_one();
+   writer.join();
+   ::close(file);
+   file = -1;
+}
+
+/** ----------------------------- append(Type, string_view) ---------------
+ * Frames a record and adds it to the pending batch, waking the writer if
+ *   the batch was empty or grew past FLUSH_BYTES.
+ * @param type    Kind of record
+ * @param payload Fields of the record
+ */
+void Journal::append(JournalRecord::Type type, string_view payload)
+{
+   char frame[FRAME_BYTES + TRADE_BYTES];  // Big enough for a trade
+   string framed;
+   char* bytes = frame;
+   size_t size = FRAME_BYTES + payload.size();
+   uint16_t length = (uint16_t)payload.size();
+
+   if (size > sizeof(frame)) {
+      framed.resize(size);
+      bytes = &framed[0];
+   }
+   bytes[0] = (char)type;
+   memcpy(bytes + 1, &length, sizeof(length));
+   memcpy(bytes + 3, payload.data(), payload.size());
+   uint32_t sum = checksum(string_view(bytes, 3 + payload.size()));
+   memcpy(bytes + 3 + payload.size(), &sum, sizeof(sum));
+
+   lock_guard<mutex> guard(lock);
+   bool first = pending.empty();
+   if (first)
+      pendingSince = chrono::steady_clock::now();
+   pending.append(bytes, size);
+   appended++;
+   if (first || pending.size() >= FLUSH_BYTES)
+      wake.notify_one();
+}
+
+/** ----------------- logTrade(uint64_t, int64_t, uint32_t, bool) -----------
+ * Appends a buy or sell that was applied to the store.
+ * Safe to call from several threads at once.
+ * @param sequence   Position of the trading command in its command file
+ * @param customerId Customer who traded
+ * @param itemId     Inventory item traded, by its item ID
+ * @param isBuy      Whether the store bought (true) or sold the item
+ */
+void Journal::logTrade(uint64_t sequence, int64_t customerId, uint32_t itemId, bool isBuy)
+{
+   char payload[TRADE_BYTES];
+
+   if (file < 0)
+      return;
+   memcpy(payload, &sequence, 8);
+   memcpy(payload + 8, &customerId, 8);
+   memcpy(payload + 16, &itemId, 4);
+   payload[20] = isBuy ? 1 : 0;
+   append(JournalRecord::TRADE, string_view(payload, sizeof(payload)));
+}
+
+/** ----------------- logRegistration(int64_t, string_view) -----------------
+ * Appends a customer registered while transactions are processed.
+ * Safe to call from several threads at once.
+ * @param customerId ID of the new customer
+ * @param name       Name of the new customer, longer names are cut to
+ *                     MAX_NAME bytes
+ */
+void Journal::logRegistration(int64_t customerId, string_view name)
+{
+   string payload(reinterpret_cast<const char*>(&customerId), sizeof(customerId));
+
+   if (file < 0)
+      return;
+   payload.append(name.substr(0, MAX_NAME));
+   append(JournalRecord::REGISTER, payload);
+}
+
+/** ----------------------------- sync() ---------------------
+ * Waits until every record appended so far is durable.
+ */
+void Journal::sync()
+{
+   if (file < 0)
+      return;
+   unique_lock<mutex> guard(lock);
+   uint64_t target = appended;
+
+   syncing = true;
+   wake.notify_one();
+   done.wait(guard, [&] { return durable >= target || failed; });
+   syncing = false;
+}
+
+/** ----------------------------- run() ---------------------
+ * Body of the writer thread, commits batches until the journal is closed.
+ * A batch is committed once its first record has waited the commit delay,
+ *   or sooner when it grows past FLUSH_BYTES or a thread waits in sync().
+ *   Records appended while a batch is written form the next batch.
+ */
+void Journal::run()
+{
+   unique_lock<mutex> guard(lock);
+
+   while (true) {
+      wake.wait(guard, [&] { return stopping || !pending.empty(); });
+      if (pending.empty())
+         break;                                  // Stopping, nothing left
+      wake.wait_until(guard, pendingSince + commitDelay, [&] {
+         return stopping || syncing || pending.size() >= FLUSH_BYTES;
+      });
+
+      swap(pending, writing);
+      uint64_t target = appended;
+      uint64_t batch = target - durable;
+      guard.unlock();
+
+      bool written = true;
+      for (size_t offset = 0; offset < writing.size() && written; ) {
+         long count = write(file, writing.data() + offset, writing.size() - offset);
+         written = count > 0;
+         offset += written ? count : 0;
+      }
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      written = fsync(file) == 0 && written;
+      double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+      guard.lock();
+      if (!written && !failed)
+         cerr << "Unable to write " << fileName << ", changes are not durable.\n" << endl;
+      failed = failed || !written;
+      bytesWritten += writing.size();
+      commits++;
+      maxBatch = max(maxBatch, batch);
+      fsyncSeconds += seconds;
+      maxFsyncSeconds = max(maxFsyncSeconds, seconds);
+      durable = target;
+      writing.clear();                           // Keeps its capacity
+      done.notify_all();
+   }
+}
+
+/** ----------------------------- outputStats(ostream&) ---------------------
+ * Outputs records and bytes written, bytes per second since open(),
+ *   records per commit and fsync latency.
+ * @param output Stream to write the statistics to
+ * @pre    None
+ * @post   Statistics are output on a single line
+ */
+void Journal::outputStats(ostream& output)
+{
+   lock_guard<mutex> guard(lock);
+   double elapsed = chrono::duration<double>(chrono::steady_clock::now() - openedAt).count();
+   double perCommit = commits > 0 ? (double)durable / commits : 0.0;
+   double meanFsync = commits > 0 ? fsyncSeconds / commits : 0.0;
+
+   output << "Journal: " << durable << " records, " << bytesWritten << " bytes in "
+      << commits << " commits (" << perCommit << " records per commit, " << maxBatch
+      << " max), fsync " << meanFsync * 1e3 << " ms mean, " << maxFsyncSeconds * 1e3
+      << " ms max, " << bytesWritten / (elapsed > 0.0 ? elapsed : 1e-9) / 1e6 << " MB/s"
+      << endl;
+}
@@ -0,0 +1,198 @@
+/** @file Journal.h
+ * @author Korosh Moosavi
+ * @date 2026-10-16
+ *
+ * Journal class:
+ * Append-only binary file of every change applied to the store since it was
+ *   loaded: each buy and sell logged by CustomerRegistry::updateLog(), and
+ *   each customer registered while transactions are processed.
+ * Replaying the journal on top of the same starting state, the input files
+ *   or the Snapshot the store was started from, restores the stock and
+ *   histories of a run that crashed before its output was complete.
+ * Records are appended to a memory buffer and made durable by a writer
+ *   thread with group commit: the first record of a batch waits at most the
+ *   commit delay for others to join it, then the whole batch is written with
+ *   a single fsync. Appending never waits for the disk, so a crash loses at
+ *   most the records of the last commit delay, and sync() waits for every
+ *   record appended so far.
+ * Each record is framed by its type and length and followed by a checksum,
+ *   so a record torn by a crash is detected, and replay stops before it.
+ * Trades refer to items by item ID, so the header holds a fingerprint of the
+ *   inventory the IDs were given by, and a journal is only replayed on an
+ *   inventory with the same fingerprint.
+ * Reports bytes written per second, fsync latency and records per commit.
+ *
+ * Assumptions:
+ * A journal is only replayed on top of the state its store was started from.
+ *   Starting from a newer snapshot calls for a new journal.
+ * Only one store appends to a journal file at a time.
+ */
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+using namespace std;
+
+/** ------------------------ JournalRecord struct --------------------------
+ * Replayed change, sequence, itemId and isBuy are only set for TRADE records
+ *   and name only for REGISTER records
+ * name views into the journal file while it is being replayed
+ */
+struct JournalRecord {
+   enum Type : uint8_t { TRADE = 1, REGISTER = 2 };
+
+   Type type = TRADE;
+   uint64_t sequence = 0;     // Position of the command in its command file
+   int64_t customerId = -1;
+   uint32_t itemId = 0;
+   bool isBuy = false;
+   string_view name;
+};
+
+class Journal {
+private:
+   static const char MAGIC[8];
+   static const uint32_t VERSION = 2;              // Bump on any format change
+   static const size_t FLUSH_BYTES = 1 << 20;      // Commit early past this
+   static const size_t HEADER_BYTES = 8 + 4 + 8;   // Magic, version, fingerprint
+   static const size_t FRAME_BYTES = 3 + 4;        // Type, length, checksum
+   static const size_t TRADE_BYTES = 8 + 8 + 4 + 1;
+
+   int file;                  // Descriptor of the open journal, -1 if closed
+   string fileName;
+   chrono::microseconds commitDelay;
+
+   mutex lock;                // Guards everything below
+   condition_variable wake;   // Signals the writer thread
+   condition_variable done;   // Signals threads waiting in sync()
+   thread writer;
+   string pending;            // Records appended since the last commit
+   string writing;            // Records being committed by the writer
+   chrono::steady_clock::time_point pendingSince;
+   uint64_t appended = 0;     // Records appended, and made durable
+   uint64_t durable = 0;
+   bool syncing = false;      // A thread waits in sync(), commit now
+   bool stopping = false;
+   bool failed = false;       // A write failed, reported once
+
+   // Totals for outputStats()
+   chrono::steady_clock::time_point openedAt;
+   uint64_t bytesWritten = 0;
+   uint64_t commits = 0;
+   uint64_t maxBatch = 0;
+   double fsyncSeconds = 0;
+   double maxFsyncSeconds = 0;
+
+   /** ----------------------------- append(Type, string_view) ---------------
+    * Frames a record and adds it to the pending batch, waking the writer if
+    *   the batch was empty or grew past FLUSH_BYTES.
+    * @param type    Kind of record
+    * @param payload Fields of the record
+    */
+   void append(JournalRecord::Type type, string_view payload);
+
+   /** ----------------------------- run() ---------------------
+    * Body of the writer thread, commits batches until the journal is closed.
+    */
+   void run();
+
+   /** ----------------------------- checksum(string_view) ---------------
+    * @param bytes Framed record without its checksum
+    * @return FNV-1a hash of bytes, stored after the record
+    */
+   static uint32_t checksum(string_view bytes);
+
+public:
+   static const size_t MAX_NAME = 0xFFFF - 8;      // Longest registered name
+
+   /** ------------------------------ Constructor ----------------------
+    * Creates a closed journal, appending to it does nothing until open().
+    */
+   Journal();
+
+   /** ------------------------------ Destructor -------------------------------
+    * Commits every pending record, then closes the file.
+    */
+   ~Journal();
+
+   Journal(const Journal&) = delete;
+   Journal& operator=(const Journal&) = delete;
+
+   /** ----------------------------- replay(string, uint64_t, function, uint64_t&)
+    * Reads every complete record of a journal in the order it was appended.
+    * @param name        Journal file, which does not have to exist
+    * @param fingerprint Inventory::fingerprint() of the loaded inventory
+    * @param apply       Called with each record
+    * @param validBytes  Set to the length of the file up to the first torn or
+    *                      corrupt record, 0 if there is no file
+    * @return False with a message on cerr, and no record read, if the file
+    *           is not a journal of this version or was written for another
+    *           inventory, true otherwise
+    */
+   static bool replay(const string& name, uint64_t fingerprint,
+                      const function<void(const JournalRecord&)>& apply, uint64_t& validBytes);
+
+   /** ----------------------------- open(string, uint64_t, microseconds, uint64_t)
+    * Opens a journal for appending and starts the writer thread.
+    * @param name        Journal file, created if it does not exist
+    * @param validBytes  Length returned by replay(), anything after it is
+    *                      discarded
+    * @param delay       Longest a record waits for others to be committed with
+    * @param fingerprint Inventory::fingerprint(), written to a new journal
+    * @pre    The journal is closed
+    * @return True if the file was opened, false with a message on cerr if not
+    */
+   bool open(const string& name, uint64_t validBytes, chrono::microseconds delay,
+             uint64_t fingerprint);
+
+   /** ----------------------------- close() ---------------------
+    * Commits every pending record, stops the writer thread and closes the
+    *   file. Does nothing if the journal is closed.
+    */
+   void close();
+
+   /** ----------------------------- isOpen() ---------------------
+    * @return True between open() and close().
+    */
+   bool isOpen() const { return file >= 0; };
+
+   /** ----------------- logTrade(uint64_t, int64_t, uint32_t, bool) -----------
+    * Appends a buy or sell that was applied to the store.
+    * Safe to call from several threads at once.
+    * @param sequence   Position of the trading command in its command file
+    * @param customerId Customer who traded
+    * @param itemId     Inventory item traded, by its item ID
+    * @param isBuy      Whether the store bought (true) or sold the item
+    */
+   void logTrade(uint64_t sequence, int64_t customerId, uint32_t itemId, bool isBuy);
+
+   /** ----------------- logRegistration(int64_t, string_view) -----------------
+    * Appends a customer registered while transactions are processed.
+    * Safe to call from several threads at once.
+    * @param customerId ID of the new customer
+    * @param name       Name of the new customer, longer names are cut to
+    *                     MAX_NAME bytes
+    */
+   void logRegistration(int64_t customerId, string_view name);
+
+   /** ----------------------------- sync() ---------------------
+    * Waits until every record appended so far is durable.
+    */
+   void sync();
+
+   /** ----------------------------- outputStats(ostream&) ---------------------
+    * Outputs records and bytes written, bytes per second since open(),
+    *   records per commit and fsync latency.
+    * @param output Stream to write the statistics to
+    * @pre    None
+    * @post   Statistics are output on a single line
+    */
+   void outputStats(ostream& output);
+};
@@ -0,0 +1,47 @@
+/** @file Lookup.cpp
+ * @author Korosh Moosavi
+ * @date 2026-10-17
+ *
+ * Lookup class:
+ * Class encompassing the store function to output every item with a given
+ *   name or type across all categories, years and grades.
+ *
+ * Assumptions:
+ * Objects used in this method are valid and initialized.
+ */
+#include "Lookup.h"
+
+/** ----------------------- process(Inventory&, CustomerRegistry&, Command&, ostream&) ---
+* Parses the field and value from the command and outputs the matching
+*   items with outputMatching() of Inventory.
+* The value is everything after the field, so it may contain commas, such
+*   as the comma in some player names.
+* @param inventory  Inventory storing data on the store's current items.
+* @param registry   Not used, remnant of parent class parameter.
+* @param command    Parsed transaction line, args hold "field, value".
+* @param output     Stream the operation's report is written to.
+* @pre    None
+* @return True once output is complete, false if the field is not
+*           recognized or no value is given.
+*/
+bool Lookup::process(Inventory& inventory, CustomerRegistry& registry, const Command& command,
+                     ostream& output)
+{
+   string_view value = command.args;
+   string_view field = CommandParser::nextField(value);
+
+   value = CommandParser::trim(value);
+   if ((field != "N" && field != "T") || value.empty()) {
+      cerr << "Invalid lookup entered.\n\n";
+      return false;
+   }
+   output << "Items with " << (field == "N" ? "name " : "type ") << value << ":\n";
+
+   bool prefix = value.back() == '*';
+   if (prefix)
+      value.remove_suffix(1);
+   inventory.outputMatching(field == "N" ? Inventory::NAME : Inventory::TYPE, value, prefix,
+                            output);
+   output << '\n';
+   return true;
+}
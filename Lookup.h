@@ -0,0 +1,50 @@
+/** @file Lookup.h
+ * @author Korosh Moosavi
+ * @date 2026-10-17
+ *
+ * Lookup class:
+ * Class encompassing the store function to output every item with a given
+ *   name or type across all categories, years and grades, with its current
+ *   stock, such as "L, N, Mickey Mantle" for every card of a player or
+ *   "L, T, Marvel" for every comic book of a publisher.
+ * N looks up names: coin names, comic book titles and sports card players.
+ * T looks up types: coin types, comic book publishers and sports card
+ *   manufacturers.
+ * A value ending with '*' matches as a prefix, such as "L, N, Mick*".
+ * Items are read from the secondary indexes of Inventory.
+ *
+ * Assumptions:
+ * Objects used in this method are valid and initialized.
+ */
+#include "Transaction.h"
+
+class Lookup : public Transaction {
+public:
+   /** ------------------------------ Default constructor ----------------------
+    * No special operations needed.
+    * @pre  None
+    * @post Lookup object created.
+    */
+   Lookup() {};
+
+   /** ------------------------------ Destructor -------------------------------
+    * No special operations needed.
+    * @pre  None
+    * @post Data is deallocated after destruction.
+    */
+   virtual ~Lookup() {};
+
+   /** -------------- process(Inventory&, CustomerRegistry&, Command&, ostream&) ---
+   * Parses the field and value from the command and outputs the matching
+   *   items with outputMatching() of Inventory.
+   * @param inventory  Inventory storing data on the store's current items.
+   * @param registry   Not used, remnant of parent class parameter.
+   * @param command    Parsed transaction line, args hold "field, value".
+   * @param output     Stream the operation's report is written to.
+   * @pre    None
+   * @return True once output is complete, false if the field is not
+   *           recognized or no value is given.
+   */
+   bool process(Inventory& inventory, CustomerRegistry& registry, const Command& command,
+                ostream& output);
+};
@@ -0,0 +1,130 @@
+/** @file MappedFile.cpp
+ * @author Korosh Moosavi
+ * @date 2026-10-16
+ *
+ * MappedFile class:
+ * Maps an input file read-only into memory so its records can be parsed
+ *   directly out of the mapped region, without copying each line.
+ * Uses mmap on POSIX systems and file mapping objects on Windows.
+ *
+ * Assumptions:
+ * Mapped file is not modified while it is mapped.
+ * Views returned by this class are not used after it is destroyed.
+ */
+#include "MappedFile.h"
+#include <cstring>
+#include <algorithm>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/** ------------------------------ Constructor ----------------------
+ * Maps the whole file into memory.
+ * @param fileName Name of the file to map.
+ * @pre  None
+ * @post contents() views the file, or is empty if the file could not
+ *         be opened or is empty
+ */
+MappedFile::MappedFile(const string& fileName) : data(nullptr), length(0)
+{
+#ifdef _WIN32
+   HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                             nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+   if (file == INVALID_HANDLE_VALUE) {
+      cerr << "Unable to open " << fileName << ".\n" << endl;
+      return;
+   }
+
+   LARGE_INTEGER fileSize;
+   if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+      HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+      if (mapping != nullptr) {     // View keeps the mapping alive once closed
+         data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+         length = data == nullptr ? 0 : (size_t)fileSize.QuadPart;
+         CloseHandle(mapping);
+      }
+   }
+   CloseHandle(file);
+#else
+   int file = open(fileName.c_str(), O_RDONLY);
+   if (file < 0) {
+      cerr << "Unable to open " << fileName << ".\n" << endl;
+      return;
+   }
+
+   struct stat info;
+   if (fstat(file, &info) == 0 && info.st_size > 0) {
+      void* region = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+      if (region != MAP_FAILED) {   // Mapping stays valid once file is closed
+         madvise(region, info.st_size, MADV_SEQUENTIAL);
+         data = static_cast<const char*>(region);
+         length = info.st_size;
+      }
+   }
+   close(file);
+#endif
+
+   if (data == nullptr)
+      length = 0;
+}
+
+/** ------------------------------ Destructor -------------------------------
+ * Unmaps the file, invalidating every view into it.
+ */
+MappedFile::~MappedFile()
+{
+   if (data == nullptr)
+      return;
+#ifdef _WIN32
+   UnmapViewOfFile(data);
+#else
+   munmap(const_cast<char*>(data), length);
+#endif
+   data = nullptr;
+   length = 0;
+}
+
+/** ----------------------------- nextLine(string_view&) ---------------
+ * Removes the next line from the front of rest.
+ * @param rest Unread part of the file, advanced past the line
+ * @return The line without its line ending
+ */
+string_view MappedFile::nextLine(string_view& rest)
+{
+   const char* end = static_cast<const char*>(memchr(rest.data(), '\n', rest.size()));
+   size_t len = end == nullptr ? rest.size() : end - rest.data();
+   string_view line = rest.substr(0, len);
+
+   rest.remove_prefix(end == nullptr ? len : len + 1);
+   if (!line.empty() && line.back() == '\r')
+      line.remove_suffix(1);
+   return line;
+}
+
+/** ----------------------------- splitLines(string_view, size_t) --------
+ * Splits text into roughly equal chunks that only end at line endings,
+ *   so each chunk can be parsed on its own.
+ * @param text  Text to split
+ * @param parts Desired number of chunks
+ * @return Chunks in file order, empty chunks are left out
+ */
+vector<string_view> MappedFile::splitLines(string_view text, size_t parts)
+{
+   vector<string_view> chunks;
+   size_t target = parts == 0 ? text.size() : text.size() / parts + 1;
+
+   while (!text.empty()) {
+      size_t end = text.find('\n', min(target, text.size()) - 1);
+      size_t len = end == string_view::npos ? text.size() : end + 1;
+
+      chunks.push_back(text.substr(0, len));
+      text.remove_prefix(len);
+   }
+   return chunks;
+}
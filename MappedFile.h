@@ -0,0 +1,94 @@
+/** @file MappedFile.h
+ * @author Korosh Moosavi
+ * @date 2026-10-16
+ *
+ * MappedFile class:
+ * Maps an input file read-only into memory so its records can be parsed
+ *   directly out of the mapped region, without copying each line.
+ * Also holds LoadStats, used to report how fast an input file was loaded.
+ *
+ * Assumptions:
+ * Mapped file is not modified while it is mapped.
+ * Views returned by this class are not used after it is destroyed.
+ */
+#pragma once
+#include <string>
+#include <string_view>
+#include <iostream>
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+/** ------------------------ LoadStats struct --------------------------
+ * Size and duration of loading a single input file
+ * Records counts every non-empty line read, including rejected ones
+ */
+struct LoadStats {
+   uint64_t bytes = 0;
+   uint64_t records = 0;
+   double seconds = 0.0;
+
+   /** ----------------------------- print(ostream&, string) ----------------
+    * Outputs totals and throughput of the load on a single line.
+    * @param output Stream to write to
+    * @param label  Name of the loaded file
+    */
+   void print(ostream& output, const string& label) const
+   {
+      double elapsed = seconds > 0.0 ? seconds : 1e-9;   // Avoid divide by 0
+      output << label << ": " << bytes << " bytes, " << records << " records in "
+         << seconds << " s (" << bytes / elapsed / 1e6 << " MB/s, "
+         << records / elapsed << " records/s)" << endl;
+   };
+};
+
+class MappedFile {
+private:
+   const char* data;
+   size_t length;
+
+public:
+   /** ------------------------------ Constructor ----------------------
+    * Maps the whole file into memory.
+    * @param fileName Name of the file to map.
+    * @pre  None
+    * @post contents() views the file, or is empty if the file could not
+    *         be opened or is empty
+    */
+   MappedFile(const string& fileName);
+
+   /** ------------------------------ Destructor -------------------------------
+    * Unmaps the file, invalidating every view into it.
+    */
+   ~MappedFile();
+
+   MappedFile(const MappedFile&) = delete;
+   MappedFile& operator=(const MappedFile&) = delete;
+
+   /** ----------------------------- contents() ---------------------
+    * @return View of the whole file.
+    */
+   string_view contents() const { return string_view(data, length); };
+
+   /** ----------------------------- size() ---------------------
+    * @return Size of the file in bytes.
+    */
+   size_t size() const { return length; };
+
+   /** ----------------------------- nextLine(string_view&) ---------------
+    * Removes the next line from the front of rest.
+    * @param rest Unread part of the file, advanced past the line
+    * @return The line without its line ending
+    */
+   static string_view nextLine(string_view& rest);
+
+   /** ----------------------------- splitLines(string_view, size_t) --------
+    * Splits text into roughly equal chunks that only end at line endings,
+    *   so each chunk can be parsed on its own.
+    * @param text  Text to split
+    * @param parts Desired number of chunks
+    * @return Chunks in file order, empty chunks are left out
+    */
+   static vector<string_view> splitLines(string_view text, size_t parts);
+};
@@ -0,0 +1,136 @@
+/** @file NameIndex.cpp
+ * @author Korosh Moosavi
+ * @date 2026-10-17
+ *
+ * NameIndex class:
+ * Sorted array of the customers of CustomerRegistry by name, then ID, for
+ *   finding customers by name or by the start of their name.
+ *
+ * Assumptions:
+ * Indexed customers are owned elsewhere and outlive this index.
+ * Names do not contain 0 bytes.
+ */
+#include "NameIndex.h"
+#include <algorithm>
+#include <iterator>
+
+/** ----------------------------- pack(string_view) ---------------------
+ * @param name Name or the start of one
+ * @return First 8 bytes of name, big-endian and padded with 0 bytes, so
+ *           packed names compare like the names they start
+ */
+uint64_t NameIndex::pack(string_view name)
+{
+   uint64_t head = 0;
+
+   for (size_t i = 0; i < 8; i++)
+      head = head << 8 | (i < name.size() ? (uint8_t)name[i] : 0);
+   return head;
+}
+
+/** ----------------------------- isBefore(Entry&, Entry&) ----------------
+ * @return True if a sorts before b, by name and then ID.
+ */
+bool NameIndex::isBefore(const Entry& a, const Entry& b)
+{
+   if (a.head != b.head)
+      return a.head < b.head;
+   int order = a.customer->getName().compare(b.customer->getName());
+   return order != 0 ? order < 0 : a.customer->getId() < b.customer->getId();
+}
+
+/** ----------------------------- build(SearchTree&) ---------------------
+ * Replaces the index with every customer of a tree, which is already in
+ *   name order, so nothing is sorted.
+ * @param tree Customers sorted by name and ID, see Customer::isLess()
+ */
+void NameIndex::build(const SearchTree& tree)
+{
+   sorted.clear();
+   recent.clear();
+   for (SearchTree::Iterator cur = tree.begin(); cur != tree.end(); ++cur) {
+      const Customer* customer = static_cast<const Customer*>(*cur);
+      sorted.push_back({ pack(customer->getName()), customer });
+   }
+}
+
+/** ----------------------------- insert(Customer*) ---------------------
+ * Adds a customer registered after build().
+ * The entry is placed in the recent array, and once that is full both
+ *   arrays are merged in one linear pass.
+ * @param customer Customer not yet in the index
+ */
+void NameIndex::insert(const Customer* customer)
+{
+   Entry entry = { pack(customer->getName()), customer };
+   recent.insert(upper_bound(recent.begin(), recent.end(), entry, isBefore), entry);
+   if (recent.size() < MERGE_SIZE)
+      return;
+
+   vector<Entry> merged;
+   merged.reserve(sorted.size() + recent.size());
+   merge(sorted.begin(), sorted.end(), recent.begin(), recent.end(), back_inserter(merged),
+         isBefore);
+   sorted.swap(merged);
+   recent.clear();
+   merges++;
+}
+
+/** ----------------------------- find(vector, string_view, bool, vector&) -
+ * Appends the customers of one array of entries that match a name.
+ * The first match is found with a binary search that compares packed
+ *   heads, and only reads names of entries whose head ties with the name.
+ * @param entries Sorted entries to search
+ * @param name    Name or start of a name to find
+ * @param prefix  True to match every name starting with name
+ * @param matches Matching entries are appended here, in index order
+ */
+void NameIndex::find(const vector<Entry>& entries, string_view name, bool prefix,
+                     vector<Entry>& matches)
+{
+   uint64_t head = pack(name);
+   auto cut = [&](const Entry& entry) {       // Part of the name compared
+      string_view found = entry.customer->getName();
+      return prefix ? found.substr(0, name.size()) : found;
+   };
+
+   vector<Entry>::const_iterator cur = lower_bound(entries.begin(), entries.end(), name,
+      [&](const Entry& entry, string_view) {
+         return entry.head != head ? entry.head < head : cut(entry) < name;
+      });
+   for (; cur != entries.end() && cut(*cur) == name; ++cur)
+      matches.push_back(*cur);
+}
+
+/** ----------------------------- find(string_view, bool, vector&) --------
+ * Finds every customer with a name, or with a name starting with it.
+ * @param name    Name or start of a name to find
+ * @param prefix  True to match every name starting with name
+ * @param matches Set to the matching customers, sorted by name then ID
+ */
+void NameIndex::find(string_view name, bool prefix, vector<const Customer*>& matches) const
+{
+   vector<Entry> older, newer, all;
+
+   find(sorted, name, prefix, older);
+   find(recent, name, prefix, newer);
+   merge(older.begin(), older.end(), newer.begin(), newer.end(), back_inserter(all), isBefore);
+
+   matches.clear();
+   for (const Entry& entry : all)
+      matches.push_back(entry.customer);
+}
+
+/** ----------------------------- outputStats(ostream&) ---------------------
+ * Outputs the number of customers, bytes used and merges.
+ * @param output Stream to write the statistics to
+ * @pre    None
+ * @post   Statistics are output on a single line
+ */
+void NameIndex::outputStats(ostream& output) const
+{
+   output << "Name index: " << sorted.size() + recent.size() << " customers ("
+      << recent.size() << " recent), "
+      << (sorted.capacity() + recent.capacity()) * sizeof(Entry) << " bytes, "
+      << merges << " merges" << endl;
+}
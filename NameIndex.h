@@ -0,0 +1,97 @@
+/** @file NameIndex.h
+ * @author Korosh Moosavi
+ * @date 2026-10-17
+ *
+ * NameIndex class:
+ * Sorted array of the customers of CustomerRegistry by name, then ID, for
+ *   finding customers by name or by the start of their name.
+ * Each entry keeps the first 8 bytes of the name packed big-endian into an
+ *   integer next to the Customer pointer, so a binary search mostly compares
+ *   integers within a few cache lines and only reads a name when the first
+ *   8 bytes tie. A search costs O(log n + k) for k matching customers.
+ * Customers registered after the index is built go to a small sorted array
+ *   of recent entries, merged into the main one once it holds MERGE_SIZE,
+ *   so no registration moves every entry. Searches look in both.
+ *
+ * Assumptions:
+ * Indexed customers are owned elsewhere and outlive this index.
+ * Names do not contain 0 bytes.
+ * The index is not changed while it is searched.
+ */
+#pragma once
+#include "Customer.h"
+#include "SearchTree.h"
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+class NameIndex {
+private:
+   /** ------------------------ Entry struct --------------------------
+    * Indexed customer, head holds the first 8 bytes of its name
+    */
+   struct Entry {
+      uint64_t head;
+      const Customer* customer;
+   };
+
+   static const size_t MERGE_SIZE = 1024;   // Recent entries before a merge
+
+   vector<Entry> sorted;      // Every entry as of the last merge
+   vector<Entry> recent;      // Entries added since, also sorted
+   uint64_t merges = 0;
+
+   /** ----------------------------- pack(string_view) ---------------------
+    * @param name Name or the start of one
+    * @return First 8 bytes of name, big-endian and padded with 0 bytes, so
+    *           packed names compare like the names they start
+    */
+   static uint64_t pack(string_view name);
+
+   /** ----------------------------- isBefore(Entry&, Entry&) ----------------
+    * @return True if a sorts before b, by name and then ID.
+    */
+   static bool isBefore(const Entry& a, const Entry& b);
+
+   /** ----------------------------- find(vector, string_view, bool, vector&) -
+    * Appends the customers of one array of entries that match a name.
+    * @param entries Sorted entries to search
+    * @param name    Name or start of a name to find
+    * @param prefix  True to match every name starting with name
+    * @param matches Matching entries are appended here, in index order
+    */
+   static void find(const vector<Entry>& entries, string_view name, bool prefix,
+                    vector<Entry>& matches);
+
+public:
+   /** ----------------------------- build(SearchTree&) ---------------------
+    * Replaces the index with every customer of a tree, which is already in
+    *   name order, so nothing is sorted.
+    * @param tree Customers sorted by name and ID, see Customer::isLess()
+    */
+   void build(const SearchTree& tree);
+
+   /** ----------------------------- insert(Customer*) ---------------------
+    * Adds a customer registered after build().
+    * @param customer Customer not yet in the index
+    */
+   void insert(const Customer* customer);
+
+   /** ----------------------------- find(string_view, bool, vector&) --------
+    * Finds every customer with a name, or with a name starting with it.
+    * @param name    Name or start of a name to find
+    * @param prefix  True to match every name starting with name
+    * @param matches Set to the matching customers, sorted by name then ID
+    */
+   void find(string_view name, bool prefix, vector<const Customer*>& matches) const;
+
+   /** ----------------------------- outputStats(ostream&) ---------------------
+    * Outputs the number of customers, bytes used and merges.
+    * @param output Stream to write the statistics to
+    * @pre    None
+    * @post   Statistics are output on a single line
+    */
+   void outputStats(ostream& output) const;
+};
@@ -0,0 +1,42 @@
+/** @file NameQuery.cpp
+ * @author Korosh Moosavi
+ * @date 2026-10-17
+ *
+ * NameQuery class:
+ * Class encompassing the store function to find customers by name or by
+ *   the start of their name.
+ *
+ * Assumptions:
+ * Objects used in this method are valid and initialized.
+ */
+#include "NameQuery.h"
+
+/** ----------------------- process(Inventory&, CustomerRegistry&, Command&, ostream&) ---
+* Parses the name from the command and outputs the matching customers
+*   with outputNamed() of CustomerRegistry.
+* The name is everything after the command letter, so it may contain commas.
+* @param inventory  Not used, remnant of parent class parameter.
+* @param registry   CustomerRegistry storing data on the store's customers.
+* @param command    Parsed transaction line, args hold the name.
+* @param output     Stream the operation's report is written to.
+* @pre    None
+* @return True once output is complete, false if no name is given.
+*/
+bool NameQuery::process(Inventory& inventory, CustomerRegistry& registry, const Command& command,
+                        ostream& output)
+{
+   string_view name = command.args;
+
+   if (name.empty()) {
+      cerr << "Invalid name search entered.\n\n";
+      return false;
+   }
+   output << "Customers with name " << name << ":\n";
+
+   bool prefix = name.back() == '*';
+   if (prefix)
+      name.remove_suffix(1);
+   registry.outputNamed(name, prefix, output);
+   output << '\n';
+   return true;
+}
@@ -0,0 +1,46 @@
+/** @file NameQuery.h
+ * @author Korosh Moosavi
+ * @date 2026-10-17
+ *
+ * NameQuery class:
+ * Class encompassing the store function to find customers by name, so a
+ *   clerk does not need their ID, such as "N, Michael Jordan" for every
+ *   customer with that name. A name ending with '*' matches as a prefix,
+ *   such as "N, Mic*" for every customer whose name starts with "Mic".
+ * Each customer is output with its ID, read from the NameIndex of
+ *   CustomerRegistry.
+ *
+ * Assumptions:
+ * Objects used in this method are valid and initialized.
+ */
+#include "Transaction.h"
+
+class NameQuery : public Transaction {
+public:
+   /** ------------------------------ Default constructor ----------------------
+    * No special operations needed.
+    * @pre  None
+    * @post NameQuery object created.
+    */
+   NameQuery() {};
+
+   /** ------------------------------ Destructor -------------------------------
+    * No special operations needed.
+    * @pre  None
+    * @post Data is deallocated after destruction.
+    */
+   virtual ~NameQuery() {};
+
+   /** -------------- process(Inventory&, CustomerRegistry&, Command&, ostream&) ---
+   * Parses the name from the command and outputs the matching customers
+   *   with outputNamed() of CustomerRegistry.
+   * @param inventory  Not used, remnant of parent class parameter.
+   * @param registry   CustomerRegistry storing data on the store's customers.
+   * @param command    Parsed transaction line, args hold the name.
+   * @param output     Stream the operation's report is written to.
+   * @pre    None
+   * @return True once output is complete, false if no name is given.
+   */
+   bool process(Inventory& inventory, CustomerRegistry& registry, const Command& command,
+                ostream& output);
+};
@@ -0,0 +1,155 @@
+/** @file OutputSink.cpp
+ * @author Korosh Moosavi
+ * @date 2026-10-16
+ *
+ * OutputSink class:
+ * Stream buffer collecting report output in one large reusable buffer and
+ *   passing it on to standard output, a file, or memory only when the buffer
+ *   fills or flush() is called.
+ *
+ * Assumptions:
+ * Only one thread writes to a sink at a time.
+ * Output is only guaranteed to reach its target after flush(), or after an
+ *   ostream using this sink is flushed.
+ */
+#include "OutputSink.h"
+#include <cstring>
+#include <iostream>
+
+/** ------------------------------ Constructor ----------------------
+ * Opens the target and allocates the buffer.
+ * @param where    Where output is sent (default standard output)
+ * @param fileName File to create or truncate, used for TO_FILE only
+ * @param capacity Buffer size in bytes
+ * @post  Ready for output, isOpen() is false if the file could not be
+ *          opened and output is discarded
+ */
+OutputSink::OutputSink(Target where, const string& fileName, size_t capacity)
+   : buffer(capacity == 0 ? 1 : capacity), target(where), file(nullptr),
+     flushes(0), bytes(0)
+{
+   if (target == TO_STDOUT) {
+      file = stdout;
+   } else if (target == TO_FILE) {
+      file = fopen(fileName.c_str(), "wb");
+      if (file == nullptr)
+         cerr << "Unable to open " << fileName << ".\n\n";
+   }
+   setp(buffer.data(), buffer.data() + buffer.size());
+}
+
+/** ------------------------------ Destructor -------------------------------
+ * Flushes remaining output and closes the target file.
+ */
+OutputSink::~OutputSink()
+{
+   flush();
+   if (target == TO_FILE && file != nullptr)
+      fclose(file);
+   file = nullptr;
+}
+
+/** ----------------------------- drain() ---------------------
+ * Passes buffered output on to the target and empties the buffer.
+ * @return True if every byte was passed on.
+ */
+bool OutputSink::drain()
+{
+   size_t count = pptr() - pbase();
+   bool success = true;
+
+   if (count > 0) {
+      if (target == TO_MEMORY)
+         memory.append(pbase(), count);
+      else if (file != nullptr)
+         success = fwrite(pbase(), 1, count, file) == count;
+
+      flushes++;
+      bytes += count;
+   }
+   setp(buffer.data(), buffer.data() + buffer.size());
+   return success;
+}
+
+/** ----------------------------- overflow(int_type) ---------------------
+ * Called by streambuf when the buffer is full.
+ * @param ch Character that did not fit, or eof
+ * @return ch on success, eof if the buffer could not be drained
+ */
+OutputSink::int_type OutputSink::overflow(int_type ch)
+{
+   if (!drain())
+      return traits_type::eof();
+
+   if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+      *pptr() = traits_type::to_char_type(ch);
+      pbump(1);
+   }
+   return traits_type::not_eof(ch);
+}
+
+/** ----------------------------- xsputn(const char*, streamsize) --------
+ * Copies a block of characters into the buffer, writing blocks at least
+ *   as large as the buffer straight to the target.
+ * @param text  Characters to write
+ * @param count Number of characters
+ * @return Number of characters written
+ */
+streamsize OutputSink::xsputn(const char* text, streamsize count)
+{
+   if (count <= epptr() - pptr()) {       // Common case, fits in buffer
+      memcpy(pptr(), text, count);
+      pbump((int)count);
+      return count;
+   }
+
+   if (!drain())
+      return 0;
+
+   if ((size_t)count >= buffer.size()) {  // Too large to be worth copying
+      if (target == TO_MEMORY)
+         memory.append(text, count);
+      else if (file != nullptr && fwrite(text, 1, count, file) != (size_t)count)
+         return 0;
+      flushes++;
+      bytes += count;
+      return count;
+   }
+
+   memcpy(pptr(), text, count);
+   pbump((int)count);
+   return count;
+}
+
+/** ----------------------------- flush() ---------------------
+ * Explicit flush point, passes all buffered output on to the target.
+ * @return True if all output reached the target.
+ */
+bool OutputSink::flush()
+{
+   bool success = drain();
+
+   if (file != nullptr)
+      success = fflush(file) == 0 && success;
+   return success;
+}
+
+/** ----------------------------- contents() ---------------------
+ * Flushes, then returns everything written to a memory sink.
+ * @return Output so far, empty for other targets.
+ */
+const string& OutputSink::contents()
+{
+   drain();
+   return memory;
+}
+
+/** ----------------------------- clear() ---------------------
+ * Discards everything written to a memory sink, keeping its capacity
+ *   so the sink can be reused without allocating.
+ */
+void OutputSink::clear()
+{
+   setp(buffer.data(), buffer.data() + buffer.size());
+   memory.clear();
+}
@@ -0,0 +1,120 @@
+/** @file OutputSink.h
+ * @author Korosh Moosavi
+ * @date 2026-10-16
+ *
+ * OutputSink class:
+ * Stream buffer collecting report output in one large reusable buffer and
+ *   passing it on to standard output, a file, or memory only when the buffer
+ *   fills or flush() is called.
+ * Used through an ostream, so reports are written with operator<< as usual
+ *   but without a write call per line.
+ * The memory target keeps everything written, which is useful for tests and
+ *   for rendering a report to be output later. The discard target only
+ *   counts bytes, for timing report generation without any I/O.
+ *
+ * Assumptions:
+ * Only one thread writes to a sink at a time.
+ * Output is only guaranteed to reach its target after flush(), or after an
+ *   ostream using this sink is flushed.
+ */
+#pragma once
+#include <cstdio>
+#include <cstdint>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+class OutputSink : public streambuf {
+public:
+   enum Target { TO_STDOUT, TO_FILE, TO_MEMORY, TO_DISCARD };
+
+private:
+   static const size_t DEFAULT_CAPACITY = 1 << 16;   // 64 KiB
+
+   vector<char> buffer;
+   Target target;
+   FILE* file;          // Target file, stdout or nullptr for memory/discard
+   string memory;       // Everything flushed to the memory target
+   uint64_t flushes;    // Times buffered output was passed to the target
+   uint64_t bytes;      // Total bytes passed to the target
+
+   /** ----------------------------- drain() ---------------------
+    * Passes buffered output on to the target and empties the buffer.
+    * @return True if every byte was passed on.
+    */
+   bool drain();
+
+protected:
+   /** ----------------------------- overflow(int_type) ---------------------
+    * Called by streambuf when the buffer is full.
+    * @param ch Character that did not fit, or eof
+    * @return ch on success, eof if the buffer could not be drained
+    */
+   int_type overflow(int_type ch) override;
+
+   /** ----------------------------- xsputn(const char*, streamsize) --------
+    * Copies a block of characters into the buffer, writing blocks at least
+    *   as large as the buffer straight to the target.
+    * @param text  Characters to write
+    * @param count Number of characters
+    * @return Number of characters written
+    */
+   streamsize xsputn(const char* text, streamsize count) override;
+
+   /** ----------------------------- sync() ---------------------
+    * Called when an ostream using this sink is flushed.
+    * @return 0 on success, -1 on failure
+    */
+   int sync() override { return flush() ? 0 : -1; };
+
+public:
+   /** ------------------------------ Constructor ----------------------
+    * Opens the target and allocates the buffer.
+    * @param where    Where output is sent (default standard output)
+    * @param fileName File to create or truncate, used for TO_FILE only
+    * @param capacity Buffer size in bytes
+    * @post  Ready for output, isOpen() is false if the file could not be
+    *          opened and output is discarded
+    */
+   OutputSink(Target where = TO_STDOUT, const string& fileName = "",
+              size_t capacity = DEFAULT_CAPACITY);
+
+   /** ------------------------------ Destructor -------------------------------
+    * Flushes remaining output and closes the target file.
+    */
+   ~OutputSink();
+
+   OutputSink(const OutputSink&) = delete;
+   OutputSink& operator=(const OutputSink&) = delete;
+
+   /** ----------------------------- flush() ---------------------
+    * Explicit flush point, passes all buffered output on to the target.
+    * @return True if all output reached the target.
+    */
+   bool flush();
+
+   /** ----------------------------- isOpen() ---------------------
+    * @return True if output is reaching a target.
+    */
+   bool isOpen() const { return target == TO_MEMORY || target == TO_DISCARD || file != nullptr; };
+
+   /** ----------------------------- contents() ---------------------
+    * Flushes, then returns everything written to a memory sink.
+    * @return Output so far, empty for other targets.
+    */
+   const string& contents();
+
+   /** ----------------------------- clear() ---------------------
+    * Discards everything written to a memory sink, keeping its capacity
+    *   so the sink can be reused without allocating.
+    */
+   void clear();
+
+   /** ----------------------------- Statistics ---------------------
+    * Bytes and number of flushes passed on to the target so far.
+    */
+   uint64_t getFlushes() const { return flushes; };
+   uint64_t getBytes() const { return bytes; };
+};
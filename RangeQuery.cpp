@@ -0,0 +1,82 @@
+/** @file RangeQuery.cpp
+ * @author Korosh Moosavi
+ * @date 2026-10-17
+ *
+ * RangeQuery class:
+ * Class encompassing the store function to output every item of a category
+ *   within a range of its sort order.
+ *
+ * Assumptions:
+ * Objects used in this method are valid and initialized.
+ */
+#include "RangeQuery.h"
+
+/** ----------------------- process(Inventory&, CustomerRegistry&, Command&, ostream&) ---
+* Parses the category symbol, text fields and years from the command into
+*   an ItemRange and outputs the matching items with outputRange() of
+*   Inventory, or with outputRangeInStock() after a leading "+".
+* Fields are read as text up to the number of text fields of the category,
+*   and anything after them as years.
+* @param inventory  Inventory storing data on the store's current items.
+* @param registry   Not used, remnant of parent class parameter.
+* @param command    Parsed transaction line, args hold "symbol, fields",
+*                     optionally after "+".
+* @param output     Stream the operation's report is written to.
+* @pre    None
+* @return True once output is complete, false if the category is not
+*           recognized or the range is malformed.
+*/
+bool RangeQuery::process(Inventory& inventory, CustomerRegistry& registry, const Command& command,
+                         ostream& output)
+{
+   string_view rest = command.args;
+   bool inStock = rest.substr(0, 1) == "+";
+   if (inStock)
+      CommandParser::nextField(rest);
+
+   string_view query = CommandParser::trim(rest);   // Echoed without "+"
+   string_view symbol = CommandParser::nextField(rest);
+   ItemRange range;
+   const char* heading = inStock ? "Items in stock in range " : "Items in range ";
+
+   if (symbol.size() != 1 || !Factory::isRecognized(symbol[0])) {
+      cerr << "Unrecognized Collectible entered.\n\n";
+      return false;
+   }
+   range.symbol = symbol[0];
+
+   int textFields = inventory.getSortTextFields(range.symbol);
+   if (textFields == 0) {              // No items to match the fields with
+      output << heading << query << ":\n\n";
+      return true;
+   }
+
+   bool valid = true;
+   while (!rest.empty() && range.count < textFields && !range.prefix) {
+      string_view field = CommandParser::nextField(rest);
+      range.prefix = !field.empty() && field.back() == '*';
+      if (range.prefix)
+         field.remove_suffix(1);
+      range.fields[range.count++] = field;
+   }
+   if (!rest.empty()) {                // Years, after every text field
+      valid = !range.prefix && range.count == textFields &&
+              CommandParser::toInt(CommandParser::nextField(rest), range.firstYear);
+      range.lastYear = range.firstYear;
+      if (valid && !rest.empty())
+         valid = CommandParser::toInt(CommandParser::nextField(rest), range.lastYear) &&
+                 rest.empty() && range.firstYear <= range.lastYear;
+   }
+   if (!valid) {
+      cerr << "Invalid range query entered.\n\n";
+      return false;
+   }
+
+   output << heading << query << ":\n";
+   if (inStock)
+      inventory.outputRangeInStock(range, output);
+   else
+      inventory.outputRange(range, output);
+   output << '\n';
+   return true;
+}
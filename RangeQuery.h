@@ -0,0 +1,55 @@
+/** @file RangeQuery.h
+ * @author Korosh Moosavi
+ * @date 2026-10-17
+ *
+ * RangeQuery class:
+ * Class encompassing the store function to output every item of a category
+ *   within a range of its sort order. The fields after the category symbol
+ *   are the text fields the category is sorted by, then optionally a year
+ *   or a first and last year:
+ *      Coin        - type                 "Q, M, Cent, 1909, 1958"
+ *      Comic Book  - publisher, title     "Q, C, Marvel, X-Men, 1963"
+ *      Sports Card - player               "Q, S, Mickey Mantle, 1950, 1959"
+ *   Trailing text fields can be left out, and the last text field given
+ *   matches as a prefix when it ends with '*', such as "Q, S, Mick*".
+ * Items are found with a single search of the category's SearchTree, see
+ *   Inventory::outputRange().
+ * A leading "+" limits the query to items in stock, such as "Q, +, M, Cent".
+ *
+ * Assumptions:
+ * Objects used in this method are valid and initialized.
+ */
+#include "Transaction.h"
+
+class RangeQuery : public Transaction {
+public:
+   /** ------------------------------ Default constructor ----------------------
+    * No special operations needed.
+    * @pre  None
+    * @post RangeQuery object created.
+    */
+   RangeQuery() {};
+
+   /** ------------------------------ Destructor -------------------------------
+    * No special operations needed.
+    * @pre  None
+    * @post Data is deallocated after destruction.
+    */
+   virtual ~RangeQuery() {};
+
+   /** -------------- process(Inventory&, CustomerRegistry&, Command&, ostream&) ---
+   * Parses the category symbol, text fields and years from the command into
+   *   an ItemRange and outputs the matching items with outputRange() of
+   *   Inventory, or with outputRangeInStock() after a leading "+".
+   * @param inventory  Inventory storing data on the store's current items.
+   * @param registry   Not used, remnant of parent class parameter.
+   * @param command    Parsed transaction line, args hold "symbol, fields",
+   *                     optionally after "+".
+   * @param output     Stream the operation's report is written to.
+   * @pre    None
+   * @return True once output is complete, false if the category is not
+   *           recognized or the range is malformed.
+   */
+   bool process(Inventory& inventory, CustomerRegistry& registry, const Command& command,
+                ostream& output);
+};
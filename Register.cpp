@@ -0,0 +1,30 @@
+/** @file Register.cpp
+ * @author Korosh Moosavi
+ * @date 2026-10-16
+ *
+ * Register class:
+ * Class encompassing the store function to register a new customer while
+ *   transactions are processed.
+ *
+ * Assumptions:
+ * Objects used in this method are valid and initialized.
+ */
+#include "Register.h"
+
+/** ---------------- process(Inventory&, CustomerRegistry&, Command&, ostream&) ---
+ * Adds the customer named after the customer ID to the registry.
+ * @param inventory  Not used, remnant of parent class parameter.
+ * @param registry   CustomerRegistry object containing customer data.
+ * @param command    Parsed transaction line, args hold "ID, name".
+ * @param output     Not used, registering outputs nothing on success.
+ * @pre    None
+ * @return Returns true if the customer was registered, false if not.
+ */
+bool Register::process(Inventory& inventory, CustomerRegistry& registry, const Command& command,
+                       ostream& output)
+{
+   string_view rest = command.args;
+
+   CommandParser::nextField(rest);           // Skip the customer ID
+   return registry.registerCustomer(command.customerId, CommandParser::trim(rest));
+}
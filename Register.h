@@ -0,0 +1,41 @@
+/** @file Register.h
+ * @author Korosh Moosavi
+ * @date 2026-10-16
+ *
+ * Register class:
+ * Class encompassing the store function to register a new customer while
+ *   transactions are processed, such as "R, 1000042, Jane Doe".
+ *
+ * Assumptions:
+ * Objects used in this method are valid and initialized.
+ */
+#include "Transaction.h"
+
+class Register : public Transaction {
+public:
+   /** ------------------------------ Default constructor ----------------------
+    * No special operations needed.
+    * @pre  None
+    * @post Register object created.
+    */
+   Register() {};
+
+   /** ------------------------------ Destructor -------------------------------
+    * No special operations needed.
+    * @pre  None
+    * @post Data is deallocated after destruction.
+    */
+   virtual ~Register() {};
+
+   /** ---------------- process(Inventory&, CustomerRegistry&, Command&, ostream&) ---
+    * Adds the customer named after the customer ID to the registry.
+    * @param inventory  Not used, remnant of parent class parameter.
+    * @param registry   CustomerRegistry object containing customer data.
+    * @param command    Parsed transaction line, args hold "ID, name".
+    * @param output     Not used, registering outputs nothing on success.
+    * @pre    None
+    * @return Returns true if the customer was registered, false if not.
+    */
+   bool process(Inventory& inventory, CustomerRegistry& registry, const Command& command,
+                ostream& output);
+};
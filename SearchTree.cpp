@@ -1,176 +1,397 @@
-/** @file SearchTree.cpp
- * @author Korosh Moosavi
- * @date 2021-03-12
- *
- * SearchTree class:
- * This cpp file contains all the methods and functions relating to creating and
- *  managing a binary search tree storing Hashable objects.
- * The node struct is implemented within this file.
- * 
- * Assumptions:
- * Hashable has operator== and operator< overloaded
- */
-#include "SearchTree.h"
-
- /** ------------------------ ItemNode struct --------------------------
- * Node storing a Hashable item
- * Left pointer points to Hashables with lower priority
- * Right pointer points to Hashables with higher priority
- *
- * Default and Hashable constructors included for ease of use
- * Destructor recursively deletes all linked descendant nodes
- * @param itemIn Hashable object to be stored in a node
- */
-struct SearchTree::ItemNode
-{
-   Hashable* item;
-
-   ItemNode* left;
-   ItemNode* right;
-
-   ItemNode() : item(nullptr), left(nullptr), right(nullptr) {};
-   ItemNode(Hashable* itemIn) : item(itemIn), left(nullptr), right(nullptr) {};
-   
-   ~ItemNode() {
-      if (left != nullptr)
-         delete left;
-      if (right != nullptr)
-         delete right;
-      if (item != nullptr)
-         delete item;
-      
-      left = nullptr;
-      right = nullptr;
-      item = nullptr;
-   }
-}; // end ItemNode
-
-/** ------------------------ Destructor --------------------------
- * Deletes the root node of the tree, which will recursively delete
- *   all descendant nodes using its own destructor
- */
-SearchTree::~SearchTree()
-{
-   if (root != nullptr) {  // Prevent segmentation fault on empty tree delete
-      delete root;
-      root = nullptr;
-   }
-} // end Destructor
-
-/** ------------------- insert(Hashable*, ItemNode*&) ---------------------
- * Adds a new Hashable to BST
- * Recursively searches then inserts
- * @param key Hashable object being added to the BST
- * @param subRoot Node to start search at, for insertion
- * @pre    None
- * @post   Hashable key exists in the tree
- * @return Returns true if new insertion is made, false if key already exists
- */
-bool SearchTree::insert(Hashable* key, ItemNode*& subRoot)
-{
-   if (subRoot == nullptr) {                 // No root for BST
-      subRoot = new ItemNode(key);
-      return true;
-
-   } else if (*key == *subRoot->item) {      // Key found
-      return false;
-
-   } else if (*key < *subRoot->item) {       // Search lower priority nodes
-      if (subRoot->left == nullptr) {        // Empty node where key should be
-         subRoot->left = new ItemNode(key);
-         return true;
-
-      } else {
-         return insert(key, subRoot->left);  // Continue search
-      }
-
-   } else {                                  // Search higher priority nodes
-      if (subRoot->right == nullptr) {       // Empty node where key should be
-         subRoot->right = new ItemNode(key);
-         return true;
-
-      } else {
-         return insert(key, subRoot->right); // Continue search
-      }
-   }
-} // end insert
-
-/** ------------------------ retrieve(Hashable*) --------------------------
- * Finds node containing key and returns that Hashable object
- * @param key Hashable item to search for
- * @pre    None
- * @post   None
- * @return Returns key if found, nullptr if not found
- */
-Hashable* SearchTree::retrieve(const Hashable* key) const
-{
-   if (root == nullptr) {     // No root for BST
-      return nullptr;
-   }
-
-   ItemNode* cur = search(key);
-
-   if (cur == nullptr) {      // Key not found
-      return nullptr;
-   }
-
-   return cur->item;
-} // end retrieve
-
-/** ------------------------ search(Hashable*) --------------------------
- * Searches BST beginning at root for node containing key
- * @param key Hashable item to search for
- * @pre    None
- * @post   None
- * @return Returns node containing key if found, nullptr if not found
- */
-SearchTree::ItemNode* SearchTree::search(const Hashable* key) const
-{
-   ItemNode* cur = root;      // Start search at root of BST
-
-   while (cur != nullptr && *cur->item != *key) {  // Find key
-      if (*key < *cur->item) {
-         cur = cur->left;
-      } else {
-         cur = cur->right;
-      }
-   }
-
-   return cur;                // Return results (nullptr if not found)
-}
-
-/** ------------------------ operator<< Helper --------------------------
- * Helper method for calling operator<<(ItemNode*) without exposing root
- */
-ostream& operator<<(ostream& output, const SearchTree& tree)
-{
-   if (tree.root != nullptr) {   // Check for empty tree
-      output << tree.root;       // Output if it contains data
-
-   } else {
-      output << "Tree is empty.";// Output message indicating empty tree
-   }
-   return output;
-} // end operator<<() overload helper
-
-/** ------------------------ operator<< --------------------------
- * Recursively prints to a list of each Hashable in the BST per line (inorder)
- * @param output  Ostream accepted and returned to allow chaining outputs
- * @param subRoot Node to print subtree at
- * @pre  None
- * @post Contents of tree are output
- */
-ostream& operator<<(ostream& output, const SearchTree::ItemNode* subRoot)
-{ // Inorder
-   if (subRoot->left != nullptr) {
-      output << subRoot->left;         // Print left branch
-   }
-
-   output << *subRoot->item << endl;   //Print node
-
-   if (subRoot->right != nullptr) {
-      output << subRoot->right;        // Print right branch
-   }
-
-   return output;
-} //  end operator<< overload
\ No newline at end of file
+/** @file SearchTree.cpp
+ * @author Korosh Moosavi
+ * @date 2021-03-12
+ *
+ * SearchTree class:
+ * This cpp file contains all the methods and functions relating to creating and
+ *  managing a binary search tree storing Hashable objects.
+ * The node struct is implemented within this file.
+ * 
+ * Assumptions:
+ * Hashable has operator== and operator< overloaded, and operator< orders
+ *   every pair of unequal items.
+ */
+#include "SearchTree.h"
+#include <algorithm>
+
+ /** ------------------------ ItemNode struct --------------------------
+ * Node storing a Hashable item
+ * Left pointer points to Hashables with lower priority
+ * Right pointer points to Hashables with higher priority
+ * Height is the number of nodes on the longest path down to a leaf
+ *
+ * Default and Hashable constructors included for ease of use
+ * Nodes live in the tree's Arena and are never deleted one at a time
+ * @param itemIn Hashable object to be stored in a node
+ */
+struct SearchTree::ItemNode
+{
+   Hashable* item;
+
+   ItemNode* left;
+   ItemNode* right;
+   int height;
+
+   ItemNode() : item(nullptr), left(nullptr), right(nullptr), height(1) {};
+   ItemNode(Hashable* itemIn) : item(itemIn), left(nullptr), right(nullptr), height(1) {};
+}; // end ItemNode
+
+/** ------------------------ Destructor --------------------------
+ * Deletes the items stored if the tree owns them, then releases every
+ *   node at once with the node Arena.
+ * Teardown is iterative, so deep trees cannot overflow the call stack
+ */
+SearchTree::~SearchTree()
+{
+   ItemNode* cur = ownsItems ? root : nullptr;
+
+   while (cur != nullptr) {
+      if (cur->left != nullptr) {      // Rotate left child up until the
+         ItemNode* temp = cur->left;   //   current node has no left branch
+         cur->left = temp->right;
+         temp->right = cur;
+         cur = temp;
+
+      } else {                         // Nothing lower remains, delete item
+         delete cur->item;             //   and continue down the right branch
+         cur->item = nullptr;
+         cur = cur->right;
+      }
+   }
+   root = nullptr;
+} // end Destructor, nodes are released by the Arena
+
+/** ------------------------ height(ItemNode*) --------------------------
+ * @param subRoot Node to get the height of, may be nullptr
+ * @return Height of the subtree, 0 for an empty subtree
+ */
+int SearchTree::height(const ItemNode* subRoot)
+{
+   return subRoot == nullptr ? 0 : subRoot->height;
+}
+
+/** ------------------------ rotateLeft(ItemNode*&) ---------------------
+ * Lifts the right child of subRoot into its place.
+ * @param subRoot Link to the subtree being rotated, updated in place
+ * @pre    subRoot and its right child are not nullptr
+ * @post   Inorder sequence is unchanged, heights are recalculated
+ */
+void SearchTree::rotateLeft(ItemNode*& subRoot)
+{
+   ItemNode* pivot = subRoot->right;
+
+   subRoot->right = pivot->left;
+   pivot->left = subRoot;
+   subRoot->height = 1 + max(height(subRoot->left), height(subRoot->right));
+   pivot->height = 1 + max(height(pivot->left), height(pivot->right));
+   subRoot = pivot;
+}
+
+/** ------------------------ rotateRight(ItemNode*&) --------------------
+ * Lifts the left child of subRoot into its place.
+ * @param subRoot Link to the subtree being rotated, updated in place
+ * @pre    subRoot and its left child are not nullptr
+ * @post   Inorder sequence is unchanged, heights are recalculated
+ */
+void SearchTree::rotateRight(ItemNode*& subRoot)
+{
+   ItemNode* pivot = subRoot->left;
+
+   subRoot->left = pivot->right;
+   pivot->right = subRoot;
+   subRoot->height = 1 + max(height(subRoot->left), height(subRoot->right));
+   pivot->height = 1 + max(height(pivot->left), height(pivot->right));
+   subRoot = pivot;
+}
+
+/** ------------------------ rebalance(ItemNode*&) ----------------------
+ * Recalculates the height of subRoot and applies a single or double
+ *   rotation if its children differ in height by more than one.
+ * @param subRoot Link to the subtree being rebalanced, updated in place
+ * @pre    Both children of subRoot are balanced
+ * @post   subRoot is balanced and its height is current
+ */
+void SearchTree::rebalance(ItemNode*& subRoot)
+{
+   int balance = height(subRoot->left) - height(subRoot->right);
+
+   if (balance > 1) {                              // Left side too tall
+      if (height(subRoot->left->left) < height(subRoot->left->right))
+         rotateLeft(subRoot->left);                // Left-right case
+      rotateRight(subRoot);
+
+   } else if (balance < -1) {                      // Right side too tall
+      if (height(subRoot->right->right) < height(subRoot->right->left))
+         rotateRight(subRoot->right);              // Right-left case
+      rotateLeft(subRoot);
+
+   } else {
+      subRoot->height = 1 + max(height(subRoot->left), height(subRoot->right));
+   }
+}
+
+/** ------------------------ compare(Hashable&, Hashable&) --------------
+ * Decides where key belongs relative to item with a single comparison of
+ *   their sort keys, comparing full fields only when the keys tie.
+ * The order must be total: an unequal item that ties with key could be
+ *   rotated into either subtree, where insert and search would miss it.
+ * @return 0 if key is equal to item, negative if key belongs in the left
+ *           subtree of item, positive if it belongs in the right subtree
+ */
+int SearchTree::compare(const Hashable& key, const Hashable& item)
+{
+   int order = key.getSortKey().compare(item.getSortKey());
+
+   if (order != 0)                           // Decided by the keys alone
+      return order;
+   if (key.isEqual(item))
+      return 0;
+   return key < item ? -1 : 1;               // Unequal items never tie
+}
+
+/** --------------------------- insert(Hashable*) -------------------------
+ * Adds a new Hashable to the BST then rebalances along the insertion path
+ * Iteratively searches then inserts
+ * @param key Item being added to the BST
+ * @pre    None
+ * @post   key has been added to the tree in its proper place
+ * @return True if insert was successful, false if key already exists
+ */
+bool SearchTree::insert(Hashable* key)
+{
+   ItemNode** path[MAX_HEIGHT];              // Links followed from the root
+   int depth = 0;
+   ItemNode** link = &root;
+
+   while (*link != nullptr) {                // Find empty node where key goes
+      int order = compare(*key, *(*link)->item);
+      if (order == 0)                        // Key found
+         return false;
+
+      path[depth++] = link;
+      if (order < 0)                         // Search lower priority nodes
+         link = &(*link)->left;
+      else                                   // Search higher priority nodes
+         link = &(*link)->right;
+   }
+   *link = nodes.create<ItemNode>(key);
+
+   while (depth > 0) {                       // Retrace path back to the root
+      ItemNode*& subRoot = *path[--depth];
+      int oldHeight = subRoot->height;
+
+      rebalance(subRoot);
+      if (subRoot->height == oldHeight)      // Ancestors are unaffected
+         break;
+   }
+   return true;
+} // end insert
+
+/** ------------------------ build(vector<Hashable*>&) --------------------
+ * Fills an empty tree with items already in sorted order, without
+ *   comparing them, such as items saved by collect().
+ * @param sorted Items in the order they are to be output
+ * @pre    Tree is empty, sorted is in the order insert() would give
+ * @post   Tree holds every item of sorted and is balanced
+ * @return True if the tree was built, false if it was not empty
+ */
+bool SearchTree::build(const vector<Hashable*>& sorted)
+{
+   if (root != nullptr)
+      return false;
+   root = buildBalanced(sorted.data(), sorted.size());
+   return true;
+} // end build
+
+/** ------------------------ buildBalanced(Hashable* const*, size_t) -----
+ * Builds a perfectly balanced subtree out of sorted items.
+ * Recursion is only as deep as the height of the result.
+ * @param sorted Items in the order they are to be output
+ * @param count  Number of items
+ * @return Root of the new subtree, nullptr if count is 0
+ */
+SearchTree::ItemNode* SearchTree::buildBalanced(Hashable* const* sorted, size_t count)
+{
+   if (count == 0)
+      return nullptr;
+
+   size_t middle = count / 2;
+   ItemNode* subRoot = nodes.create<ItemNode>(sorted[middle]);
+
+   subRoot->left = buildBalanced(sorted, middle);
+   subRoot->right = buildBalanced(sorted + middle + 1, count - middle - 1);
+   subRoot->height = max(height(subRoot->left), height(subRoot->right)) + 1;
+   return subRoot;
+}
+
+/** ------------------------ collect(vector<Hashable*>&) ------------------
+ * Appends every item to sorted, in the order they are output.
+ * @param sorted Vector to append the items to
+ */
+void SearchTree::collect(vector<Hashable*>& sorted) const
+{
+   for (Iterator cur = begin(); cur != end(); ++cur)
+      sorted.push_back(*cur);
+} // end collect
+
+/** ------------------------ descend(ItemNode*) ---------------------
+ * Pushes subRoot and its left branch, so its lowest item is next.
+ */
+void SearchTree::Iterator::descend(const ItemNode* subRoot)
+{
+   while (subRoot != nullptr) {
+      pending[depth++] = subRoot;
+      subRoot = subRoot->left;
+   }
+}
+
+/** ------------------------ operator* --------------------------
+ * @pre    Iterator is not at the end
+ * @return Current item
+ */
+Hashable* SearchTree::Iterator::operator*() const
+{
+   return pending[depth - 1]->item;
+}
+
+/** ------------------------ operator++ --------------------------
+ * Moves to the next item in order: the lowest item of the right branch of
+ *   the current node if it has one, otherwise the closest ancestor that
+ *   was reached through its left branch, which is already on the stack.
+ * @pre    Iterator is not at the end
+ */
+SearchTree::Iterator& SearchTree::Iterator::operator++()
+{
+   const ItemNode* visited = pending[--depth];
+
+   descend(visited->right);
+   return *this;
+}
+
+/** ------------------------ begin() --------------------------
+ * @return Iterator at the lowest item, end() if the tree is empty
+ */
+SearchTree::Iterator SearchTree::begin() const
+{
+   Iterator first;
+
+   first.descend(root);
+   return first;
+}
+
+/** ------------------------ seek(Hashable*) --------------------------
+ * Finds where key is, or would be, in O(log n).
+ * Only nodes at or after key are pushed on the way down, so the stack
+ *   ends up exactly as if the iterator had been advanced up to key.
+ * @param key Item to start at, which does not have to be in the tree
+ * @return Iterator at key if it is stored, otherwise at the first item
+ *           after it, or end() if there is none
+ */
+SearchTree::Iterator SearchTree::seek(const Hashable* key) const
+{
+   Iterator found;
+   const ItemNode* cur = root;
+
+   while (cur != nullptr) {
+      int order = compare(*key, *cur->item);
+      if (order <= 0) {                // Node is at or after key
+         found.pending[found.depth++] = cur;
+         if (order == 0)
+            break;
+         cur = cur->left;
+      } else {                         // Node comes before key, skip it
+         cur = cur->right;
+      }
+   }
+   return found;
+}
+
+/** ------------------------ seek(function) --------------------------
+ * Finds the start of a range of items in O(log n), such as every item
+ *   with a given field, without building a key to search for.
+ * @param before True for items that come before the range. Must be true
+ *                 for every item up to some point and false after it.
+ * @return Iterator at the first item before is false for, or end() if
+ *           there is none
+ */
+SearchTree::Iterator SearchTree::seek(const function<bool(const Hashable&)>& before) const
+{
+   Iterator found;
+   const ItemNode* cur = root;
+
+   while (cur != nullptr) {
+      if (before(*cur->item)) {        // Node comes before the range
+         cur = cur->right;
+      } else {                         // Node is in or after the range
+         found.pending[found.depth++] = cur;
+         cur = cur->left;
+      }
+   }
+   return found;
+}
+
+/** ------------------------ retrieve(Hashable*) --------------------------
+ * Finds node containing key and returns that Hashable object
+ * @param key Hashable item to search for
+ * @pre    None
+ * @post   None
+ * @return Returns key if found, nullptr if not found
+ */
+Hashable* SearchTree::retrieve(const Hashable* key) const
+{
+   if (root == nullptr) {     // No root for BST
+      return nullptr;
+   }
+
+   ItemNode* cur = search(key);
+
+   if (cur == nullptr) {      // Key not found
+      return nullptr;
+   }
+
+   return cur->item;
+} // end retrieve
+
+/** ------------------------ search(Hashable*) --------------------------
+ * Searches BST beginning at root for node containing key
+ * @param key Hashable item to search for
+ * @pre    None
+ * @post   None
+ * @return Returns node containing key if found, nullptr if not found
+ */
+SearchTree::ItemNode* SearchTree::search(const Hashable* key) const
+{
+   ItemNode* cur = root;      // Start search at root of BST
+
+   while (cur != nullptr) {   // Find key
+      int order = compare(*key, *cur->item);
+      if (order == 0) {
+         break;
+      } else if (order < 0) {
+         cur = cur->left;
+      } else {
+         cur = cur->right;
+      }
+   }
+
+   return cur;                // Return results (nullptr if not found)
+}
+
+/** ------------------------ operator<< --------------------------
+ * Prints to a list of each Hashable in the BST per line (inorder)
+ * Traversal uses an Iterator, so output depth is not limited by the
+ *   call stack
+ * @param output  Ostream accepted and returned to allow chaining outputs
+ * @param tree    Tree to print
+ * @pre  None
+ * @post Contents of tree are output
+ */
+ostream& operator<<(ostream& output, const SearchTree& tree)
+{
+   if (tree.root == nullptr)     // Output message indicating empty tree
+      return output << "Tree is empty.";
+
+   for (SearchTree::Iterator cur = tree.begin(); cur != tree.end(); ++cur)
+      output << **cur << '\n';   // Print node
+   return output;
+} // end operator<< overload
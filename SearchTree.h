@@ -1,112 +1,260 @@
-/** @file SearchTree.cpp
- * @author Korosh Moosavi
- * @date 2021-03-12
- * 
- * SearchTree class:
- * This header file contains all the method headers relating to creating and
- *  managing a binary search tree storing Hashable objects.
- * The node struct is implemented within the .cpp file.
- * One-line methods have been defined here in the .h file.
- *
- * Assumptions:
- * Hashable has operator== and operator< overloaded
- */
-#pragma once
-#include <string>
-#include <iostream>
-#include "Hashable.h"
-
-using namespace std;
-
-class SearchTree
-{
-private:
-   /** ------------------------ ItemNode struct --------------------------
-    * Implementation is in the .cpp file
-    * Node storing a Hashable item
-    * Left pointer points to Hashables with lower priority
-    * Right pointer points to Hashables with higher priority
-    *
-    * Default and Hashable constructors included for ease of use
-    * Destructor recursively deletes all linked descendant nodes
-    * @param itemIn Hashable object to be stored in a node
-    */
-   struct ItemNode;
-
-   ItemNode* root;
-
-   /** ------------------- insert(Hashable*, ItemNode*&) ---------------------
-    * Adds a new Hashable to BST
-    * Recursively searches then inserts
-    * @param key Hashable object being added to the BST
-    * @param subRoot Node to start search at, for insertion
-    * @pre    None
-    * @post   Hashable key exists in the tree
-    * @return Returns true if new insertion is made, false if key already exists
-    */
-   bool insert(Hashable* key, ItemNode*& subRoot);
-
-   /** ------------------------ search(Hashable*) --------------------------
-    * Searches BST beginning at root for node containing key
-    * @param key Hashable item to search for
-    * @pre    None
-    * @post   None
-    * @return Returns node containing key if found, nullptr if not found
-    */
-   SearchTree::ItemNode* search(const Hashable* key) const;
-
-   /** ------------------------ operator<< --------------------------
-    * Recursively prints to a list of each Hashable in the BST per line (inorder)
-    * @param output  Ostream accepted and returned to allow chaining outputs
-    * @param subRoot Node to print subtree at
-    * @pre  None
-    * @post Contents of tree are output
-    */
-   friend ostream& operator<<(ostream& output, const ItemNode* subRoot);
-
-public:
-   // ------------------------------ Constructor -----------------------------
-   SearchTree() : root(nullptr) {};
-
-   /** ------------------------ Destructor --------------------------
-    * Deletes the root node of the tree, which will recursively delete
-    *   all descendant nodes using its own destructor
-    */
-   ~SearchTree();
-
-   /** --------------------------- isEmpty() -------------------------
-    * Check if the tree is storing any data.
-    * @pre  None
-    * @post None
-    * @return True if root is unoccupied, false if not
-    */
-   bool isEmpty() { return root == nullptr; };
-
-   /** --------------------------- insert(Hashable*) -------------------------
-    * Helper method for insert(Hashable*, ItemNode*&) without exposing root
-    * @param key Item being added to the BST
-    * @pre    root is not nullptr
-    * @post   key has been added to the tree in its proper place
-    * @return True if insert was successful, false if not
-    */
-   bool insert(Hashable* key) { return insert(key, root); };
-
-   /** ------------------------ retrieve(Hashable*) --------------------------
-    * Finds node containing key and returns that Hashable object
-    * @param key Hashable item to search for
-    * @pre    None
-    * @post   None
-    * @return Returns key if found, nullptr if not found
-    */
-   Hashable* retrieve(const Hashable* key) const;
-
-   /** ------------------------ operator<< Helper --------------------------
-    * Helper method for calling operator<<(ItemNode*) without exposing root
-    */
-   friend ostream& operator<<(ostream& output, const SearchTree& tree);
-};
-
-/** ------------------------ operator<< Helper --------------------------
- * Helper method for calling operator<<(ItemNode*) without exposing root
- */
-ostream& operator<<(ostream&, const SearchTree&);
+/** @file SearchTree.cpp
+ * @author Korosh Moosavi
+ * @date 2021-03-12
+ * 
+ * SearchTree class:
+ * This header file contains all the method headers relating to creating and
+ *  managing a binary search tree storing Hashable objects.
+ * The tree is kept height-balanced (AVL) so lookups stay O(log n) regardless
+ *  of the order items are inserted in, e.g. pre-sorted input files.
+ * The node struct is implemented within the .cpp file.
+ * One-line methods have been defined here in the .h file.
+ * Items are enumerated in order with an Iterator, which can also start at
+ *   any key with seek(), so a caller can walk part of a tree, stop, and
+ *   resume later without visiting the items before it.
+ *
+ * Assumptions:
+ * Hashable has operator== and operator< overloaded, and operator< orders
+ *   every pair of unequal items, so no two distinct items tie.
+ */
+#pragma once
+#include <functional>
+#include <string>
+#include <iostream>
+#include <vector>
+#include "Hashable.h"
+#include "Arena.h"
+
+using namespace std;
+
+class SearchTree
+{
+private:
+   /** ------------------------ ItemNode struct --------------------------
+    * Implementation is in the .cpp file
+    * Node storing a Hashable item
+    * Left pointer points to Hashables with lower priority
+    * Right pointer points to Hashables with higher priority
+    *
+    * Height is the number of nodes on the longest path down to a leaf
+    *
+    * Default and Hashable constructors included for ease of use
+    * Nodes live in the tree's Arena and are never deleted one at a time
+    * @param itemIn Hashable object to be stored in a node
+    */
+   struct ItemNode;
+
+   ItemNode* root;
+   Arena nodes;            // Every node of this tree, released together
+   bool ownsItems;         // Items are deleted with the tree
+
+   // An AVL tree of height 64 needs more than 10^13 nodes, so a fixed-size
+   //   path stack is always large enough for insertion and traversal
+   static const int MAX_HEIGHT = 64;
+
+   /** ------------------------ height(ItemNode*) --------------------------
+    * @param subRoot Node to get the height of, may be nullptr
+    * @return Height of the subtree, 0 for an empty subtree
+    */
+   static int height(const ItemNode* subRoot);
+
+   /** ------------------------ rotateLeft(ItemNode*&) ---------------------
+    * Lifts the right child of subRoot into its place.
+    * @param subRoot Link to the subtree being rotated, updated in place
+    * @pre    subRoot and its right child are not nullptr
+    * @post   Inorder sequence is unchanged, heights are recalculated
+    */
+   static void rotateLeft(ItemNode*& subRoot);
+
+   /** ------------------------ rotateRight(ItemNode*&) --------------------
+    * Lifts the left child of subRoot into its place.
+    * @param subRoot Link to the subtree being rotated, updated in place
+    * @pre    subRoot and its left child are not nullptr
+    * @post   Inorder sequence is unchanged, heights are recalculated
+    */
+   static void rotateRight(ItemNode*& subRoot);
+
+   /** ------------------------ rebalance(ItemNode*&) ----------------------
+    * Recalculates the height of subRoot and applies a single or double
+    *   rotation if its children differ in height by more than one.
+    * @param subRoot Link to the subtree being rebalanced, updated in place
+    * @pre    Both children of subRoot are balanced
+    * @post   subRoot is balanced and its height is current
+    */
+   static void rebalance(ItemNode*& subRoot);
+
+   /** ------------------------ compare(Hashable&, Hashable&) --------------
+    * Decides where key belongs relative to item with a single comparison of
+    *   their sort keys, comparing full fields only when the keys tie.
+    * @return 0 if key is equal to item, negative if key belongs in the left
+    *           subtree of item, positive if it belongs in the right subtree
+    */
+   static int compare(const Hashable& key, const Hashable& item);
+
+   /** ------------------------ buildBalanced(Hashable* const*, size_t) -----
+    * Builds a perfectly balanced subtree out of sorted items.
+    * Recursion is only as deep as the height of the result.
+    * @param sorted Items in the order they are to be output
+    * @param count  Number of items
+    * @return Root of the new subtree, nullptr if count is 0
+    */
+   ItemNode* buildBalanced(Hashable* const* sorted, size_t count);
+
+   /** ------------------------ search(Hashable*) --------------------------
+    * Searches BST beginning at root for node containing key
+    * @param key Hashable item to search for
+    * @pre    None
+    * @post   None
+    * @return Returns node containing key if found, nullptr if not found
+    */
+   SearchTree::ItemNode* search(const Hashable* key) const;
+
+public:
+   /** ------------------------ Iterator class --------------------------
+    * Walks a tree in order, keeping the nodes still to be visited on a
+    *   fixed-size stack, so it never allocates and uses O(log n) space.
+    * The whole tree is walked in O(n), and each step takes O(1) on average.
+    * Insert into its tree invalidates an Iterator.
+    */
+   class Iterator {
+   private:
+      const ItemNode* pending[MAX_HEIGHT];   // Path of nodes not yet visited,
+      int depth;                             //   next item on top
+
+      /** ------------------------ descend(ItemNode*) ---------------------
+       * Pushes subRoot and its left branch, so its lowest item is next.
+       */
+      void descend(const ItemNode* subRoot);
+
+      friend class SearchTree;
+
+   public:
+      /** ------------------------------ Constructor ----------------------
+       * Creates an iterator past the end of any tree.
+       */
+      Iterator() : depth(0) {};
+
+      /** ------------------------ operator* --------------------------
+       * @pre    Iterator is not at the end
+       * @return Current item
+       */
+      Hashable* operator*() const;
+
+      /** ------------------------ operator++ --------------------------
+       * Moves to the next item in order.
+       * @pre    Iterator is not at the end
+       */
+      Iterator& operator++();
+
+      /** ------------------------ operator==, != --------------------------
+       * @return True if both iterators are at the same item, or both at the end
+       */
+      bool operator==(const Iterator& other) const
+      { return depth == other.depth && (depth == 0 || pending[depth - 1] == other.pending[depth - 1]); };
+      bool operator!=(const Iterator& other) const { return !(*this == other); };
+   };
+
+   /** ------------------------------ Constructor -----------------------------
+    * @param owner True if the tree deletes its items when destroyed, false
+    *                if they belong to someone else, such as an Arena
+    */
+   SearchTree(bool owner = true) : root(nullptr), ownsItems(owner) {};
+
+   /** ------------------------ Destructor --------------------------
+    * Deletes the items stored if the tree owns them, then releases every
+    *   node at once with the node Arena.
+    * Teardown is iterative, so deep trees cannot overflow the call stack
+    */
+   ~SearchTree();
+
+   SearchTree(const SearchTree&) = delete;
+   SearchTree& operator=(const SearchTree&) = delete;
+
+   /** --------------------------- getNodeArena() -------------------------
+    * @return Arena holding the nodes, for memory statistics
+    */
+   const Arena& getNodeArena() const { return nodes; };
+
+   /** --------------------------- isEmpty() -------------------------
+    * Check if the tree is storing any data.
+    * @pre  None
+    * @post None
+    * @return True if root is unoccupied, false if not
+    */
+   bool isEmpty() { return root == nullptr; };
+
+   /** --------------------------- insert(Hashable*) -------------------------
+    * Adds a new Hashable to the BST then rebalances along the insertion path
+    * Iteratively searches then inserts
+    * @param key Item being added to the BST
+    * @pre    None
+    * @post   key has been added to the tree in its proper place
+    * @return True if insert was successful, false if key already exists
+    */
+   bool insert(Hashable* key);
+
+   /** ------------------------ build(vector<Hashable*>&) --------------------
+    * Fills an empty tree with items already in sorted order, without
+    *   comparing them, such as items saved by collect().
+    * @param sorted Items in the order they are to be output
+    * @pre    Tree is empty, sorted is in the order insert() would give
+    * @post   Tree holds every item of sorted and is balanced
+    * @return True if the tree was built, false if it was not empty
+    */
+   bool build(const vector<Hashable*>& sorted);
+
+   /** ------------------------ collect(vector<Hashable*>&) ------------------
+    * Appends every item to sorted, in the order they are output.
+    * @param sorted Vector to append the items to
+    */
+   void collect(vector<Hashable*>& sorted) const;
+
+   /** ------------------------ begin(), end() --------------------------
+    * @return Iterators at the lowest item and past the highest item
+    */
+   Iterator begin() const;
+   Iterator end() const { return Iterator(); };
+
+   /** ------------------------ seek(Hashable*) --------------------------
+    * Finds where key is, or would be, in O(log n).
+    * @param key Item to start at, which does not have to be in the tree
+    * @return Iterator at key if it is stored, otherwise at the first item
+    *           after it, or end() if there is none
+    */
+   Iterator seek(const Hashable* key) const;
+
+   /** ------------------------ seek(function) --------------------------
+    * Finds the start of a range of items in O(log n), such as every item
+    *   with a given field, without building a key to search for.
+    * @param before True for items that come before the range. Must be true
+    *                 for every item up to some point and false after it.
+    * @return Iterator at the first item before is false for, or end() if
+    *           there is none
+    */
+   Iterator seek(const function<bool(const Hashable&)>& before) const;
+
+   /** ------------------------ retrieve(Hashable*) --------------------------
+    * Finds node containing key and returns that Hashable object
+    * @param key Hashable item to search for
+    * @pre    None
+    * @post   None
+    * @return Returns key if found, nullptr if not found
+    */
+   Hashable* retrieve(const Hashable* key) const;
+
+   /** ------------------------ operator<< --------------------------
+    * Prints to a list of each Hashable in the BST per line (inorder)
+    * Traversal uses an Iterator, so output depth is not limited by the
+    *   call stack
+    * @param output  Ostream accepted and returned to allow chaining outputs
+    * @param tree    Tree to print
+    * @pre  None
+    * @post Contents of tree are output
+    */
+   friend ostream& operator<<(ostream& output, const SearchTree& tree);
+};
+
+/** ------------------------ operator<< --------------------------
+ * Prints to a list of each Hashable in the BST per line (inorder)
+ */
+ostream& operator<<(ostream&, const SearchTree&);
@@ -0,0 +1,140 @@
+/** @file Snapshot.cpp
+ * @author Korosh Moosavi
+ * @date 2026-10-16
+ *
+ * Snapshot class:
+ * Versioned binary image of the whole store state, written from a memory
+ *   buffer and read straight out of a mapped file.
+ *
+ * Assumptions:
+ * Values are read back in the order and with the types they were written.
+ */
+#include "Snapshot.h"
+#include <cstdio>
+
+const char Snapshot::MAGIC[8] = { 'C', 'S', 'T', 'O', 'R', 'E', 'S', 'N' };
+
+/** ------------------------------ Constructor ----------------------
+ * Starts an empty snapshot to be written, holding only the header.
+ * @pre  None
+ * @post Values can be added with put() and putString()
+ */
+Snapshot::Snapshot() : file(nullptr), valid(true)
+{
+   buffer.append(MAGIC, sizeof(MAGIC));
+   put(VERSION);
+   put(ORDER_MARK);
+}
+
+/** ------------------------------ Read constructor ----------------------
+ * Maps a saved snapshot and checks its header.
+ * @param fileName Name of the file written by saveTo()
+ * @pre  None
+ * @post Values can be read with get() and getString(), isValid() is false
+ *         if the file could not be read or was not written by a
+ *         compatible version
+ */
+Snapshot::Snapshot(const string& fileName) : valid(true)
+{
+   file = new MappedFile(fileName);
+   unread = file->contents();
+
+   if (unread.empty()) {            // Missing files are reported by MappedFile
+      valid = false;
+      return;
+   }
+   if (unread.size() < sizeof(MAGIC) || memcmp(unread.data(), MAGIC, sizeof(MAGIC)) != 0) {
+      cerr << fileName << " is not a store snapshot.\n" << endl;
+      valid = false;
+      return;
+   }
+   unread.remove_prefix(sizeof(MAGIC));
+
+   uint32_t version = get<uint32_t>();
+   uint32_t byteOrder = get<uint32_t>();
+   if (version != VERSION || byteOrder != ORDER_MARK) {
+      cerr << fileName << " was saved by an incompatible version or machine.\n" << endl;
+      valid = false;
+   }
+}
+
+/** ------------------------------ Destructor -------------------------------
+ * Unmaps the file being read, if any.
+ */
+Snapshot::~Snapshot()
+{
+   delete file;
+   file = nullptr;
+}
+
+/** ----------------------------- putString(string_view) ---------------------
+ * Appends a string to the snapshot being written.
+ * @param value Text to store, up to 4 GiB
+ */
+void Snapshot::putString(string_view value)
+{
+   put((uint32_t)value.size());
+   buffer.append(value.data(), value.size());
+}
+
+/** ----------------------------- getString() ---------------------
+ * Reads the next string of the snapshot being read.
+ * @return View of the string inside the mapped file, valid as long as the
+ *           Snapshot, empty if the snapshot ended
+ */
+string_view Snapshot::getString()
+{
+   uint32_t length = get<uint32_t>();
+
+   if (!fits(length, 1))
+      return string_view();
+   string_view value = unread.substr(0, length);
+   unread.remove_prefix(length);
+   return value;
+}
+
+/** ----------------------------- fits(uint64_t, size_t) ------------------
+ * Checks a count read from the snapshot before reserving space for it.
+ * @param count    Number of values the snapshot claims to hold
+ * @param minBytes Fewest bytes each value takes
+ * @return True if the rest of the snapshot can hold that many values,
+ *           otherwise false and the snapshot becomes invalid
+ */
+bool Snapshot::fits(uint64_t count, size_t minBytes)
+{
+   if (valid && count <= unread.size() / minBytes)
+      return true;
+   valid = false;
+   return false;
+}
+
+/** ----------------------------- saveTo(string) ---------------------
+ * Writes the snapshot to a file, through a temporary file that replaces
+ *   it once complete, so an interrupted save leaves the old one intact.
+ * @param fileName Name of the file to create or replace
+ * @pre    This snapshot is being written
+ * @return True if the file was written, false with a message on cerr if not
+ */
+bool Snapshot::saveTo(const string& fileName) const
+{
+   string partial = fileName + ".tmp";
+   FILE* output = fopen(partial.c_str(), "wb");
+
+   if (output == nullptr) {
+      cerr << "Unable to create " << partial << ".\n" << endl;
+      return false;
+   }
+   bool written = fwrite(buffer.data(), 1, buffer.size(), output) == buffer.size();
+   written = fclose(output) == 0 && written;
+
+#ifdef _WIN32
+   if (written)                     // rename() does not replace files here
+      remove(fileName.c_str());
+#endif
+   if (!written || rename(partial.c_str(), fileName.c_str()) != 0) {
+      cerr << "Unable to write " << fileName << ".\n" << endl;
+      remove(partial.c_str());
+      return false;
+   }
+   return true;
+}
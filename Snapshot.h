@@ -0,0 +1,142 @@
+/** @file Snapshot.h
+ * @author Korosh Moosavi
+ * @date 2026-10-16
+ *
+ * Snapshot class:
+ * Versioned binary image of the whole store state, the inventory with every
+ *   item's stock and the customers with their transaction histories, so a
+ *   store can be restarted without parsing the text files again.
+ * A snapshot is either being written or being read. Writing appends values
+ *   to a memory buffer that saveTo() writes out in one go. Reading maps the
+ *   file and copies each value straight out of the mapped region.
+ * Values are stored in the byte order of the machine, strings as their
+ *   32-bit length followed by their characters. The header holds a magic
+ *   tag, the format VERSION and a byte order marker, and a snapshot whose
+ *   header does not match is rejected.
+ * Reading past the end makes the snapshot invalid instead of failing, so
+ *   loaders check isValid() once they are done instead of after each value.
+ *
+ * Assumptions:
+ * Values are read back in the order and with the types they were written.
+ * A snapshot is only read on a machine with the same byte order as the one
+ *   that wrote it, others are rejected by the header.
+ */
+#pragma once
+#include "MappedFile.h"
+#include <cstring>
+#include <string>
+#include <string_view>
+
+using namespace std;
+
+class Snapshot {
+private:
+   static const char MAGIC[8];
+   static const uint32_t VERSION = 3;              // Bump on any format change
+                                                   //   or change of item order
+   static const uint32_t ORDER_MARK = 0x01020304;  // Reads back swapped if the
+                                                   //   byte order differs
+   string buffer;             // Bytes written so far
+   MappedFile* file;          // File read from, nullptr when writing
+   string_view unread;        // Part of the file not read yet
+   bool valid;
+
+public:
+   /** ------------------------------ Constructor ----------------------
+    * Starts an empty snapshot to be written, holding only the header.
+    * @pre  None
+    * @post Values can be added with put() and putString()
+    */
+   Snapshot();
+
+   /** ------------------------------ Read constructor ----------------------
+    * Maps a saved snapshot and checks its header.
+    * @param fileName Name of the file written by saveTo()
+    * @pre  None
+    * @post Values can be read with get() and getString(), isValid() is false
+    *         if the file could not be read or was not written by a
+    *         compatible version
+    */
+   Snapshot(const string& fileName);
+
+   /** ------------------------------ Destructor -------------------------------
+    * Unmaps the file being read, if any.
+    */
+   ~Snapshot();
+
+   Snapshot(const Snapshot&) = delete;
+   Snapshot& operator=(const Snapshot&) = delete;
+
+   /** ----------------------------- put(T) ---------------------
+    * Appends a number to the snapshot being written.
+    * @param value Integer or character to store, written with its own size
+    */
+   template <class T>
+   void put(T value) { buffer.append(reinterpret_cast<const char*>(&value), sizeof(T)); };
+
+   /** ----------------------------- putString(string_view) ---------------------
+    * Appends a string to the snapshot being written.
+    * @param value Text to store, up to 4 GiB
+    */
+   void putString(string_view value);
+
+   /** ----------------------------- get() ---------------------
+    * Reads the next number of the snapshot being read.
+    * @return The value, 0 if the snapshot ended, which makes it invalid
+    */
+   template <class T>
+   T get()
+   {
+      T value = T();
+      if (unread.size() < sizeof(T)) {
+         valid = false;
+         return value;
+      }
+      memcpy(&value, unread.data(), sizeof(T));
+      unread.remove_prefix(sizeof(T));
+      return value;
+   };
+
+   /** ----------------------------- getString() ---------------------
+    * Reads the next string of the snapshot being read.
+    * @return View of the string inside the mapped file, valid as long as the
+    *           Snapshot, empty if the snapshot ended
+    */
+   string_view getString();
+
+   /** ----------------------------- fits(uint64_t, size_t) ------------------
+    * Checks a count read from the snapshot before reserving space for it.
+    * @param count    Number of values the snapshot claims to hold
+    * @param minBytes Fewest bytes each value takes
+    * @return True if the rest of the snapshot can hold that many values,
+    *           otherwise false and the snapshot becomes invalid
+    */
+   bool fits(uint64_t count, size_t minBytes);
+
+   /** ----------------------------- invalidate() ---------------------
+    * Marks the snapshot as corrupt, such as when a loader finds a value out
+    *   of range.
+    */
+   void invalidate() { valid = false; };
+
+   /** ----------------------------- isValid() ---------------------
+    * @return True if the header matched and nothing was read past the end
+    *           or rejected by a loader.
+    */
+   bool isValid() const { return valid; };
+
+   /** ----------------------------- position() ---------------------
+    * @return Bytes written so far, or bytes read so far including the header.
+    */
+   size_t position() const
+   { return file == nullptr ? buffer.size() : file->size() - unread.size(); };
+
+   /** ----------------------------- saveTo(string) ---------------------
+    * Writes the snapshot to a file, through a temporary file that replaces
+    *   it once complete, so an interrupted save leaves the old one intact.
+    * @param fileName Name of the file to create or replace
+    * @pre    This snapshot is being written
+    * @return True if the file was written, false with a message on cerr if not
+    */
+   bool saveTo(const string& fileName) const;
+};
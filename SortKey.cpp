@@ -0,0 +1,92 @@
+/** @file SortKey.cpp
+ * @author Korosh Moosavi
+ * @date 2026-10-16
+ *
+ * SortKey class:
+ * Fixed-size binary prefix of the fields a Hashable is sorted by, built once
+ *   when the object is constructed.
+ *
+ * Assumptions:
+ * Strings appended to a key do not contain 0 bytes.
+ * Objects compared by key append the same kinds of fields in the same order.
+ */
+#include "SortKey.h"
+
+/** ----------------------------- appendByte(uint8_t) ---------------------
+ * Packs a byte after the last one appended, or drops it if the key is full.
+ */
+void SortKey::appendByte(uint8_t byte)
+{
+   if (length >= BYTES) {
+      length = BYTES + 1;                 // Mark the key incomplete
+      return;
+   }
+   words[length / 8] |= (uint64_t)byte << (56 - 8 * (length % 8));
+   length++;
+}
+
+/** ----------------------------- append(string_view) ---------------------
+ * Adds a string field, terminated so a shorter string sorts before any
+ *   longer string it is the start of.
+ * @param field Value of the field
+ * @return This key, so fields can be chained
+ */
+SortKey& SortKey::append(string_view field)
+{
+   for (size_t i = 0; i < field.size() && length <= BYTES; i++)
+      appendByte((uint8_t)field[i]);
+   appendByte(0);
+   return *this;
+}
+
+/** ----------------------------- append(int) ---------------------
+ * Adds an int field, with the sign bit flipped so negative values sort
+ *   before positive ones.
+ * @param field Value of the field
+ * @return This key, so fields can be chained
+ */
+SortKey& SortKey::append(int field)
+{
+   uint32_t bits = (uint32_t)field ^ 0x80000000u;
+
+   for (int shift = 24; shift >= 0; shift -= 8)
+      appendByte((uint8_t)(bits >> shift));
+   return *this;
+}
+
+/** ----------------------------- append(int64_t) ---------------------
+ * Adds a 64-bit int field, with the sign bit flipped so negative values
+ *   sort before positive ones.
+ * @param field Value of the field
+ * @return This key, so fields can be chained
+ */
+SortKey& SortKey::append(int64_t field)
+{
+   uint64_t bits = (uint64_t)field ^ 0x8000000000000000ULL;
+
+   for (int shift = 56; shift >= 0; shift -= 8)
+      appendByte((uint8_t)(bits >> shift));
+   return *this;
+}
+
+/** ----------------------------- append(char) ---------------------
+ * Adds a single character field, such as a category symbol.
+ * @param field Value of the field
+ * @return This key, so fields can be chained
+ */
+SortKey& SortKey::append(char field)
+{
+   appendByte((uint8_t)field);
+   return *this;
+}
+
+/** ----------------------------- append(uint8_t) ---------------------
+ * Adds a small code field, such as a grade on its grading scale.
+ * @param field Value of the field
+ * @return This key, so fields can be chained
+ */
+SortKey& SortKey::append(uint8_t field)
+{
+   appendByte(field);
+   return *this;
+}
@@ -0,0 +1,77 @@
+/** @file SortKey.h
+ * @author Korosh Moosavi
+ * @date 2026-10-16
+ *
+ * SortKey class:
+ * Fixed-size binary prefix of the fields a Hashable is sorted by, built once
+ *   when the object is constructed.
+ * Fields are appended in sorting priority: strings as their bytes followed by
+ *   a 0 terminator, ints as 4 or 8 big-endian bytes with the sign bit flipped,
+ *   chars and small codes as a single byte.
+ *   Bytes are packed big-endian into 64-bit words, so comparing the words as
+ *   integers orders keys the same way as comparing their fields one by one.
+ * Bytes past the end of the key are dropped. Keys that differ decide the
+ *   order of their objects on their own; keys that are equal only decide it
+ *   when both are complete, otherwise the full fields must be compared.
+ *
+ * Assumptions:
+ * Strings appended to a key do not contain 0 bytes.
+ * Objects compared by key append the same kinds of fields in the same order.
+ */
+#pragma once
+#include <cstdint>
+#include <string_view>
+
+using namespace std;
+
+class SortKey {
+public:
+   static const int WORDS = 3;
+   static const int BYTES = WORDS * 8;
+
+private:
+   uint64_t words[WORDS];
+   uint8_t length;         // Bytes appended, BYTES + 1 once any were dropped
+
+   /** ----------------------------- appendByte(uint8_t) ---------------------
+    * Packs a byte after the last one appended, or drops it if the key is full.
+    */
+   void appendByte(uint8_t byte);
+
+public:
+   /** ------------------------------ Constructor ----------------------
+    * Creates an empty key, equal to every other empty key.
+    */
+   SortKey() : words(), length(0) {};
+
+   /** ----------------------------- append(...) ---------------------
+    * Adds the next field in sorting priority to the key.
+    * @param field Value of the field
+    * @return This key, so fields can be chained
+    */
+   SortKey& append(string_view field);
+   SortKey& append(int field);
+   SortKey& append(int64_t field);
+   SortKey& append(char field);
+   SortKey& append(uint8_t field);
+
+   /** ----------------------------- isComplete() ---------------------
+    * @return True if every appended byte fits in the key, so equal keys
+    *           mean equal fields. An empty key is never complete.
+    */
+   bool isComplete() const { return length != 0 && length <= BYTES; };
+
+   /** ----------------------------- compare(SortKey&) ---------------------
+    * @param rhs Key to compare with
+    * @return Negative if this key sorts first, positive if rhs sorts first,
+    *           0 if the keys are equal.
+    */
+   int compare(const SortKey& rhs) const
+   {
+      for (int i = 0; i < WORDS; i++) {
+         if (words[i] != rhs.words[i])
+            return words[i] < rhs.words[i] ? -1 : 1;
+      }
+      return 0;
+   };
+};
@@ -1,174 +1,208 @@
-/** @file SportsCard.cpp
- * @author Korosh Moosavi
- * @date 2021-03-12
- *
- * SportsCard class:
- * Class containing data members to identify unique sports card objects
- *   in Inventory.
- *
- * Assumptions:
- * Input will include 1 char, 2 ints, and 2 strings as data members.
- * Sorting priority is name -> year -> type -> grade
- */
-#include "SportsCard.h"
-
-/** ------------------------------ Default constructor ----------------------
-* Data members are pre-initialized.
-* @pre  None
-* @post SportsCard object created with identifiable default data value.
-*/
-SportsCard::SportsCard()
-{
-   // Default construction is sufficient
-}
-
-/** ----------------------------- Parameter constructor ---------------------
-* Accepts a string beginning with "S" and parses through it to create a new
-*   object with given details as data members.
-* @param details  String containing all details needed for a new object.
-* @pre  Parameter string is pre-formatted and a single line, begins with "S"
-* @post SportsCard object created with parameter data values.
-*/
-SportsCard::SportsCard(string details)
-{
-   int pos = details.find(',');
-   details = details.substr(pos + 2);  // remove char code
-   
-   pos = details.find(',');
-   stock = atoi(details.substr(0, pos).c_str()); // assign stock
-   year = atoi(details.substr(pos + 2, pos + 6).c_str()); // assign year
-   details = details.substr(pos + 8);  // remove stock/year
-   
-   pos = details.find(',');
-   grade = details.substr(0, pos);     // assign grade
-   details = details.substr(pos + 2);  // remove grade
-   
-   pos = details.find(',');
-   name = details.substr(0, pos);      // assign name
-   type = details.substr(pos + 2);     // assign type
-}
-
-/** ------------------------------ Destructor -------------------------------
-* No special operations needed.
-* @pre  None
-* @post Data is deallocated after destruction.
-*/
-SportsCard::~SportsCard()
-{
-   // No additional memory is tied to this object
-}
-
-/** ----------------------------- hash() ---------------------
- * Uses descriptor to return a hash value.
- * @pre    Data members are valid and initialized.
- * @return A (hopefully) unique int value.
- */
-int SportsCard::hash()
-{
-   int hashVal = 0;
-   int len = descriptor.length();
-
-   for (int i = 0; i < len; i++)
-      hashVal += descriptor[i] % 3;
-
-   while (hashVal > Collectible::UNIQUES)
-      hashVal %= Collectible::UNIQUES;
-
-   return hashVal;
-}
-
-/** ----------------------------- isLess(Hashable&) ---------------------
- * Main functionality for less-than operator used in SearchTree
- * @param  rhs  Other Hashable object being compared to.
- * @pre    Parameter is a SportsCard.
- * @return True if priority of this object is lower than that
- *           of rhs Hashable, false otherwise.
- */
-bool SportsCard::isLess(const Hashable& rhs) const
-{
-   const SportsCard* temp = dynamic_cast<const SportsCard*>(&rhs);
-   if (symbol != (*temp).symbol) {
-      cerr << "Comparing different kinds of objects." << endl;
-      return false;
-   }
-   if (name != (*temp).name) {
-      return name < (*temp).name;
-   }
-   if (year != (*temp).year) {
-      return year < (*temp).year;
-   }
-   if (type != (*temp).type) {
-      return type < (*temp).type;
-   }
-   if (grade != (*temp).grade) {
-      return grade < (*temp).grade;
-   }
-
-   // Objects are equal sorting priority
-   return false;
-}
-
-/** ----------------------------- isEqual(Hashable&) ---------------------
- * Compares two Hashables to see if they are equal.
- * @param  rhs  Other Hashable object being compared to.
- * @pre    Parameter is a SportsCard.
- * @return True if this and rhs have equal data members (except for stock).
- */
-bool SportsCard::isEqual(const Hashable& rhs) const
-{
-   if (this == &rhs) {
-      return true;
-   }
-   const SportsCard* temp = dynamic_cast<const SportsCard*>(&rhs);
-   
-   bool symbolCheck = symbol == (*temp).symbol;
-   bool nameCheck = name == (*temp).name;
-   bool typeCheck = type == (*temp).type;
-   bool gradeCheck = grade == (*temp).grade;
-   bool yearCheck = year == (*temp).year;
-   
-   return symbolCheck && nameCheck && typeCheck && gradeCheck && yearCheck;
-}
-
-/** ----------------------------- updateStock(int) ---------------------
- * Changes the stock count of this object by the parameter amount.
- * Note that the current implementation only uses +1 and -1 as parameters.
- * @param  change Amount to change stock count by.
- * @pre    Stock is >= 0
- * @post   Stock is >= 0
- * @return True stock was changed without going below 0.
- */
-bool SportsCard::updateStock(int change)
-{
-   if (this == nullptr) {
-      cerr << "Item not found." << endl;
-      return false;
-   }
-   
-   stock += change;     // Apply change
-   
-   if (stock < 0) {
-      cerr << "Item is out of stock, sale cancelled.\n" << endl;
-      stock -= change;  // Undo if stock drops below 0
-      return false;     // Return false on failure
-   }
-   return true;         // Return true on success
-}
-
-/** ----------------------------- print(ostream&) ---------------------
- * Main functionality of output operator<<
- * Outputs data on this object in a single, formatted line
- * @param  output Ostream object passed from operator<< overload in Hashable
- * @pre    Data members are valid and initialized.
- * @post   Information on this object is output.
- */
-void SportsCard::print(ostream& output) const
-{
-   string sDescritpor = descriptor + ":";
-   output << setw(16) << left << sDescritpor
-      << setw(16) << left << name 
-      << setw(12) << left << type
-      << setw(12) << left << grade
-      << setw(7) << left << year
-      << setw(7) << left << stock;
+/** @file SportsCard.cpp
+ * @author Korosh Moosavi
+ * @date 2021-03-12
+ *
+ * SportsCard class:
+ * Class containing data members to identify unique sports card objects
+ *   in Inventory.
+ *
+ * Assumptions:
+ * Input will include 1 char, 2 ints, and 2 strings as data members.
+ * Sorting priority is name -> year -> type -> grade
+ * Grades sort by their place on the grading scale, see Grade.
+ */
+#include "SportsCard.h"
+
+/** ------------------------------ Default constructor ----------------------
+* Data members are pre-initialized.
+* @pre  None
+* @post SportsCard object created with identifiable default data value.
+*/
+SportsCard::SportsCard()
+{
+   nameId = intern("NULL_CARD_PLAYER");
+   typeId = intern("NULL_CARD_MANUFACTURER");
+   gradeId = intern("NULL_CARD_GRADE");
+   buildSortKey();
+}
+
+/** ----------------------------- Parameter constructor ---------------------
+* Accepts a string beginning with "S" and parses through it to create a new
+*   object with given details as data members.
+* @param details  String containing all details needed for a new object.
+* @pre  Parameter string is pre-formatted and a single line, begins with "S"
+* @post SportsCard object created with parameter data values.
+*/
+SportsCard::SportsCard(string details)
+{
+   ItemRecord record;
+
+   if (CommandParser::parseItem(details, record, true))
+      assign(record);    // Malformed details keep default values
+   buildSortKey();
+}
+
+/** ----------------------------- Record constructor ---------------------
+* Copies the fields of an already parsed item.
+* @param record Parsed item fields, as produced by CommandParser.
+* @pre  record.symbol is "S"
+* @post SportsCard object created with parameter data values.
+*/
+SportsCard::SportsCard(const ItemRecord& record)
+{
+   assign(record);
+   buildSortKey();
+}
+
+/** ----------------------------- Stored constructor ---------------------
+* Copies the fields of an item saved in a Snapshot.
+* @param stored Saved item fields, see Collectible::getStored().
+* @pre  stored.symbol is "S"
+* @post SportsCard object created with the saved data values.
+*/
+SportsCard::SportsCard(const StoredItem& stored)
+{
+   assign(stored);
+   buildSortKey();
+}
+
+/** ------------------------------ Destructor -------------------------------
+* No special operations needed.
+* @pre  None
+* @post Data is deallocated after destruction.
+*/
+SportsCard::~SportsCard()
+{
+   // No additional memory is tied to this object
+}
+
+/** ----------------------------- hash() ---------------------
+ * Uses descriptor to return a hash value.
+ * @pre    Data members are valid and initialized.
+ * @return A (hopefully) unique int value.
+ */
+int SportsCard::hash()
+{
+   int hashVal = 0;
+   int len = descriptor.length();
+
+   for (int i = 0; i < len; i++)
+      hashVal += descriptor[i] % 3;
+
+   while (hashVal > Collectible::UNIQUES)
+      hashVal %= Collectible::UNIQUES;
+
+   return hashVal;
+}
+
+/** ----------------------------- buildSortKey() ---------------------
+ * Packs the sorting fields into sortKey, called by every constructor.
+ * The symbol comes first so items of different kinds never tie.
+ */
+void SportsCard::buildSortKey()
+{
+   sortKey.append(symbol).append(getName()).append(year).append(getType()).append(gradeCode).append(getGrade());
+}
+
+/** ----------------------------- isLess(Hashable&) ---------------------
+ * Main functionality for less-than operator used in SearchTree
+ * @param  rhs  Other Hashable object being compared to.
+ * @pre    Parameter is a SportsCard.
+ * @return True if priority of this object is lower than that
+ *           of rhs Hashable, false otherwise.
+ */
+bool SportsCard::isLess(const Hashable& rhs) const
+{
+   const SportsCard* temp = static_cast<const SportsCard*>(&rhs);
+   if (symbol != (*temp).symbol) {
+      cerr << "Comparing different kinds of objects.\n";
+      return false;
+   }
+   if (nameId != (*temp).nameId) {
+      return getName() < (*temp).getName();
+   }
+   if (year != (*temp).year) {
+      return year < (*temp).year;
+   }
+   if (typeId != (*temp).typeId) {
+      return getType() < (*temp).getType();
+   }
+   if (gradeCode != (*temp).gradeCode) {
+      return gradeCode < (*temp).gradeCode;
+   }
+   if (gradeId != (*temp).gradeId) {     // Both ungraded, compare as text
+      return getGrade() < (*temp).getGrade();
+   }
+
+   // Objects are equal sorting priority
+   return false;
+}
+
+/** ----------------------------- isEqual(Hashable&) ---------------------
+ * Compares two Hashables to see if they are equal.
+ * @param  rhs  Other Hashable object being compared to.
+ * @pre    Parameter is a SportsCard.
+ * @return True if this and rhs have equal data members (except for stock).
+ */
+bool SportsCard::isEqual(const Hashable& rhs) const
+{
+   if (this == &rhs) {
+      return true;
+   }
+   const SportsCard* temp = static_cast<const SportsCard*>(&rhs);
+   
+   bool symbolCheck = symbol == (*temp).symbol;
+   bool nameCheck = nameId == (*temp).nameId;
+   bool typeCheck = typeId == (*temp).typeId;
+   bool gradeCheck = gradeId == (*temp).gradeId;
+   bool yearCheck = year == (*temp).year;
+   
+   return symbolCheck && nameCheck && typeCheck && gradeCheck && yearCheck;
+}
+
+/** ----------------------------- updateStock(int) ---------------------
+ * Changes the stock count of this object by the parameter amount.
+ * Note that the current implementation only uses +1 and -1 as parameters.
+ * The change is a single compare-and-swap, so threads may update the same
+ *   item at once and stock never goes below 0, even briefly.
+ * @param  change Amount to change stock count by.
+ * @pre    Stock is >= 0
+ * @post   Stock is >= 0
+ * @return True stock was changed without going below 0.
+ */
+bool SportsCard::updateStock(int change)
+{
+   if (this == nullptr) {
+      cerr << "Item not found.\n";
+      return false;
+   }
+   
+   int current = stock.load(memory_order_relaxed);
+
+   do {                 // Retry if another thread changed stock first
+      if (current + change < 0) {
+         cerr << "Item is out of stock, sale cancelled.\n\n";
+         return false;  // Return false on failure, stock is untouched
+      }
+   } while (!stock.compare_exchange_weak(current, current + change, memory_order_relaxed));
+   dirty.store(true, memory_order_relaxed);  // Displayed line is out of date
+   return true;         // Return true on success
+}
+
+/** ----------------------------- printWithCount(ostream&, int) ----------
+ * Outputs data on this object in a single, formatted line
+ * @param  output Stream to write to
+ * @param  count  Value shown in the stock column
+ * @pre    Data members are valid and initialized.
+ * @post   Information on this object is output.
+ */
+void SportsCard::printWithCount(ostream& output, int count) const
+{
+   string sDescritpor = descriptor + ":";
+   output << setw(16) << left << sDescritpor
+      << setw(16) << left << getName() 
+      << setw(12) << left << getType()
+      << setw(12) << left << getGrade()
+      << setw(7) << left << year
+      << setw(7) << left << count;
 }
\ No newline at end of file
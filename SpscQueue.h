@@ -0,0 +1,151 @@
+/** @file SpscQueue.h
+ * @author Korosh Moosavi
+ * @date 2026-10-16
+ *
+ * SpscQueue class:
+ * Bounded lock-free queue connecting exactly one producer thread to exactly
+ *   one consumer thread.
+ * Slots are allocated once and reused: the producer fills a slot in place
+ *   and the consumer reads it in place, so buffers held by a slot (such as a
+ *   string) keep their capacity from one use to the next.
+ * Counts how often each side had to wait (a stall) and how full the queue
+ *   was, so pipeline stages can be balanced.
+ * Template class, so it is implemented entirely within this header.
+ *
+ * Assumptions:
+ * Only one thread calls beginPush()/endPush() and only one thread calls
+ *   beginPop()/endPop().
+ * Every beginPop() is followed by endPop() before the next beginPop().
+ * beginPush() may be called again without endPush() to reuse the same slot,
+ *   such as when the producer decides the slot's contents are not needed.
+ */
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+template <class T>
+class SpscQueue {
+private:
+   static const size_t CACHE_LINE = 64;
+
+   vector<T> slots;
+   size_t mask;
+
+   // Producer and consumer positions on separate cache lines
+   alignas(CACHE_LINE) atomic<size_t> head;     // Next slot to pop
+   alignas(CACHE_LINE) atomic<size_t> tail;     // Next slot to push
+
+   // Producer side statistics
+   alignas(CACHE_LINE) uint64_t pushes = 0;
+   uint64_t pushStalls = 0;
+   size_t pushDepth = 0;                        // Depth seen by beginPush()
+   uint64_t depthTotal = 0;
+   size_t depthMax = 0;
+
+   // Consumer side statistics
+   alignas(CACHE_LINE) uint64_t popStalls = 0;
+
+   /** ----------------------------- backOff(int&) ---------------------
+    * Waits briefly before checking the queue again, spinning at first then
+    *   giving up the core to the thread being waited on.
+    * @param attempts Number of checks made so far, incremented
+    */
+   static void backOff(int& attempts)
+   {
+      if (++attempts > 64)
+         this_thread::yield();
+   };
+
+public:
+   /** ------------------------------ Constructor ----------------------
+    * Allocates every slot up front.
+    * @param capacity Minimum number of slots, rounded up to a power of 2
+    */
+   SpscQueue(size_t capacity) : head(0), tail(0)
+   {
+      size_t size = 2;
+      while (size < capacity)
+         size *= 2;
+      slots.resize(size);
+      mask = size - 1;
+   };
+
+   SpscQueue(const SpscQueue&) = delete;
+   SpscQueue& operator=(const SpscQueue&) = delete;
+
+   /** ----------------------------- beginPush() ---------------------
+    * Waits for a free slot and returns it to be filled by the producer.
+    * @return Slot that becomes visible to the consumer on endPush()
+    */
+   T* beginPush()
+   {
+      size_t pos = tail.load(memory_order_relaxed);
+      size_t depth = pos - head.load(memory_order_acquire);
+
+      if (depth > mask) {                       // Full, wait for consumer
+         int attempts = 0;
+         pushStalls++;
+         while (pos - head.load(memory_order_acquire) > mask)
+            backOff(attempts);
+         depth = mask + 1;
+      }
+
+      pushDepth = depth;
+      return &slots[pos & mask];
+   };
+
+   /** ----------------------------- endPush() ---------------------
+    * Publishes the slot returned by the last beginPush() to the consumer.
+    */
+   void endPush()
+   {
+      pushes++;
+      depthTotal += pushDepth;
+      if (pushDepth > depthMax)
+         depthMax = pushDepth;
+      tail.store(tail.load(memory_order_relaxed) + 1, memory_order_release);
+   };
+
+   /** ----------------------------- beginPop() ---------------------
+    * Waits for a published slot and returns it to be read by the consumer.
+    * @return Oldest published slot, stays valid until endPop()
+    */
+   T* beginPop()
+   {
+      size_t pos = head.load(memory_order_relaxed);
+
+      if (tail.load(memory_order_acquire) == pos) {   // Empty, wait for producer
+         int attempts = 0;
+         popStalls++;
+         while (tail.load(memory_order_acquire) == pos)
+            backOff(attempts);
+      }
+      return &slots[pos & mask];
+   };
+
+   /** ----------------------------- endPop() ---------------------
+    * Releases the slot returned by the last beginPop() back to the producer.
+    */
+   void endPop()
+   {
+      head.store(head.load(memory_order_relaxed) + 1, memory_order_release);
+   };
+
+   /** ----------------------------- Statistics ---------------------
+    * Read once both threads have finished with the queue.
+    * Stalls count the times a side found the queue full (push) or empty
+    *   (pop) and had to wait. Depth is the number of slots in use when each
+    *   push began.
+    */
+   size_t capacity() const { return mask + 1; };
+   uint64_t getPushes() const { return pushes; };
+   uint64_t getPushStalls() const { return pushStalls; };
+   uint64_t getPopStalls() const { return popStalls; };
+   size_t getMaxDepth() const { return depthMax; };
+   double getMeanDepth() const
+   { return pushes == 0 ? 0.0 : (double)depthTotal / pushes; };
+};
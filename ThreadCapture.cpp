@@ -0,0 +1,58 @@
+/** @file ThreadCapture.cpp
+ * @author Korosh Moosavi
+ * @date 2026-10-16
+ *
+ * ThreadCapture class:
+ * Stream buffer that lets every thread send its own output to a string of
+ *   its choice, falling back to another stream buffer for threads that
+ *   capture nothing.
+ *
+ * Assumptions:
+ * A captured string is only read once the thread writing it is done.
+ * Writes that fall back are not synchronized, only one thread at a time
+ *   may write without capturing.
+ */
+#include "ThreadCapture.h"
+
+thread_local string* ThreadCapture::target = nullptr;
+
+/** ----------------------------- overflow(int_type) ---------------------
+ * Called for every single character, since this buffer keeps none.
+ * @param ch Character to write, or eof
+ * @return ch on success, eof on failure
+ */
+ThreadCapture::int_type ThreadCapture::overflow(int_type ch)
+{
+   if (traits_type::eq_int_type(ch, traits_type::eof()))
+      return traits_type::not_eof(ch);
+
+   if (target == nullptr)
+      return fallback->sputc(traits_type::to_char_type(ch));
+
+   target->push_back(traits_type::to_char_type(ch));
+   return ch;
+}
+
+/** ----------------------------- xsputn(const char*, streamsize) --------
+ * Appends a block of characters to the calling thread's target.
+ * @param text  Characters to write
+ * @param count Number of characters
+ * @return Number of characters written
+ */
+streamsize ThreadCapture::xsputn(const char* text, streamsize count)
+{
+   if (target == nullptr)
+      return fallback->sputn(text, count);
+
+   target->append(text, count);
+   return count;
+}
+
+/** ----------------------------- sync() ---------------------
+ * Flushes the fallback when the calling thread is not capturing.
+ * @return 0 on success, -1 on failure
+ */
+int ThreadCapture::sync()
+{
+   return target == nullptr ? fallback->pubsync() : 0;
+}
@@ -0,0 +1,64 @@
+/** @file ThreadCapture.h
+ * @author Korosh Moosavi
+ * @date 2026-10-16
+ *
+ * ThreadCapture class:
+ * Stream buffer that lets every thread send its own output to a string of
+ *   its choice, falling back to another stream buffer for threads that
+ *   capture nothing.
+ * Installed as the buffer of cerr while transactions run on several
+ *   threads, so each command's error messages are collected separately and
+ *   can be output in the order of the transactions file.
+ *
+ * Assumptions:
+ * A captured string is only read once the thread writing it is done.
+ * Writes that fall back are not synchronized, only one thread at a time
+ *   may write without capturing.
+ */
+#pragma once
+#include <streambuf>
+#include <string>
+
+using namespace std;
+
+class ThreadCapture : public streambuf {
+private:
+   streambuf* fallback;                // Target of threads not capturing
+   static thread_local string* target; // Set per thread by capture()
+
+protected:
+   /** ----------------------------- overflow(int_type) ---------------------
+    * Called for every single character, since this buffer keeps none.
+    * @param ch Character to write, or eof
+    * @return ch on success, eof on failure
+    */
+   int_type overflow(int_type ch) override;
+
+   /** ----------------------------- xsputn(const char*, streamsize) --------
+    * Appends a block of characters to the calling thread's target.
+    * @param text  Characters to write
+    * @param count Number of characters
+    * @return Number of characters written
+    */
+   streamsize xsputn(const char* text, streamsize count) override;
+
+   /** ----------------------------- sync() ---------------------
+    * Flushes the fallback when the calling thread is not capturing.
+    * @return 0 on success, -1 on failure
+    */
+   int sync() override;
+
+public:
+   /** ------------------------------ Constructor ----------------------
+    * @param other Buffer written to by threads that capture nothing, such as
+    *                the buffer this one replaces.
+    */
+   ThreadCapture(streambuf* other) : fallback(other) {};
+
+   /** ----------------------------- capture(string*) ---------------------
+    * Sends everything the calling thread writes to text, appended to what
+    *   it already holds.
+    * @param text String to write to, nullptr to write to the fallback again
+    */
+   static void capture(string* text) { target = text; };
+};
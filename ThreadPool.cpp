@@ -0,0 +1,111 @@
+/** @file ThreadPool.cpp
+ * @author Korosh Moosavi
+ * @date 2026-10-16
+ *
+ * ThreadPool class:
+ * Fixed set of worker threads executing tasks from a shared queue.
+ * Used to spread independent work, such as parsing chunks of an input file,
+ *   across every core.
+ *
+ * Assumptions:
+ * parallelFor() is never called from inside a task of the same pool, since
+ *   the blocked worker could be the one needed to finish the loop.
+ */
+#include "ThreadPool.h"
+
+/** ------------------------------ Constructor ----------------------
+ * Starts the worker threads.
+ * @param threads Number of workers, 0 uses one per hardware thread.
+ */
+ThreadPool::ThreadPool(int threads) : stopping(false)
+{
+   if (threads <= 0)
+      threads = hardwareThreads();
+
+   for (int i = 0; i < threads; i++)
+      workers.emplace_back(&ThreadPool::workerLoop, this);
+}
+
+/** ------------------------------ Destructor -------------------------------
+ * Finishes queued tasks then joins every worker.
+ */
+ThreadPool::~ThreadPool()
+{
+   {
+      lock_guard<mutex> guard(lock);
+      stopping = true;
+   }
+   available.notify_all();
+
+   for (thread& worker : workers)
+      worker.join();
+}
+
+/** ----------------------------- workerLoop() ---------------------
+ * Body of each worker thread, runs tasks until the pool is destroyed.
+ */
+void ThreadPool::workerLoop()
+{
+   while (true) {
+      function<void()> task;
+      {
+         unique_lock<mutex> guard(lock);
+         available.wait(guard, [this] { return stopping || !tasks.empty(); });
+
+         if (tasks.empty())            // Stopping and nothing left to run
+            return;
+         task = move(tasks.front());
+         tasks.pop();
+      }
+      task();
+   }
+}
+
+/** ----------------------------- submit(function) ---------------------
+ * Queues a task to be run by the next free worker.
+ * @param task Work to run, must not throw.
+ */
+void ThreadPool::submit(function<void()> task)
+{
+   {
+      lock_guard<mutex> guard(lock);
+      tasks.push(move(task));
+   }
+   available.notify_one();
+}
+
+/** ----------------------------- parallelFor(size_t, function) ----------
+ * Runs body(i) for every i in [0, count) on the workers and waits for all
+ *   of them to finish. Several threads may call this at the same time.
+ * @param count Number of calls to make.
+ * @param body  Work for a single index, must not throw.
+ * @post  Every call has returned.
+ */
+void ThreadPool::parallelFor(size_t count, const function<void(size_t)>& body)
+{
+   mutex doneLock;
+   condition_variable done;
+   size_t remaining = count;
+
+   for (size_t i = 0; i < count; i++) {
+      submit([&, i] {
+         body(i);
+
+         lock_guard<mutex> guard(doneLock);
+         if (--remaining == 0)
+            done.notify_one();
+      });
+   }
+
+   unique_lock<mutex> guard(doneLock);
+   done.wait(guard, [&] { return remaining == 0; });
+}
+
+/** ----------------------------- hardwareThreads() ---------------------
+ * @return Number of hardware threads, at least 1.
+ */
+int ThreadPool::hardwareThreads()
+{
+   unsigned int count = thread::hardware_concurrency();
+   return count == 0 ? 1 : (int)count;
+}
@@ -0,0 +1,76 @@
+/** @file ThreadPool.h
+ * @author Korosh Moosavi
+ * @date 2026-10-16
+ *
+ * ThreadPool class:
+ * Fixed set of worker threads executing tasks from a shared queue.
+ * Used to spread independent work, such as parsing chunks of an input file,
+ *   across every core.
+ *
+ * Assumptions:
+ * parallelFor() is never called from inside a task of the same pool, since
+ *   the blocked worker could be the one needed to finish the loop.
+ */
+#pragma once
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+class ThreadPool {
+private:
+   vector<thread> workers;
+   queue<function<void()>> tasks;
+   mutex lock;
+   condition_variable available;
+   bool stopping;
+
+   /** ----------------------------- workerLoop() ---------------------
+    * Body of each worker thread, runs tasks until the pool is destroyed.
+    */
+   void workerLoop();
+
+public:
+   /** ------------------------------ Constructor ----------------------
+    * Starts the worker threads.
+    * @param threads Number of workers, 0 uses one per hardware thread.
+    */
+   ThreadPool(int threads = 0);
+
+   /** ------------------------------ Destructor -------------------------------
+    * Finishes queued tasks then joins every worker.
+    */
+   ~ThreadPool();
+
+   ThreadPool(const ThreadPool&) = delete;
+   ThreadPool& operator=(const ThreadPool&) = delete;
+
+   /** ----------------------------- size() ---------------------
+    * @return Number of worker threads.
+    */
+   int size() const { return (int)workers.size(); };
+
+   /** ----------------------------- submit(function) ---------------------
+    * Queues a task to be run by the next free worker.
+    * @param task Work to run, must not throw.
+    */
+   void submit(function<void()> task);
+
+   /** ----------------------------- parallelFor(size_t, function) ----------
+    * Runs body(i) for every i in [0, count) on the workers and waits for all
+    *   of them to finish. Several threads may call this at the same time.
+    * @param count Number of calls to make.
+    * @param body  Work for a single index, must not throw.
+    * @post  Every call has returned.
+    */
+   void parallelFor(size_t count, const function<void(size_t)>& body);
+
+   /** ----------------------------- hardwareThreads() ---------------------
+    * @return Number of hardware threads, at least 1.
+    */
+   static int hardwareThreads();
+};
@@ -0,0 +1,135 @@
+/** @file TransactionLog.cpp
+ * @author Korosh Moosavi
+ * @date 2026-10-16
+ *
+ * TransactionLog class:
+ * Store-wide, append-only record of every buy and sell.
+ * Each entry is a packed LogRecord referring to the inventory item by its
+ *   item ID instead of holding a copy of the item.
+ *
+ * Assumptions:
+ * Items appended to the log outlive it.
+ * Every logged item has a unique item ID assigned by Inventory.
+ */
+#include "TransactionLog.h"
+#include <iostream>
+
+/** ----------------------------- chunkAt(...) ---------------------
+ * Finds a chunk of a chunked array, allocating it if no thread has yet.
+ * When two threads allocate the same chunk, the one that stores it first
+ *   wins and the other frees its copy.
+ * @param chunks Chunk pointers of the array
+ * @param chunk  Number of the chunk to find
+ * @param size   Elements in a chunk
+ * @param used   Incremented when a chunk is allocated
+ * @return The chunk, with its elements zeroed when it is new
+ */
+template <typename T>
+static T* chunkAt(atomic<T*>* chunks, size_t chunk, size_t size, atomic<size_t>& used)
+{
+   T* found = chunks[chunk].load(memory_order_acquire);
+   if (found != nullptr)
+      return found;
+
+   T* fresh = new T[size]();
+   if (chunks[chunk].compare_exchange_strong(found, fresh, memory_order_acq_rel)) {
+      used.fetch_add(1, memory_order_relaxed);
+      return fresh;
+   }
+   delete[] fresh;                        // Another thread stored one first
+   return found;
+}
+
+/** ------------------------------ Constructor ----------------------
+ * Creates an empty log, chunks are allocated as entries are added.
+ */
+TransactionLog::TransactionLog()
+{
+   records = new atomic<LogRecord*>[MAX_RECORD_CHUNKS]();
+   items = new atomic<atomic<const Collectible*>*>[MAX_ITEM_CHUNKS]();
+}
+
+/** ------------------------------ Destructor -------------------------------
+ * Frees every chunk, logged items are owned by Inventory.
+ */
+TransactionLog::~TransactionLog()
+{
+   for (size_t i = 0; i < MAX_RECORD_CHUNKS; i++)
+      delete[] records[i].load(memory_order_relaxed);
+   for (size_t i = 0; i < MAX_ITEM_CHUNKS; i++)
+      delete[] items[i].load(memory_order_relaxed);
+   delete[] records;
+   delete[] items;
+}
+
+/** ----------------------------- append(Collectible&, int, bool, uint64_t) -
+ * Adds a transaction to the end of the log.
+ * Safe to call from several threads at once. The position is taken with
+ *   an atomic increment and the entry written to its chunk, so appends
+ *   only wait on each other to allocate a chunk, once per CHUNK_SIZE
+ *   entries.
+ * @param item     Inventory item traded
+ * @param quantity Number of items traded
+ * @param isBuy    Whether the item was bought from or sold to the customer
+ * @param sequence Position of the trading command in the transactions file
+ * @return Position of the new entry, used to look it up later, or FULL
+ *           if the log holds as many entries as it can
+ */
+size_t TransactionLog::append(const Collectible& item, int quantity, bool isBuy,
+                              uint64_t sequence)
+{
+   uint32_t itemId = item.getItemId();
+   size_t entry = count.fetch_add(1, memory_order_relaxed);
+
+   if (entry >> CHUNK_BITS >= MAX_RECORD_CHUNKS) {
+      cerr << "Transaction log is full, the trade is not logged.\n\n";
+      return FULL;
+   }
+
+   atomic<const Collectible*>& logged =
+      chunkAt(items, itemId >> CHUNK_BITS, CHUNK_SIZE, itemChunks)[itemId & (CHUNK_SIZE - 1)];
+   if (logged.load(memory_order_relaxed) != &item)    // First trade of the item
+      logged.store(&item, memory_order_relaxed);
+
+   chunkAt(records, entry >> CHUNK_BITS, CHUNK_SIZE, recordChunks)[entry & (CHUNK_SIZE - 1)] =
+      { sequence, itemId, (uint16_t)quantity, isBuy };
+   return entry;
+}
+
+/** ----------------------------- reserve(size_t) ---------------------
+ * Makes room for a known number of entries, such as when restoring a
+ *   saved log, by allocating their chunks up front.
+ * @param entries Number of entries the log will hold
+ */
+void TransactionLog::reserve(size_t entries)
+{
+   size_t chunks = min((entries + CHUNK_SIZE - 1) >> CHUNK_BITS, MAX_RECORD_CHUNKS);
+
+   for (size_t chunk = 0; chunk < chunks; chunk++)
+      chunkAt(records, chunk, CHUNK_SIZE, recordChunks);
+}
+
+/** ----------------------------- memoryUsed() ---------------------
+ * @return Bytes allocated for entries and the item table.
+ */
+size_t TransactionLog::memoryUsed() const
+{
+   return recordChunks.load(memory_order_relaxed) * CHUNK_SIZE * sizeof(LogRecord)
+      + itemChunks.load(memory_order_relaxed) * CHUNK_SIZE * sizeof(atomic<const Collectible*>)
+      + MAX_RECORD_CHUNKS * sizeof(atomic<LogRecord*>)
+      + MAX_ITEM_CHUNKS * sizeof(atomic<atomic<const Collectible*>*>);
+}
+
+/** ----------------------------- print(ostream&, size_t) ----------------
+ * Outputs an entry as the direction of the trade followed by the item,
+ *   with the quantity traded in place of the item's stock.
+ * @param output Stream to write to
+ * @param entry  Position returned by append()
+ */
+void TransactionLog::print(ostream& output, size_t entry) const
+{
+   const LogRecord& record = getRecord(entry);
+
+   output << (record.isBuy ? "Bought a(n) " : "Sold a(n)   ");
+   getItem(record.itemId).printWithCount(output, record.quantity);
+}
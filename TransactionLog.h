@@ -0,0 +1,128 @@
+/** @file TransactionLog.h
+ * @author Korosh Moosavi
+ * @date 2026-10-16
+ *
+ * TransactionLog class:
+ * Store-wide, append-only record of every buy and sell.
+ * Each entry is a packed LogRecord referring to the inventory item by its
+ *   item ID instead of holding a copy of the item, so an entry costs 16 bytes
+ *   no matter how long the item's strings are.
+ * Customers keep the positions of their own entries, see Customer.
+ * Entries may be appended by several threads at once without a lock: each
+ *   append takes its position with an atomic increment and writes into
+ *   fixed-size chunks that never move, allocated the first time a position
+ *   in them is taken. Reading entries is only safe while nothing is
+ *   appended.
+ *
+ * Assumptions:
+ * Items appended to the log outlive it, which holds for Inventory items
+ *   since Inventory is destroyed after CustomerRegistry.
+ * Every logged item has a unique item ID assigned by Inventory.
+ */
+#pragma once
+#include "Collectible.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+using namespace std;
+
+/** ------------------------ LogRecord struct --------------------------
+ * Single transaction, packed into 16 bytes
+ * sequence is the position in the transactions file of the command that
+ *   made the trade, which orders entries across the whole store
+ */
+struct LogRecord {
+   uint64_t sequence;
+   uint32_t itemId;
+   uint16_t quantity;
+   bool isBuy;          // Store bought from (true) or sold to the customer
+};
+
+class TransactionLog {
+private:
+   static const int CHUNK_BITS = 16;                     // Entries per chunk
+   static const size_t CHUNK_SIZE = (size_t)1 << CHUNK_BITS;
+   static const size_t MAX_RECORD_CHUNKS = (size_t)1 << 18;   // 2^34 entries
+   static const size_t MAX_ITEM_CHUNKS = (size_t)1 << (32 - CHUNK_BITS);
+
+   atomic<size_t> count{0};                  // Positions taken by append()
+   atomic<LogRecord*>* records;              // MAX_RECORD_CHUNKS chunks
+   atomic<atomic<const Collectible*>*>* items;   // Logged items by item ID,
+                                             //   MAX_ITEM_CHUNKS chunks
+   atomic<size_t> recordChunks{0};           // Chunks allocated so far
+   atomic<size_t> itemChunks{0};
+
+public:
+   static const size_t FULL = SIZE_MAX;      // Returned when out of entries
+
+   /** ------------------------------ Constructor ----------------------
+    * Creates an empty log, chunks are allocated as entries are added.
+    */
+   TransactionLog();
+
+   /** ------------------------------ Destructor -------------------------------
+    * Frees every chunk, logged items are owned by Inventory.
+    */
+   ~TransactionLog();
+
+   TransactionLog(const TransactionLog&) = delete;
+   TransactionLog& operator=(const TransactionLog&) = delete;
+
+   /** ----------------------------- append(Collectible&, int, bool, uint64_t) -
+    * Adds a transaction to the end of the log.
+    * Safe to call from several threads at once.
+    * @param item     Inventory item traded
+    * @param quantity Number of items traded
+    * @param isBuy    Whether the item was bought from or sold to the customer
+    * @param sequence Position of the trading command in the transactions file
+    * @return Position of the new entry, used to look it up later, or FULL
+    *           if the log holds as many entries as it can
+    */
+   size_t append(const Collectible& item, int quantity, bool isBuy, uint64_t sequence);
+
+   /** ----------------------------- size() ---------------------
+    * @return Number of entries in the log.
+    */
+   size_t size() const { return min(count.load(memory_order_relaxed),
+                                    MAX_RECORD_CHUNKS << CHUNK_BITS); };
+
+   /** ----------------------------- reserve(size_t) ---------------------
+    * Makes room for a known number of entries, such as when restoring a
+    *   saved log.
+    * @param entries Number of entries the log will hold
+    */
+   void reserve(size_t entries);
+
+   /** ----------------------------- getRecord(size_t) ---------------------
+    * @param entry Position returned by append()
+    * @return The packed entry.
+    */
+   const LogRecord& getRecord(size_t entry) const
+   {
+      return records[entry >> CHUNK_BITS].load(memory_order_relaxed)[entry & (CHUNK_SIZE - 1)];
+   };
+
+   /** ----------------------------- getItem(uint32_t) ---------------------
+    * @param itemId ID of an item that has been logged
+    * @return The item with that ID.
+    */
+   const Collectible& getItem(uint32_t itemId) const
+   {
+      return *items[itemId >> CHUNK_BITS].load(memory_order_relaxed)[itemId & (CHUNK_SIZE - 1)]
+         .load(memory_order_relaxed);
+   };
+
+   /** ----------------------------- print(ostream&, size_t) ----------------
+    * Outputs an entry as the direction of the trade followed by the item,
+    *   with the quantity traded in place of the item's stock.
+    * @param output Stream to write to
+    * @param entry  Position returned by append()
+    */
+   void print(ostream& output, size_t entry) const;
+
+   /** ----------------------------- memoryUsed() ---------------------
+    * @return Bytes allocated for entries and the item table.
+    */
+   size_t memoryUsed() const;
+};
@@ -0,0 +1,140 @@
+/** @file WorkStealingPool.cpp
+ * @author Korosh Moosavi
+ * @date 2026-10-16
+ *
+ * WorkStealingPool class:
+ * Set of worker threads, each with its own queue of tasks, that steal from
+ *   each other when their own queue is empty.
+ *
+ * Assumptions:
+ * Tasks do not throw.
+ * wait() is not called from inside a task of the same pool.
+ */
+#include "WorkStealingPool.h"
+#include "ThreadPool.h"
+
+thread_local WorkStealingPool* WorkStealingPool::currentPool = nullptr;
+thread_local size_t WorkStealingPool::currentWorker = 0;
+
+/** ------------------------------ Constructor ----------------------
+ * Starts the worker threads.
+ * @param threads Number of workers, 0 uses one per hardware thread.
+ */
+WorkStealingPool::WorkStealingPool(int threads)
+   : queued(0), pending(0), nextQueue(0), steals(0), stopping(false)
+{
+   if (threads <= 0)
+      threads = ThreadPool::hardwareThreads();
+
+   for (int i = 0; i < threads; i++)
+      queues.push_back(new WorkerQueue);
+   for (int i = 0; i < threads; i++)
+      workers.emplace_back(&WorkStealingPool::workerLoop, this, (size_t)i);
+}
+
+/** ------------------------------ Destructor -------------------------------
+ * Finishes queued tasks then joins every worker.
+ */
+WorkStealingPool::~WorkStealingPool()
+{
+   {
+      lock_guard<mutex> guard(idleLock);
+      stopping = true;
+   }
+   available.notify_all();
+
+   for (thread& worker : workers)
+      worker.join();
+   for (WorkerQueue* queue : queues)
+      delete queue;
+}
+
+/** ----------------------------- take(size_t, function&) ----------------
+ * Finds the next task for a worker, from its own queue or stolen.
+ * The worker's own newest task is taken first, then the oldest task of
+ *   each other worker in turn.
+ * @param self Index of the worker looking for work.
+ * @param task Set to the task found.
+ * @return True if a task was found.
+ */
+bool WorkStealingPool::take(size_t self, function<void()>& task)
+{
+   for (size_t i = 0; i < queues.size(); i++) {
+      WorkerQueue& queue = *queues[(self + i) % queues.size()];
+      lock_guard<mutex> guard(queue.lock);
+
+      if (queue.tasks.empty())
+         continue;
+      if (i == 0) {
+         task = move(queue.tasks.back());
+         queue.tasks.pop_back();
+      } else {
+         task = move(queue.tasks.front());
+         queue.tasks.pop_front();
+         steals.fetch_add(1, memory_order_relaxed);
+      }
+      queued.fetch_sub(1);
+      return true;
+   }
+   return false;
+}
+
+/** ----------------------------- workerLoop(size_t) ---------------------
+ * Body of each worker thread, runs tasks until the pool is destroyed.
+ * @param self Index of the worker and its queue.
+ */
+void WorkStealingPool::workerLoop(size_t self)
+{
+   currentPool = this;
+   currentWorker = self;
+
+   while (true) {
+      function<void()> task;
+
+      if (!take(self, task)) {
+         unique_lock<mutex> guard(idleLock);
+         available.wait(guard, [this] { return stopping || queued.load() > 0; });
+
+         if (stopping && queued.load() == 0)    // Nothing left to run
+            return;
+         continue;
+      }
+      task();
+
+      if (pending.fetch_sub(1) == 1) {          // Last task has finished
+         lock_guard<mutex> guard(idleLock);
+         finished.notify_all();
+      }
+   }
+}
+
+/** ----------------------------- submit(function) ---------------------
+ * Queues a task on the calling worker's own queue, or on the next queue
+ *   in turn when called from outside the pool.
+ * @param task Work to run, must not throw.
+ */
+void WorkStealingPool::submit(function<void()> task)
+{
+   size_t target = currentPool == this ? currentWorker
+                                       : nextQueue.fetch_add(1) % queues.size();
+   pending.fetch_add(1);
+   {
+      lock_guard<mutex> guard(idleLock);    // No worker misses the wake up
+      lock_guard<mutex> pushing(queues[target]->lock);
+
+      queues[target]->tasks.push_back(move(task));
+      queued.fetch_add(1);
+   }
+   available.notify_one();
+}
+
+/** ----------------------------- wait() ---------------------
+ * Blocks until every submitted task, and every task they submitted,
+ *   has finished.
+ * @post  No task is queued or running.
+ */
+void WorkStealingPool::wait()
+{
+   unique_lock<mutex> guard(idleLock);
+   finished.wait(guard, [this] { return pending.load() == 0; });
+}
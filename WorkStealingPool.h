@@ -0,0 +1,109 @@
+/** @file WorkStealingPool.h
+ * @author Korosh Moosavi
+ * @date 2026-10-16
+ *
+ * WorkStealingPool class:
+ * Set of worker threads, each with its own queue of tasks.
+ * Tasks submitted by a worker go to the back of its own queue and it runs
+ *   them newest first, which keeps a task that submits its own continuation
+ *   on the same thread and its data in that thread's cache.
+ * A worker with an empty queue steals the oldest task of another worker, so
+ *   no thread stays idle while any queue has work.
+ * Used to run many independent command streams, where the amount of work in
+ *   each stream is not known ahead of time.
+ *
+ * Assumptions:
+ * Tasks do not throw.
+ * wait() is not called from inside a task of the same pool.
+ */
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+class WorkStealingPool {
+private:
+   /** ------------------------ WorkerQueue struct --------------------------
+    * Tasks of a single worker, the owner takes from the back and thieves
+    *   take from the front
+    */
+   struct WorkerQueue {
+      mutex lock;
+      deque<function<void()>> tasks;
+   };
+
+   vector<WorkerQueue*> queues;
+   vector<thread> workers;
+   mutex idleLock;                  // Guards sleeping, waking and stopping
+   condition_variable available;    // Signalled when a task is queued
+   condition_variable finished;     // Signalled when no task is left
+   atomic<size_t> queued;           // Tasks waiting in any queue
+   atomic<size_t> pending;          // Tasks submitted but not yet finished
+   atomic<size_t> nextQueue;        // Round robin for outside submissions
+   atomic<uint64_t> steals;
+   bool stopping;
+
+   static thread_local WorkStealingPool* currentPool;
+   static thread_local size_t currentWorker;
+
+   /** ----------------------------- workerLoop(size_t) ---------------------
+    * Body of each worker thread, runs tasks until the pool is destroyed.
+    * @param self Index of the worker and its queue.
+    */
+   void workerLoop(size_t self);
+
+   /** ----------------------------- take(size_t, function&) ----------------
+    * Finds the next task for a worker, from its own queue or stolen.
+    * @param self Index of the worker looking for work.
+    * @param task Set to the task found.
+    * @return True if a task was found.
+    */
+   bool take(size_t self, function<void()>& task);
+
+public:
+   /** ------------------------------ Constructor ----------------------
+    * Starts the worker threads.
+    * @param threads Number of workers, 0 uses one per hardware thread.
+    */
+   WorkStealingPool(int threads = 0);
+
+   /** ------------------------------ Destructor -------------------------------
+    * Finishes queued tasks then joins every worker.
+    */
+   ~WorkStealingPool();
+
+   WorkStealingPool(const WorkStealingPool&) = delete;
+   WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+   /** ----------------------------- size() ---------------------
+    * @return Number of worker threads.
+    */
+   int size() const { return (int)workers.size(); };
+
+   /** ----------------------------- submit(function) ---------------------
+    * Queues a task on the calling worker's own queue, or on the next queue
+    *   in turn when called from outside the pool.
+    * @param task Work to run, must not throw.
+    */
+   void submit(function<void()> task);
+
+   /** ----------------------------- wait() ---------------------
+    * Blocks until every submitted task, and every task they submitted,
+    *   has finished.
+    * @post  No task is queued or running.
+    */
+   void wait();
+
+   /** ----------------------------- getSteals() ---------------------
+    * @return Number of tasks run by a worker other than the one they were
+    *           queued on.
+    */
+   uint64_t getSteals() const { return steals.load(memory_order_relaxed); };
+};
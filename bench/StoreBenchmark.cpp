@@ -0,0 +1,226 @@
+/** @file StoreBenchmark.cpp
+ * @author Korosh Moosavi
+ * @date 2026-10-16
+ *
+ * Times CollectibleStore end to end in three phases and prints one JSON
+ *   object per run, so results of different builds can be compared:
+ * load    - loadFiles(), building the inventory and customer registry
+ * replay  - runTransactions(), processing every command
+ * report  - outputReports(), a full inventory display and customer history
+ * Reports are rendered but discarded, so disk and terminal speed are not
+ *   measured. Error messages are discarded as well unless --errors is given.
+ * The shared InternPool is cleared before every run, so each run loads into
+ *   a cold pool like a new process would, unless --warm-pool is given.
+ *
+ * Build, from this directory, with every store source except main.cpp:
+ *   g++ -std=c++17 -O2 -pthread -I.. StoreBenchmark.cpp ../[A-Z]*.cpp -o benchmark
+ *
+ * Options:         --inventory F   Inventory file (default inventory.txt)
+ *                  --customers F   Customer file (default customers.txt)
+ *                  --commands F    Command file (default commands.txt)
+ *                  --load-threads N
+ *                                  Same as the store option
+ *                  --pipeline      Same as the store option
+ *                  --workers N     Same as the store option
+ *                  --snapshot F    Load from snapshot F instead of the
+ *                                  inventory and customer files
+ *                  --journal F     Journal changes to F, which is deleted
+ *                                  before every run so nothing is replayed
+ *                  --journal-delay US
+ *                                  Same as the store option
+ *                  --runs N        Times to repeat every phase (default 3)
+ *                  --label L       Name of the build, copied into results
+ *                  --errors        Keep error messages on standard error
+ *                  --warm-pool     Keep interned strings between runs, so
+ *                                  runs after the first are marked as not
+ *                                  cold
+ *
+ * Preconditions:   Input files exist, such as written by WorkloadGenerator.
+ * Postconditions:  One line of JSON per run is written to standard output.
+ */
+#include "CollectibleStore.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+using namespace std;
+
+/** ------------------------ FileCounts struct --------------------------
+ * Size and number of non-empty lines of an input file
+ */
+struct FileCounts {
+   uint64_t bytes = 0;
+   uint64_t lines = 0;
+};
+
+/** ----------------------------- countLines(string) ---------------------
+ * @param fileName File to measure
+ * @return Size and non-empty line count of the file
+ */
+static FileCounts countLines(const string& fileName)
+{
+   MappedFile file(fileName);
+   string_view unread = file.contents();
+   FileCounts counts;
+
+   counts.bytes = file.size();
+   while (!unread.empty()) {
+      if (!MappedFile::nextLine(unread).empty())
+         counts.lines++;
+   }
+   return counts;
+}
+
+/** ----------------------------- peakMemoryKb() ---------------------
+ * @return Peak resident memory of this process in KiB, 0 if unknown.
+ */
+static long peakMemoryKb()
+{
+#ifdef _WIN32
+   return 0;
+#else
+   struct rusage usage;
+   if (getrusage(RUSAGE_SELF, &usage) != 0)
+      return 0;
+#ifdef __APPLE__
+   return usage.ru_maxrss / 1024;      // Reported in bytes
+#else
+   return usage.ru_maxrss;
+#endif
+#endif
+}
+
+/** ----------------------------- secondsSince(time_point) ---------------
+ * @return Seconds elapsed since start.
+ */
+static double secondsSince(chrono::steady_clock::time_point start)
+{
+   return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+   string inventoryFile = "inventory.txt";
+   string customerFile = "customers.txt";
+   string commandFile = "commands.txt";
+   string snapshotFile;
+   string journalFile;
+   int journalDelay = 1000;
+   string label;
+   int loadThreads = 1;
+   bool pipelined = false;
+   int workers = 1;
+   bool keepErrors = false;
+   bool warmPool = false;
+   int runs = 3;
+
+   for (int i = 1; i < argc; i++) {
+      string option = argv[i];
+      bool hasValue = i + 1 < argc;
+
+      if (option == "--inventory" && hasValue) {
+         inventoryFile = argv[++i];
+      } else if (option == "--customers" && hasValue) {
+         customerFile = argv[++i];
+      } else if (option == "--commands" && hasValue) {
+         commandFile = argv[++i];
+      } else if (option == "--load-threads" && hasValue) {
+         loadThreads = atoi(argv[++i]);
+      } else if (option == "--pipeline") {
+         pipelined = true;
+      } else if (option == "--workers" && hasValue) {
+         workers = atoi(argv[++i]);
+      } else if (option == "--snapshot" && hasValue) {
+         snapshotFile = argv[++i];
+      } else if (option == "--journal" && hasValue) {
+         journalFile = argv[++i];
+      } else if (option == "--journal-delay" && hasValue) {
+         journalDelay = atoi(argv[++i]);
+      } else if (option == "--runs" && hasValue) {
+         runs = atoi(argv[++i]);
+      } else if (option == "--label" && hasValue) {
+         for (const char* c = argv[++i]; *c != '\0'; c++) {
+            if (*c == '"' || *c == '\\')   // Escape for JSON
+               label += '\\';
+            label += *c;
+         }
+      } else if (option == "--errors") {
+         keepErrors = true;
+      } else if (option == "--warm-pool") {
+         warmPool = true;
+      } else {
+         cerr << "Unrecognized option " << option << ".\n" << endl;
+         return 1;
+      }
+   }
+
+   FileCounts inventory = countLines(inventoryFile);
+   FileCounts customers = countLines(customerFile);
+   FileCounts commands = countLines(commandFile);
+
+   OutputSink discarded(OutputSink::TO_DISCARD);
+   streambuf* console = cerr.rdbuf();
+
+   for (int run = 1; run <= runs; run++) {
+      bool cold = run == 1 || !warmPool;
+      if (run > 1 && !warmPool)
+         InternPool::shared().clear();        // Previous store is destroyed
+
+      CollectibleStore store(inventoryFile, customerFile, commandFile);
+      store.setLoadThreads(loadThreads);
+      store.setPipelined(pipelined);
+      store.setWorkers(workers);
+      store.setSnapshotFile(snapshotFile);
+      store.setJournalFile(journalFile, journalDelay);
+      if (!journalFile.empty())
+         remove(journalFile.c_str());
+
+      OutputSink reports(OutputSink::TO_DISCARD);
+      ostream output(&reports);
+      if (!keepErrors)
+         cerr.rdbuf(&discarded);
+
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      store.loadFiles();
+      double load = secondsSince(start);
+
+      start = chrono::steady_clock::now();
+      store.runTransactions(output);
+      double replay = secondsSince(start);
+      uint64_t replayBytes = reports.getBytes();
+
+      start = chrono::steady_clock::now();
+      store.outputReports(output);
+      double report = secondsSince(start);
+
+      cerr.rdbuf(console);
+
+      cout << "{\"label\": \"" << label << "\", \"run\": " << run
+         << ", \"cold\": " << (cold ? "true" : "false")
+         << ", \"load_threads\": " << loadThreads
+         << ", \"pipeline\": " << (pipelined ? "true" : "false")
+         << ", \"workers\": " << workers
+         << ", \"snapshot\": " << (snapshotFile.empty() ? "false" : "true")
+         << ", \"journal_delay_us\": " << (journalFile.empty() ? -1 : journalDelay)
+         << ", \"inventory_records\": " << inventory.lines
+         << ", \"inventory_bytes\": " << inventory.bytes
+         << ", \"customer_records\": " << customers.lines
+         << ", \"customer_bytes\": " << customers.bytes
+         << ", \"commands\": " << commands.lines
+         << ", \"command_bytes\": " << commands.bytes
+         << ", \"load_s\": " << load
+         << ", \"replay_s\": " << replay
+         << ", \"report_s\": " << report
+         << ", \"total_s\": " << load + replay + report
+         << ", \"commands_per_s\": " << (replay > 0.0 ? commands.lines / replay : 0.0)
+         << ", \"replay_output_bytes\": " << replayBytes
+         << ", \"report_output_bytes\": " << reports.getBytes() - replayBytes
+         << ", \"peak_rss_kb\": " << peakMemoryKb() << "}" << endl;
+   }
+
+   return 0;
+}
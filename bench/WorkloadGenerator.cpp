@@ -0,0 +1,289 @@
+/** @file WorkloadGenerator.cpp
+ * @author Korosh Moosavi
+ * @date 2026-10-16
+ *
+ * Writes synthetic inventory, customer and command files in the formats read
+ *   by CollectibleStore, at any scale, for use with StoreBenchmark.
+ *
+ * Build:           g++ -std=c++17 -O2 WorkloadGenerator.cpp -o generator
+ *
+ * Options:         --items N      Inventory records (default 1000)
+ *                  --customers N  Customer records (default 1000)
+ *                  --commands N   Command records (default 10000)
+ *                  --zipf S       Item popularity skew, 0 for uniform
+ *                                 (default 0, 1 is a typical Zipf skew)
+ *                  --mix B,S,C,D,H
+ *                                 Relative weights of each command
+ *                                 (default 45,45,8,1,1)
+ *                  --seed N       Random seed (default 1)
+ *                  --prefix P     Output files are P + "inventory.txt",
+ *                                 "customers.txt", "commands.txt"
+ *                                 (default "", the current directory)
+ *
+ * Preconditions:   None
+ * Postconditions:  The three files are written. The same options always
+ *                  produce the same files.
+ *
+ * Notes:
+ * Every generated item is unique, and every command refers to a generated
+ *   item and customer. Sell commands can still fail when an item runs out of
+ *   stock, as in real use.
+ */
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/** ------------------------ Options struct --------------------------
+ * Command line settings of the generator
+ */
+struct Options {
+   uint64_t items = 1000;
+   uint64_t customers = 1000;
+   uint64_t commands = 10000;
+   double zipf = 0.0;
+   double mix[5] = { 45, 45, 8, 1, 1 };   // B, S, C, D, H
+   uint64_t seed = 1;
+   string prefix;
+};
+
+/** ------------------------ ItemPicker class --------------------------
+ * Chooses item numbers so popularity follows a Zipf distribution.
+ * Uses the inverse of the continuous power law, so no table of N weights
+ *   is needed even for 10^8 items. Ranks are scattered over the item
+ *   numbers so the popular items are not all at the start of the file.
+ */
+class ItemPicker {
+private:
+   uint64_t count;
+   double skew;
+   uint64_t stride;     // Coprime with count, maps rank to item number
+
+public:
+   ItemPicker(uint64_t items, double s) : count(items), skew(s)
+   {
+      stride = 2654435761ULL % count;      // Knuth's multiplicative constant
+      if (stride == 0)
+         stride = 1;
+      while (gcd(stride, count) != 1)
+         stride++;
+   };
+
+   static uint64_t gcd(uint64_t a, uint64_t b)
+   {
+      while (b != 0) {
+         uint64_t t = a % b;
+         a = b;
+         b = t;
+      }
+      return a;
+   };
+
+   uint64_t pick(mt19937_64& random) const
+   {
+      double u = uniform_real_distribution<double>(0.0, 1.0)(random);
+      double rank;
+
+      if (skew <= 0.0)                      // Uniform
+         rank = u * count;
+      else if (fabs(skew - 1.0) < 1e-9)     // Limit of the formula below
+         rank = pow((double)count, u) - 1.0;
+      else
+         rank = pow((pow((double)count, 1.0 - skew) - 1.0) * u + 1.0,
+                    1.0 / (1.0 - skew)) - 1.0;
+
+      uint64_t r = (uint64_t)rank;
+      if (r >= count)
+         r = count - 1;
+      return (r * stride) % count;
+   };
+};
+
+static const char* COIN_NAMES[] = { "Lincoln", "Liberty", "Buffalo", "Jefferson",
+                                    "Roosevelt", "Washington", "Kennedy", "Sacagawea" };
+static const char* COIN_TYPES[] = { "Cent", "Nickel", "Dime", "Quarter", "Dollar" };
+static const char* COMIC_NAMES[] = { "Superman", "X-Men", "Batman", "Spider-Man",
+                                     "Wonder Woman", "Fantastic Four", "Hulk" };
+static const char* COMIC_TYPES[] = { "DC", "Marvel", "Image", "Dark Horse" };
+static const char* CARD_NAMES[] = { "Ken Griffey Jr.", "Mickey Mantle", "Babe Ruth",
+                                    "Michael Jordan", "Wayne Gretzky", "Pele" };
+static const char* CARD_TYPES[] = { "Upper Deck", "Topps", "Fleer", "Panini" };
+static const char* GRADES[] = { "Mint", "Near Mint", "Excellent", "Very Good",
+                                "Good", "Fine", "Poor" };
+static const char* FIRST_NAMES[] = { "Ann", "Bob", "Cy", "Di", "Ed", "Flo", "Gus", "Hal" };
+static const char* LAST_NAMES[] = { "Lee", "Kim", "Ray", "Soze", "Ng", "Diaz", "Park" };
+
+#define COUNT_OF(array) (sizeof(array) / sizeof(*array))
+
+/** ----------------------------- itemFields(uint64_t, ...) ----------------
+ * Builds the fields of item number i, the same every time it is called.
+ * The name carries a serial number once the name list is used up, which
+ *   keeps every item unique.
+ * @param i      Item number
+ * @param symbol Set to the item's category symbol
+ * @param year   Set to the item's year
+ * @param rest   Set to the text after the year: grade, name and type
+ */
+static void itemFields(uint64_t i, char& symbol, int& year, string& rest)
+{
+   uint64_t round = i / 3;
+   year = 1900 + (int)(round * 7 % 121);
+
+   switch (i % 3) {
+   case 0: {                              // Coin, name and type split by space
+      uint64_t names = COUNT_OF(COIN_NAMES);
+      symbol = 'M';
+      rest = to_string(1 + round % 70) + ", " + COIN_NAMES[round % names];
+      if (round >= names)
+         rest += to_string(round / names);
+      rest += string(" ") + COIN_TYPES[round / 3 % COUNT_OF(COIN_TYPES)];
+      break;
+   }
+   case 1: {
+      uint64_t names = COUNT_OF(COMIC_NAMES);
+      symbol = 'C';
+      rest = string(GRADES[round % COUNT_OF(GRADES)]) + ", " + COMIC_NAMES[round % names];
+      if (round >= names)
+         rest += " " + to_string(round / names);
+      rest += string(", ") + COMIC_TYPES[round / 5 % COUNT_OF(COMIC_TYPES)];
+      break;
+   }
+   default: {
+      uint64_t names = COUNT_OF(CARD_NAMES);
+      symbol = 'S';
+      rest = string(GRADES[round % COUNT_OF(GRADES)]) + ", " + CARD_NAMES[round % names];
+      if (round >= names)
+         rest += " " + to_string(round / names);
+      rest += string(", ") + CARD_TYPES[round / 5 % COUNT_OF(CARD_TYPES)];
+      break;
+   }
+   }
+}
+
+/** ----------------------------- parseOptions(int, char*[], Options&) -----
+ * @return False with a message on cerr if an option is not recognized.
+ */
+static bool parseOptions(int argc, char* argv[], Options& options)
+{
+   for (int i = 1; i < argc; i++) {
+      string option = argv[i];
+      bool hasValue = i + 1 < argc;
+
+      if (option == "--items" && hasValue) {
+         options.items = strtoull(argv[++i], nullptr, 10);
+      } else if (option == "--customers" && hasValue) {
+         options.customers = strtoull(argv[++i], nullptr, 10);
+      } else if (option == "--commands" && hasValue) {
+         options.commands = strtoull(argv[++i], nullptr, 10);
+      } else if (option == "--zipf" && hasValue) {
+         options.zipf = atof(argv[++i]);
+      } else if (option == "--mix" && hasValue) {
+         if (sscanf(argv[++i], "%lf,%lf,%lf,%lf,%lf", &options.mix[0], &options.mix[1],
+                    &options.mix[2], &options.mix[3], &options.mix[4]) != 5) {
+            fprintf(stderr, "--mix needs 5 comma separated weights.\n\n");
+            return false;
+         }
+      } else if (option == "--seed" && hasValue) {
+         options.seed = strtoull(argv[++i], nullptr, 10);
+      } else if (option == "--prefix" && hasValue) {
+         options.prefix = argv[++i];
+      } else {
+         fprintf(stderr, "Unrecognized option %s.\n\n", option.c_str());
+         return false;
+      }
+   }
+
+   if (options.items == 0 || options.customers == 0) {
+      fprintf(stderr, "At least 1 item and 1 customer are needed.\n\n");
+      return false;
+   }
+   return true;
+}
+
+/** ----------------------------- openOutput(string) ---------------------
+ * Opens an output file with a large buffer.
+ * @return The file, nullptr with a message on cerr on failure.
+ */
+static FILE* openOutput(const string& fileName, vector<char>& buffer)
+{
+   FILE* file = fopen(fileName.c_str(), "wb");
+   if (file == nullptr) {
+      fprintf(stderr, "Unable to open %s.\n\n", fileName.c_str());
+      return nullptr;
+   }
+   buffer.resize(1 << 20);
+   setvbuf(file, buffer.data(), _IOFBF, buffer.size());
+   return file;
+}
+
+int main(int argc, char* argv[])
+{
+   Options options;
+   if (!parseOptions(argc, argv, options))
+      return 1;
+
+   mt19937_64 random(options.seed);
+   vector<char> buffer;
+   char symbol;
+   int year;
+   string rest;
+
+   FILE* file = openOutput(options.prefix + "inventory.txt", buffer);
+   if (file == nullptr)
+      return 1;
+   for (uint64_t i = 0; i < options.items; i++) {
+      itemFields(i, symbol, year, rest);
+      fprintf(file, "%c, %d, %d, %s\n", symbol, (int)(random() % 10), year, rest.c_str());
+   }
+   fclose(file);
+
+   file = openOutput(options.prefix + "customers.txt", buffer);
+   if (file == nullptr)
+      return 1;
+   for (uint64_t i = 0; i < options.customers; i++) {
+      fprintf(file, "%03llu, %s %s\n", (unsigned long long)i,
+              FIRST_NAMES[random() % COUNT_OF(FIRST_NAMES)],
+              LAST_NAMES[random() % COUNT_OF(LAST_NAMES)]);
+   }
+   fclose(file);
+
+   file = openOutput(options.prefix + "commands.txt", buffer);
+   if (file == nullptr)
+      return 1;
+
+   ItemPicker picker(options.items, options.zipf);
+   discrete_distribution<int> action(options.mix, options.mix + 5);
+   uniform_int_distribution<uint64_t> customer(0, options.customers - 1);
+
+   for (uint64_t i = 0; i < options.commands; i++) {
+      int kind = action(random);
+
+      switch (kind) {
+      case 0:
+      case 1:                             // Buy or sell a single item
+         itemFields(picker.pick(random), symbol, year, rest);
+
+         // Commands have no stock field, grade follows the year
+         fprintf(file, "%c, %03llu, %c, %d, %s\n", kind == 0 ? 'B' : 'S',
+                 (unsigned long long)customer(random), symbol, year, rest.c_str());
+         break;
+      case 2:
+         fprintf(file, "C, %03llu\n", (unsigned long long)customer(random));
+         break;
+      case 3:
+         fputs("D\n", file);
+         break;
+      default:
+         fputs("H\n", file);
+         break;
+      }
+   }
+   fclose(file);
+
+   return 0;
+}
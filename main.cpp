@@ -1,26 +1,96 @@
-/** @file main.cpp
- * @author Korosh Moosavi
- * @date 2021-03-12
- * 
- * Executes the CollectibleStore class by reading data from:
- * "inventory.txt" - Collectible inventory data
- *                   Format: S, 9, 1989, Near Mint, Ken Griffey Jr., Upper Deck
- * "customers.txt" - Registered customer data
- *                   Format: 001, Michael Jordan
- * "commands.txt"  - Transactions and operations to be processed
- *                   Format: S, 001, S, 1989, Near Mint, Ken Griffey Jr., Upper Deck
- *
- * Preconditions:   Each of the input files must strictly follow their
- *                  pre-established formats.
- * Postconditions:  All recognized items and customers will be tracked as the
- *                  as the various operations are performed on these objects.
- */
-#include "CollectibleStore.h"
-using namespace std;
-
-int main() {
-   CollectibleStore store1("inventory.txt", "customers.txt", "commands.txt");
-   store1.beginProcessing();
-
-   return 0;
+/** @file main.cpp
+ * @author Korosh Moosavi
+ * @date 2021-03-12
+ * 
+ * Executes the CollectibleStore class by reading data from:
+ * "inventory.txt" - Collectible inventory data
+ *                   Format: S, 9, 1989, Near Mint, Ken Griffey Jr., Upper Deck
+ * "customers.txt" - Registered customer data
+ *                   Format: 001, Michael Jordan
+ * "commands.txt"  - Transactions and operations to be processed
+ *                   Format: S, 001, S, 1989, Near Mint, Ken Griffey Jr., Upper Deck
+ *
+ * Options:         --stats  Report load throughput and index statistics
+ *                           to standard error.
+ *                  --load-threads N
+ *                           Load input files with N threads, 0 for one per
+ *                           core. Default is 1 (serial).
+ *                  --pipeline
+ *                           Parse, apply, and output transactions on
+ *                           separate threads. Output is unchanged.
+ *                  --workers N
+ *                           Apply buys and sells on N threads, 0 for one
+ *                           per core. Default is 1. Output is unchanged.
+ *                  --stream FILE
+ *                           Process FILE, such as the commands of another
+ *                           register, at the same time as commands.txt on
+ *                           the threads set by --workers. Can be repeated.
+ *                           Reports go to FILE.out, errors are prefixed
+ *                           with the name of their file.
+ *                  --snapshot FILE
+ *                           Start from FILE, saved by --save-snapshot or a
+ *                           "W, FILE" command, instead of parsing
+ *                           inventory.txt and customers.txt. Falls back to
+ *                           them if FILE cannot be read.
+ *                  --save-snapshot FILE
+ *                           Save the whole store, stock and histories
+ *                           included, to FILE once commands.txt is done.
+ *                  --journal FILE
+ *                           Append every buy, sell and registration to
+ *                           FILE. If FILE exists, its changes are applied
+ *                           first, recovering a run that crashed. Use a
+ *                           new journal when starting from a new snapshot.
+ *                  --journal-delay US
+ *                           Longest a change waits to be written to the
+ *                           journal with the changes after it, in
+ *                           microseconds. Default is 1000.
+ *                  --output FILE
+ *                           Write transaction reports to FILE instead of
+ *                           standard output.
+ *
+ * Preconditions:   Each of the input files must strictly follow their
+ *                  pre-established formats.
+ * Postconditions:  All recognized items and customers will be tracked as the
+ *                  as the various operations are performed on these objects.
+ */
+#include "CollectibleStore.h"
+using namespace std;
+
+int main(int argc, char* argv[]) {
+   CollectibleStore store1("inventory.txt", "customers.txt", "commands.txt");
+   string journalFile;
+   int journalDelay = 1000;
+
+   for (int i = 1; i < argc; i++) {
+      string option = argv[i];
+
+      if (option == "--stats") {
+         store1.setReportStats(true);
+      } else if (option == "--load-threads" && i + 1 < argc) {
+         store1.setLoadThreads(atoi(argv[++i]));
+      } else if (option == "--pipeline") {
+         store1.setPipelined(true);
+      } else if (option == "--workers" && i + 1 < argc) {
+         store1.setWorkers(atoi(argv[++i]));
+      } else if (option == "--stream" && i + 1 < argc) {
+         store1.addStream(argv[++i]);
+      } else if (option == "--snapshot" && i + 1 < argc) {
+         store1.setSnapshotFile(argv[++i]);
+      } else if (option == "--save-snapshot" && i + 1 < argc) {
+         store1.setSaveSnapshotFile(argv[++i]);
+      } else if (option == "--journal" && i + 1 < argc) {
+         journalFile = argv[++i];
+      } else if (option == "--journal-delay" && i + 1 < argc) {
+         journalDelay = atoi(argv[++i]);
+      } else if (option == "--output" && i + 1 < argc) {
+         store1.setOutputFile(argv[++i]);
+      } else {
+         cerr << "Unrecognized option " << option << ".\n" << endl;
+         return 1;
+      }
+   }
+   store1.setJournalFile(journalFile, journalDelay);
+   store1.beginProcessing();
+
+   return 0;
 }
\ No newline at end of file